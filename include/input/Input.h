@@ -876,6 +876,10 @@ public:
             nsecs_t eventTime,
             const PointerCoords* pointerCoords);
 
+    // Reserves storage for a total of sampleCount samples so that a known number of subsequent
+    // calls to addSample do not reallocate the sample arrays.
+    void reserveSamples(size_t sampleCount);
+
     void offsetLocation(float xOffset, float yOffset);
 
     void scale(float globalScaleFactor);
@@ -28,6 +28,7 @@
  * The InputConsumer is used by the application to receive events from the input dispatcher.
  */
 
+#include <deque>
 #include <string>
 #include <unordered_map>
 
@@ -265,6 +266,18 @@ public:
      */
     status_t sendMessage(const InputMessage* msg);
 
+    /* Send several messages to the other endpoint, using as few system calls as possible.
+     *
+     * Messages are sent in order, and each message is either sent in full or not at all.
+     * On return, outSentCount holds the number of messages from the front of msgs that were sent.
+     *
+     * Return OK if all of the messages were sent.
+     * Return WOULD_BLOCK if the channel became full before all of the messages were sent.
+     * Return DEAD_OBJECT if the channel's peer has been closed.
+     * Other errors probably indicate that the channel is broken.
+     */
+    status_t sendMessages(const InputMessage* msgs, size_t count, size_t* outSentCount);
+
     /* Receive a message sent by the other endpoint.
      *
      * If there is no message present, try again after poll() indicates that the fd
@@ -543,9 +556,10 @@ private:
     // call to consume and that still needs to be handled.
     bool mMsgDeferred;
 
-    // Batched motion events per device and source.
+    // Batched motion events per device and source. Samples are consumed from the front, so a
+    // deque is used to avoid shifting the remaining (large) messages on every consume.
     struct Batch {
-        std::vector<InputMessage> samples;
+        std::deque<InputMessage> samples;
     };
     std::vector<Batch> mBatches;
 
@@ -653,6 +667,10 @@ private:
     // will be raised for that connection, and no further events will be posted to that channel.
     std::unordered_map<uint32_t /*seq*/, nsecs_t /*consumeTime*/> mConsumeTimes;
 
+    // Scratch storage for the finished signals of a batch, which are sent to the channel together.
+    // Kept as a member so that its capacity is reused across calls to sendFinishedSignal.
+    std::vector<InputMessage> mFinishedMessages;
+
     status_t consumeBatch(InputEventFactoryInterface* factory,
             nsecs_t frameTime, uint32_t* outSeq, InputEvent** outEvent);
     status_t consumeSamples(InputEventFactoryInterface* factory,
@@ -668,6 +686,8 @@ private:
     nsecs_t getConsumeTime(uint32_t seq) const;
     void popConsumeTime(uint32_t seq);
     status_t sendUnchainedFinishedSignal(uint32_t seq, bool handled);
+    status_t sendUnchainedFinishedSignals(const uint32_t* seqs, size_t count, bool handled,
+                                          size_t* outSentCount);
 
     static void rewriteMessage(TouchState& state, InputMessage& msg);
     static void initializeKeyEvent(KeyEvent* event, const InputMessage* msg);
@@ -87,6 +87,16 @@ public:
 
     std::unique_ptr<MotionEvent> predict(nsecs_t timestamp);
 
+    /**
+     * Same as predict(nsecs_t), but writes the prediction into a caller-provided event instead of
+     * allocating a new one. Callers that predict every frame can keep reusing the same event,
+     * along with its sample storage.
+     *
+     * @return true if outPrediction was overwritten with a prediction, false if there is no
+     * prediction, in which case outPrediction is left untouched.
+     */
+    bool predict(nsecs_t timestamp, MotionEvent& outPrediction);
+
     bool isPredictionAvailable(int32_t deviceId, int32_t source);
 
 private:
@@ -170,6 +170,11 @@ protected:
         float position;
     };
 
+    // Notifies subclasses of every movement that enters or leaves the accumulated history of a
+    // pointer, so that they may maintain derived state incrementally.
+    virtual void onMovementAdded(int32_t /*pointerId*/, const Movement& /*movement*/) {}
+    virtual void onMovementRemoved(int32_t /*pointerId*/, const Movement& /*movement*/) {}
+
     // Number of samples to keep.
     // If different strategies would like to maintain different history size, we can make this a
     // protected const field.
@@ -212,25 +217,55 @@ public:
     LeastSquaresVelocityTrackerStrategy(uint32_t degree, Weighting weighting = Weighting::NONE);
     ~LeastSquaresVelocityTrackerStrategy() override;
 
+    void clearPointer(int32_t pointerId) override;
     std::optional<float> getVelocity(int32_t pointerId) const override;
 
+protected:
+    void onMovementAdded(int32_t pointerId, const Movement& movement) override;
+    void onMovementRemoved(int32_t pointerId, const Movement& movement) override;
+
 private:
     // Sample horizon.
     // We don't use too much history by default since we want to react to quick
     // changes in direction.
     static const nsecs_t HORIZON = 100 * 1000000; // 100 ms
 
+    // Maximum distance of the moment origin from the newest movement before the moments are
+    // recomputed around a new origin. Keeping the origin close to the data keeps the running sums
+    // well conditioned; since it is the same as the horizon, the recomputation is amortized over
+    // all movements within a horizon.
+    static const nsecs_t MOMENTS_REBASE_INTERVAL = HORIZON;
+
+    // Running sums of the powers of the movement times ("x", in seconds since `originTime`) and
+    // positions ("y", relative to `originPosition`) over the accumulated history of a pointer.
+    // Used for degree 2 and no weight (i.e. `Weighting.NONE`), so that the fit is updated in O(1)
+    // as movements enter and leave the horizon instead of being recomputed over the whole history
+    // for every velocity query.
+    struct Moments {
+        nsecs_t originTime;
+        float originPosition;
+        int32_t count;
+        double sx, sx2, sx3, sx4, sy, sxy, sx2y;
+
+        // Adds (sign = 1) or removes (sign = -1) a movement.
+        void update(const Movement& movement, int32_t sign);
+    };
+
+    bool usesMoments() const { return mDegree == 2 && mWeighting == Weighting::NONE; }
+    void rebaseMoments(Moments& moments, const RingBuffer<Movement>& movements);
+
     float chooseWeight(int32_t pointerId, uint32_t index) const;
     /**
-     * An optimized least-squares solver for degree 2 and no weight (i.e. `Weighting.NONE`).
-     * The provided container of movements shall NOT be empty, and shall have the movements in
-     * chronological order.
+     * An optimized least-squares solver for degree 2 and no weight (i.e. `Weighting.NONE`), based
+     * on the running moments of the pointer. `newestEventTime` is the time of the newest movement,
+     * at which the velocity is evaluated.
      */
-    std::optional<float> solveUnweightedLeastSquaresDeg2(
-            const RingBuffer<Movement>& movements) const;
+    std::optional<float> solveUnweightedLeastSquaresDeg2(const Moments& moments,
+                                                         nsecs_t newestEventTime) const;
 
     const uint32_t mDegree;
     const Weighting mWeighting;
+    std::map<int32_t /*pointerId*/, Moments> mMoments;
 };
 
 /*
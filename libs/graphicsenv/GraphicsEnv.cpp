@@ -685,4 +685,12 @@ void GraphicsEnv::setDebugLayersGLES(const std::string& layers) {
     mDebugLayersGLES = layers;
 }
 
+void GraphicsEnv::setLayerManifestPath(const std::string& path) {
+    mLayerManifestPath = path;
+}
+
+const std::string& GraphicsEnv::getLayerManifestPath() {
+    return mLayerManifestPath;
+}
+
 } // namespace android
@@ -140,6 +140,10 @@ public:
     const std::string& getDebugLayers();
     // Get the debug layers to load.
     const std::string& getDebugLayersGLES();
+    // Set the file used to cache the layers found in the layer search paths.
+    void setLayerManifestPath(const std::string& path);
+    // Get the file used to cache the layers found in the layer search paths.
+    const std::string& getLayerManifestPath();
 
 private:
     // Link updatable driver namespace with llndk and vndk-sp libs.
@@ -203,6 +207,8 @@ private:
     std::string mDebugLayersGLES;
     // Additional debug layers search path.
     std::string mLayerPaths;
+    // Cache of the layers found in the layer search paths.
+    std::string mLayerManifestPath;
     // This App's namespace to open native libraries.
     NativeLoaderNamespace* mAppNamespace = nullptr;
 };
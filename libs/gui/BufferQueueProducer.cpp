@@ -92,8 +92,25 @@ BufferQueueProducer::~BufferQueueProducer() {}
 
 status_t BufferQueueProducer::requestBuffer(int slot, sp<GraphicBuffer>* buf) {
     ATRACE_CALL();
-    BQ_LOGV("requestBuffer: slot %d", slot);
     std::lock_guard<std::mutex> lock(mCore->mMutex);
+    return requestBufferLocked(slot, buf);
+}
+
+status_t BufferQueueProducer::requestBuffers(const std::vector<int32_t>& slots,
+                                             std::vector<RequestBufferOutput>* outputs) {
+    ATRACE_CALL();
+    outputs->clear();
+    outputs->reserve(slots.size());
+    std::lock_guard<std::mutex> lock(mCore->mMutex);
+    for (int32_t slot : slots) {
+        RequestBufferOutput& output = outputs->emplace_back();
+        output.result = requestBufferLocked(static_cast<int>(slot), &output.buffer);
+    }
+    return NO_ERROR;
+}
+
+status_t BufferQueueProducer::requestBufferLocked(int slot, sp<GraphicBuffer>* buf) {
+    BQ_LOGV("requestBuffer: slot %d", slot);
 
     if (mCore->mIsAbandoned) {
         BQ_LOGE("requestBuffer: BufferQueue has been abandoned");
@@ -393,8 +410,18 @@ status_t BufferQueueProducer::dequeueBuffer(int* outSlot, sp<android::Fence>* ou
                                             uint64_t usage, uint64_t* outBufferAge,
                                             FrameEventHistoryDelta* outTimestamps) {
     ATRACE_CALL();
+    status_t returnFlags = NO_ERROR;
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    EGLSyncKHR eglFence = EGL_NO_SYNC_KHR;
+    bool attachedByConsumer = false;
+
+    sp<IConsumerListener> listener;
+    bool callOnFrameDequeued = false;
+    uint64_t bufferId = 0; // Only used if callOnFrameDequeued == true
     { // Autolock scope
-        std::lock_guard<std::mutex> lock(mCore->mMutex);
+        // The connection checks and the slot search share a single lock acquisition so that a
+        // dequeue only hands mMutex back and forth with the consumer once per frame.
+        std::unique_lock<std::mutex> lock(mCore->mMutex);
         mConsumerName = mCore->mConsumerName;
 
         if (mCore->mIsAbandoned) {
@@ -406,25 +433,14 @@ status_t BufferQueueProducer::dequeueBuffer(int* outSlot, sp<android::Fence>* ou
             BQ_LOGE("dequeueBuffer: BufferQueue has no connected producer");
             return NO_INIT;
         }
-    } // Autolock scope
 
-    BQ_LOGV("dequeueBuffer: w=%u h=%u format=%#x, usage=%#" PRIx64, width, height, format, usage);
-
-    if ((width && !height) || (!width && height)) {
-        BQ_LOGE("dequeueBuffer: invalid size: w=%u h=%u", width, height);
-        return BAD_VALUE;
-    }
-
-    status_t returnFlags = NO_ERROR;
-    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
-    EGLSyncKHR eglFence = EGL_NO_SYNC_KHR;
-    bool attachedByConsumer = false;
+        BQ_LOGV("dequeueBuffer: w=%u h=%u format=%#x, usage=%#" PRIx64, width, height, format,
+                usage);
 
-    sp<IConsumerListener> listener;
-    bool callOnFrameDequeued = false;
-    uint64_t bufferId = 0; // Only used if callOnFrameDequeued == true
-    { // Autolock scope
-        std::unique_lock<std::mutex> lock(mCore->mMutex);
+        if ((width && !height) || (!width && height)) {
+            BQ_LOGE("dequeueBuffer: invalid size: w=%u h=%u", width, height);
+            return BAD_VALUE;
+        }
 
         // If we don't have a free buffer, but we are currently allocating, we wait until allocation
         // is finished such that we don't allocate in parallel.
@@ -882,11 +898,25 @@ status_t BufferQueueProducer::queueBuffer(int slot,
             return BAD_VALUE;
     }
 
+    // Fill in the parts of the BufferItem that only depend on the input before taking the lock,
+    // so that copying the damage region and HDR metadata does not extend the critical section.
+    BufferItem item;
+    item.mCrop = crop;
+    item.mTransform = transform & ~static_cast<uint32_t>(NATIVE_WINDOW_TRANSFORM_INVERSE_DISPLAY);
+    item.mTransformToDisplayInverse = (transform & NATIVE_WINDOW_TRANSFORM_INVERSE_DISPLAY) != 0;
+    item.mScalingMode = static_cast<uint32_t>(scalingMode);
+    item.mTimestamp = requestedPresentTimestamp;
+    item.mIsAutoTimestamp = isAutoTimestamp;
+    item.mHdrMetadata = hdrMetadata;
+    item.mFence = acquireFence;
+    item.mFenceTime = acquireFenceTime;
+    item.mSurfaceDamage = surfaceDamage;
+    item.mQueuedBuffer = true;
+
     sp<IConsumerListener> frameAvailableListener;
     sp<IConsumerListener> frameReplacedListener;
     int callbackTicket = 0;
     uint64_t currentFrameNumber = 0;
-    BufferItem item;
     int connectedApi;
     sp<Fence> lastQueuedFence;
 
@@ -958,26 +988,13 @@ status_t BufferQueueProducer::queueBuffer(int slot,
 
         item.mAcquireCalled = mSlots[slot].mAcquireCalled;
         item.mGraphicBuffer = mSlots[slot].mGraphicBuffer;
-        item.mCrop = crop;
-        item.mTransform = transform &
-                ~static_cast<uint32_t>(NATIVE_WINDOW_TRANSFORM_INVERSE_DISPLAY);
-        item.mTransformToDisplayInverse =
-                (transform & NATIVE_WINDOW_TRANSFORM_INVERSE_DISPLAY) != 0;
-        item.mScalingMode = static_cast<uint32_t>(scalingMode);
-        item.mTimestamp = requestedPresentTimestamp;
-        item.mIsAutoTimestamp = isAutoTimestamp;
         item.mDataSpace = dataSpace;
-        item.mHdrMetadata = hdrMetadata;
         item.mFrameNumber = currentFrameNumber;
         item.mSlot = slot;
-        item.mFence = acquireFence;
-        item.mFenceTime = acquireFenceTime;
         item.mIsDroppable = mCore->mAsyncMode ||
                 (mConsumerIsSurfaceFlinger && mCore->mQueueBufferCanDrop) ||
                 (mCore->mLegacyBufferDrop && mCore->mQueueBufferCanDrop) ||
                 (mCore->mSharedBufferMode && mCore->mSharedBufferSlot == slot);
-        item.mSurfaceDamage = surfaceDamage;
-        item.mQueuedBuffer = true;
         item.mAutoRefresh = mCore->mSharedBufferMode && mCore->mAutoRefresh;
         item.mApi = mCore->mConnectedApi;
 
@@ -1118,72 +1135,113 @@ status_t BufferQueueProducer::queueBuffer(int slot,
 
 status_t BufferQueueProducer::cancelBuffer(int slot, const sp<Fence>& fence) {
     ATRACE_CALL();
-    BQ_LOGV("cancelBuffer: slot %d", slot);
 
     sp<IConsumerListener> listener;
     bool callOnFrameCancelled = false;
     uint64_t bufferId = 0; // Only used if callOnFrameCancelled == true
     {
         std::lock_guard<std::mutex> lock(mCore->mMutex);
-
-        if (mCore->mIsAbandoned) {
-            BQ_LOGE("cancelBuffer: BufferQueue has been abandoned");
-            return NO_INIT;
+        status_t status = cancelBufferLocked(slot, fence, &callOnFrameCancelled, &bufferId);
+        if (status != NO_ERROR) {
+            return status;
         }
+        listener = mCore->mConsumerListener;
+    }
 
-        if (mCore->mConnectedApi == BufferQueueCore::NO_CONNECTED_API) {
-            BQ_LOGE("cancelBuffer: BufferQueue has no connected producer");
-            return NO_INIT;
-        }
+    if (listener != nullptr && callOnFrameCancelled) {
+        listener->onFrameCancelled(bufferId);
+    }
 
-        if (mCore->mSharedBufferMode) {
-            BQ_LOGE("cancelBuffer: cannot cancel a buffer in shared buffer mode");
-            return BAD_VALUE;
+    return NO_ERROR;
+}
+
+status_t BufferQueueProducer::cancelBuffers(const std::vector<CancelBufferInput>& inputs,
+                                            std::vector<status_t>* results) {
+    ATRACE_CALL();
+    results->clear();
+    results->reserve(inputs.size());
+
+    sp<IConsumerListener> listener;
+    std::vector<uint64_t> cancelledBufferIds;
+    {
+        std::lock_guard<std::mutex> lock(mCore->mMutex);
+        for (const CancelBufferInput& input : inputs) {
+            bool callOnFrameCancelled = false;
+            uint64_t bufferId = 0;
+            results->emplace_back(
+                    cancelBufferLocked(input.slot, input.fence, &callOnFrameCancelled, &bufferId));
+            if (callOnFrameCancelled) {
+                cancelledBufferIds.push_back(bufferId);
+            }
         }
+        listener = mCore->mConsumerListener;
+    }
 
-        if (slot < 0 || slot >= BufferQueueDefs::NUM_BUFFER_SLOTS) {
-            BQ_LOGE("cancelBuffer: slot index %d out of range [0, %d)", slot,
-                    BufferQueueDefs::NUM_BUFFER_SLOTS);
-            return BAD_VALUE;
-        } else if (!mSlots[slot].mBufferState.isDequeued()) {
-            BQ_LOGE("cancelBuffer: slot %d is not owned by the producer "
-                    "(state = %s)",
-                    slot, mSlots[slot].mBufferState.string());
-            return BAD_VALUE;
-        } else if (fence == nullptr) {
-            BQ_LOGE("cancelBuffer: fence is NULL");
-            return BAD_VALUE;
+    if (listener != nullptr) {
+        for (uint64_t bufferId : cancelledBufferIds) {
+            listener->onFrameCancelled(bufferId);
         }
+    }
 
-        mSlots[slot].mBufferState.cancel();
+    return NO_ERROR;
+}
 
-        // After leaving shared buffer mode, the shared buffer will still be around.
-        // Mark it as no longer shared if this operation causes it to be free.
-        if (!mCore->mSharedBufferMode && mSlots[slot].mBufferState.isFree()) {
-            mSlots[slot].mBufferState.mShared = false;
-        }
+status_t BufferQueueProducer::cancelBufferLocked(int slot, const sp<Fence>& fence,
+                                                 bool* outCallOnFrameCancelled,
+                                                 uint64_t* outBufferId) {
+    BQ_LOGV("cancelBuffer: slot %d", slot);
 
-        // Don't put the shared buffer on the free list.
-        if (!mSlots[slot].mBufferState.isShared()) {
-            mCore->mActiveBuffers.erase(slot);
-            mCore->mFreeBuffers.push_back(slot);
-        }
+    if (mCore->mIsAbandoned) {
+        BQ_LOGE("cancelBuffer: BufferQueue has been abandoned");
+        return NO_INIT;
+    }
 
-        auto gb = mSlots[slot].mGraphicBuffer;
-        if (gb != nullptr) {
-            callOnFrameCancelled = true;
-            bufferId = gb->getId();
-        }
-        mSlots[slot].mFence = fence;
-        mCore->mDequeueCondition.notify_all();
-        listener = mCore->mConsumerListener;
-        VALIDATE_CONSISTENCY();
+    if (mCore->mConnectedApi == BufferQueueCore::NO_CONNECTED_API) {
+        BQ_LOGE("cancelBuffer: BufferQueue has no connected producer");
+        return NO_INIT;
     }
 
-    if (listener != nullptr && callOnFrameCancelled) {
-        listener->onFrameCancelled(bufferId);
+    if (mCore->mSharedBufferMode) {
+        BQ_LOGE("cancelBuffer: cannot cancel a buffer in shared buffer mode");
+        return BAD_VALUE;
+    }
+
+    if (slot < 0 || slot >= BufferQueueDefs::NUM_BUFFER_SLOTS) {
+        BQ_LOGE("cancelBuffer: slot index %d out of range [0, %d)", slot,
+                BufferQueueDefs::NUM_BUFFER_SLOTS);
+        return BAD_VALUE;
+    } else if (!mSlots[slot].mBufferState.isDequeued()) {
+        BQ_LOGE("cancelBuffer: slot %d is not owned by the producer "
+                "(state = %s)",
+                slot, mSlots[slot].mBufferState.string());
+        return BAD_VALUE;
+    } else if (fence == nullptr) {
+        BQ_LOGE("cancelBuffer: fence is NULL");
+        return BAD_VALUE;
     }
 
+    mSlots[slot].mBufferState.cancel();
+
+    // After leaving shared buffer mode, the shared buffer will still be around.
+    // Mark it as no longer shared if this operation causes it to be free.
+    if (!mCore->mSharedBufferMode && mSlots[slot].mBufferState.isFree()) {
+        mSlots[slot].mBufferState.mShared = false;
+    }
+
+    // Don't put the shared buffer on the free list.
+    if (!mSlots[slot].mBufferState.isShared()) {
+        mCore->mActiveBuffers.erase(slot);
+        mCore->mFreeBuffers.push_back(slot);
+    }
+
+    auto gb = mSlots[slot].mGraphicBuffer;
+    if (gb != nullptr) {
+        *outCallOnFrameCancelled = true;
+        *outBufferId = gb->getId();
+    }
+    mSlots[slot].mFence = fence;
+    mCore->mDequeueCondition.notify_all();
+    VALIDATE_CONSISTENCY();
     return NO_ERROR;
 }
 
@@ -212,6 +212,10 @@ status_t SurfaceStats::readFromParcel(const Parcel* input) {
 }
 
 status_t TransactionStats::writeToParcel(Parcel* output) const {
+    return writeToParcel(output, true /* includePresentFence */);
+}
+
+status_t TransactionStats::writeToParcel(Parcel* output, bool includePresentFence) const {
     status_t err = output->writeParcelableVector(callbackIds);
     if (err != NO_ERROR) {
         return err;
@@ -220,7 +224,7 @@ status_t TransactionStats::writeToParcel(Parcel* output) const {
     if (err != NO_ERROR) {
         return err;
     }
-    if (presentFence) {
+    if (presentFence && includePresentFence) {
         err = output->writeBool(true);
         if (err != NO_ERROR) {
             return err;
@@ -264,11 +268,21 @@ status_t ListenerStats::writeToParcel(Parcel* output) const {
     if (err != NO_ERROR) {
         return err;
     }
+    // Transactions completed in the same frame share its present fence, so the fence is only sent
+    // with the first of them.
+    sp<Fence> previousPresentFence;
     for (const auto& stats : transactionStats) {
-        err = output->writeParcelable(stats);
+        const bool sharesPresentFence =
+                stats.presentFence != nullptr && stats.presentFence == previousPresentFence;
+        err = output->writeBool(sharesPresentFence);
+        if (err != NO_ERROR) {
+            return err;
+        }
+        err = stats.writeToParcel(output, !sharesPresentFence);
         if (err != NO_ERROR) {
             return err;
         }
+        previousPresentFence = stats.presentFence;
     }
     return NO_ERROR;
 }
@@ -276,13 +290,23 @@ status_t ListenerStats::writeToParcel(Parcel* output) const {
 status_t ListenerStats::readFromParcel(const Parcel* input) {
     int32_t transactionStats_size = input->readInt32();
 
+    sp<Fence> previousPresentFence;
     for (int i = 0; i < transactionStats_size; i++) {
+        bool sharesPresentFence = false;
+        status_t err = input->readBool(&sharesPresentFence);
+        if (err != NO_ERROR) {
+            return err;
+        }
         TransactionStats stats;
-        status_t err = input->readParcelable(&stats);
+        err = stats.readFromParcel(input);
         if (err != NO_ERROR) {
             return err;
         }
-        transactionStats.push_back(stats);
+        if (sharesPresentFence) {
+            stats.presentFence = previousPresentFence;
+        }
+        previousPresentFence = stats.presentFence;
+        transactionStats.push_back(std::move(stats));
     }
     return NO_ERROR;
 }
@@ -55,6 +55,7 @@
 #include <ui/DynamicDisplayInfo.h>
 
 #include <android-base/thread_annotations.h>
+#include <android-base/unique_fd.h>
 #include <gui/LayerStatePermissions.h>
 #include <gui/ScreenCaptureResults.h>
 #include <private/gui/ComposerService.h>
@@ -778,11 +779,11 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
     if (count > parcel->dataSize()) {
         return BAD_VALUE;
     }
-    std::unordered_map<sp<ITransactionCompletedListener>, CallbackInfo, TCLHash> listenerCallbacks;
-    listenerCallbacks.reserve(count);
+    ListenerCallbackMap listenerCallbacks;
     for (size_t i = 0; i < count; i++) {
         sp<ITransactionCompletedListener> listener =
                 interface_cast<ITransactionCompletedListener>(parcel->readStrongBinder());
+        auto& callbackInfo = listenerCallbacks.try_emplace(listener).first->second;
         size_t numCallbackIds = parcel->readUint32();
         if (numCallbackIds > parcel->dataSize()) {
             return BAD_VALUE;
@@ -790,7 +791,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
         for (size_t j = 0; j < numCallbackIds; j++) {
             CallbackId id;
             parcel->readParcelable(&id);
-            listenerCallbacks[listener].callbackIds.insert(id);
+            callbackInfo.callbackIds.insert(id);
         }
         size_t numSurfaces = parcel->readUint32();
         if (numSurfaces > parcel->dataSize()) {
@@ -799,7 +800,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
         for (size_t j = 0; j < numSurfaces; j++) {
             sp<SurfaceControl> surface;
             SAFE_PARCEL(SurfaceControl::readFromParcel, *parcel, &surface);
-            listenerCallbacks[listener].surfaceControls.insert(surface);
+            callbackInfo.surfaceControls.insert(surface);
         }
     }
 
@@ -807,8 +808,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
     if (count > parcel->dataSize()) {
         return BAD_VALUE;
     }
-    std::unordered_map<sp<IBinder>, ComposerState, IBinderHash> composerStates;
-    composerStates.reserve(count);
+    ComposerStateMap composerStates;
     for (size_t i = 0; i < count; i++) {
         sp<IBinder> surfaceControlHandle;
         SAFE_PARCEL(parcel->readStrongBinder, &surfaceControlHandle);
@@ -817,7 +817,7 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
         if (composerState.read(*parcel) == BAD_VALUE) {
             return BAD_VALUE;
         }
-        composerStates[surfaceControlHandle] = composerState;
+        composerStates.emplace_or_replace(surfaceControlHandle, std::move(composerState));
     }
 
     InputWindowCommands inputWindowCommands;
@@ -854,8 +854,8 @@ status_t SurfaceComposerClient::Transaction::readFromParcel(const Parcel* parcel
     mIsAutoTimestamp = isAutoTimestamp;
     mFrameTimelineInfo = frameTimelineInfo;
     mDisplayStates = displayStates;
-    mListenerCallbacks = listenerCallbacks;
-    mComposerStates = composerStates;
+    mListenerCallbacks = std::move(listenerCallbacks);
+    mComposerStates = std::move(composerStates);
     mInputWindowCommands = inputWindowCommands;
     mApplyToken = applyToken;
     mUncacheBuffers = std::move(uncacheBuffers);
@@ -963,14 +963,14 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::merge(Tr
     }
     mMergedTransactionIds.insert(mMergedTransactionIds.begin(), other.mId);
 
-    for (auto const& [handle, composerState] : other.mComposerStates) {
-        if (mComposerStates.count(handle) == 0) {
-            mComposerStates[handle] = composerState;
-        } else {
+    for (auto& [handle, composerState] : other.mComposerStates) {
+        // The state is only moved from when it is inserted; other is cleared below either way.
+        const auto [it, inserted] = mComposerStates.try_emplace(handle, std::move(composerState));
+        if (!inserted) {
             if (composerState.state.what & layer_state_t::eBufferChanged) {
-                releaseBufferIfOverwriting(mComposerStates[handle].state);
+                releaseBufferIfOverwriting(it->second.state);
             }
-            mComposerStates[handle].state.merge(composerState.state);
+            it->second.state.merge(composerState.state);
         }
     }
 
@@ -985,15 +985,15 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::merge(Tr
 
     for (const auto& [listener, callbackInfo] : other.mListenerCallbacks) {
         auto& [callbackIds, surfaceControls] = callbackInfo;
-        mListenerCallbacks[listener].callbackIds.insert(std::make_move_iterator(
-                                                                callbackIds.begin()),
-                                                        std::make_move_iterator(callbackIds.end()));
-
-        mListenerCallbacks[listener].surfaceControls.insert(surfaceControls.begin(),
-                                                            surfaceControls.end());
+        auto& mergedCallbackInfo = mListenerCallbacks.try_emplace(listener).first->second;
+        mergedCallbackInfo.callbackIds.insert(std::make_move_iterator(callbackIds.begin()),
+                                              std::make_move_iterator(callbackIds.end()));
+        mergedCallbackInfo.surfaceControls.insert(surfaceControls.begin(), surfaceControls.end());
 
+        // Looked up after mergedCallbackInfo is done with, since inserting may relocate entries.
         auto& currentProcessCallbackInfo =
-                mListenerCallbacks[TransactionCompletedListener::getIInstance()];
+                mListenerCallbacks.try_emplace(TransactionCompletedListener::getIInstance())
+                        .first->second;
         currentProcessCallbackInfo.surfaceControls
                 .insert(std::make_move_iterator(surfaceControls.begin()),
                         std::make_move_iterator(surfaceControls.end()));
@@ -1073,7 +1073,7 @@ void SurfaceComposerClient::Transaction::cacheBuffers() {
 
     size_t count = 0;
     for (auto& [handle, cs] : mComposerStates) {
-        layer_state_t* s = &(mComposerStates[handle].state);
+        layer_state_t* s = &cs.state;
         if (!(s->what & layer_state_t::eBufferChanged)) {
             continue;
         } else if (s->bufferData &&
@@ -1337,22 +1337,21 @@ void SurfaceComposerClient::Transaction::setEarlyWakeupEnd() {
 layer_state_t* SurfaceComposerClient::Transaction::getLayerState(const sp<SurfaceControl>& sc) {
     auto handle = sc->getLayerStateHandle();
 
-    if (mComposerStates.count(handle) == 0) {
+    const auto [it, inserted] = mComposerStates.try_emplace(handle);
+    if (inserted) {
         // we don't have it, add an initialized layer_state to our list
-        ComposerState s;
-
-        s.state.surface = handle;
-        s.state.layerId = sc->getLayerId();
-
-        mComposerStates[handle] = s;
+        it->second.state.surface = handle;
+        it->second.state.layerId = sc->getLayerId();
     }
 
-    return &(mComposerStates[handle].state);
+    return &it->second.state;
 }
 
 void SurfaceComposerClient::Transaction::registerSurfaceControlForCallback(
         const sp<SurfaceControl>& sc) {
-    auto& callbackInfo = mListenerCallbacks[TransactionCompletedListener::getIInstance()];
+    auto& callbackInfo =
+            mListenerCallbacks.try_emplace(TransactionCompletedListener::getIInstance())
+                    .first->second;
     callbackInfo.surfaceControls.insert(sc);
 
     TransactionCompletedListener::getInstance()->addSurfaceControlToCallbacks(callbackInfo, sc);
@@ -1937,14 +1936,15 @@ SurfaceComposerClient::Transaction& SurfaceComposerClient::Transaction::addTrans
 
     auto callbackWithContext = std::bind(callback, callbackContext, std::placeholders::_1,
                                          std::placeholders::_2, std::placeholders::_3);
-    const auto& surfaceControls =
-            mListenerCallbacks[TransactionCompletedListener::getIInstance()].surfaceControls;
+    auto& callbackInfo =
+            mListenerCallbacks.try_emplace(TransactionCompletedListener::getIInstance())
+                    .first->second;
 
-    CallbackId callbackId =
-            listener->addCallbackFunction(callbackWithContext, surfaceControls, callbackType);
+    CallbackId callbackId = listener->addCallbackFunction(callbackWithContext,
+                                                          callbackInfo.surfaceControls,
+                                                          callbackType);
 
-    mListenerCallbacks[TransactionCompletedListener::getIInstance()].callbackIds.emplace(
-            callbackId);
+    callbackInfo.callbackIds.emplace(callbackId);
     return *this;
 }
 
@@ -3170,6 +3170,24 @@ status_t ScreenshotClient::captureLayers(const LayerCaptureArgs& captureArgs,
     return statusTFromBinderStatus(status);
 }
 
+status_t ScreenshotClient::releaseCaptureBuffer(const sp<GraphicBuffer>& buffer,
+                                                const sp<Fence>& releaseFence) {
+    if (buffer == nullptr) return BAD_VALUE;
+    sp<gui::ISurfaceComposer> s(ComposerServiceAIDL::getComposerService());
+    if (s == nullptr) return NO_INIT;
+
+    std::optional<os::ParcelFileDescriptor> releaseFenceFd;
+    if (releaseFence != nullptr && releaseFence->isValid()) {
+        base::unique_fd fd(releaseFence->dup());
+        if (!fd.ok()) return -errno;
+        releaseFenceFd.emplace(std::move(fd));
+    }
+
+    binder::Status status =
+            s->releaseScreenCaptureBuffer(static_cast<int64_t>(buffer->getId()), releaseFenceFd);
+    return statusTFromBinderStatus(status);
+}
+
 // ---------------------------------------------------------------------------------
 
 void ReleaseCallbackThread::addReleaseCallback(const ReleaseCallbackId callbackId,
@@ -46,6 +46,11 @@ public:
     // flags indicating that previously-returned buffers are no longer valid.
     virtual status_t requestBuffer(int slot, sp<GraphicBuffer>* buf);
 
+    // See IGraphicBufferProducer::requestBuffers. Unlike the default implementation, all slots
+    // are handled under a single acquisition of mCore->mMutex.
+    status_t requestBuffers(const std::vector<int32_t>& slots,
+                            std::vector<RequestBufferOutput>* outputs) override;
+
     // see IGraphicsBufferProducer::setMaxDequeuedBufferCount
     virtual status_t setMaxDequeuedBufferCount(int maxDequeuedBuffers);
 
@@ -127,6 +132,11 @@ public:
     // will usually be the one obtained from dequeueBuffer.
     virtual status_t cancelBuffer(int slot, const sp<Fence>& fence);
 
+    // See IGraphicBufferProducer::cancelBuffers. All buffers are returned under a single
+    // acquisition of mCore->mMutex, and onFrameCancelled is called for each of them afterwards.
+    status_t cancelBuffers(const std::vector<CancelBufferInput>& inputs,
+                           std::vector<status_t>* results) override;
+
     // Query native window attributes.  The "what" values are enumerated in
     // window.h (e.g. NATIVE_WINDOW_FORMAT).
     virtual int query(int what, int* outValue);
@@ -225,6 +235,13 @@ private:
     // BufferQueueCore::INVALID_BUFFER_SLOT otherwise
     int getFreeSlotLocked() const;
 
+    // Implementations of requestBuffer and cancelBuffer that are shared with their batched
+    // counterparts. mCore->mMutex must be held. cancelBufferLocked reports the id of the
+    // cancelled buffer so that the caller can notify the consumer once the lock is released.
+    status_t requestBufferLocked(int slot, sp<GraphicBuffer>* buf);
+    status_t cancelBufferLocked(int slot, const sp<Fence>& fence, bool* outCallOnFrameCancelled,
+                                uint64_t* outBufferId);
+
     void addAndGetFrameTimestamps(const NewFrameEventsEntry* newTimestamps,
             FrameEventHistoryDelta* outDelta);
 
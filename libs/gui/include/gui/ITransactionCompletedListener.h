@@ -182,6 +182,10 @@ public:
     nsecs_t latchTime = -1;
     sp<Fence> presentFence = nullptr;
     std::vector<SurfaceStats> surfaceStats;
+
+private:
+    friend class ListenerStats;
+    status_t writeToParcel(Parcel* output, bool includePresentFence) const;
 };
 
 class ListenerStats : public Parcelable {
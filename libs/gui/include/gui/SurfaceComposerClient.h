@@ -25,6 +25,8 @@
 
 #include <binder/IBinder.h>
 
+#include <ftl/small_map.h>
+
 #include <utils/Errors.h>
 #include <utils/RefBase.h>
 #include <utils/Singleton.h>
@@ -433,10 +435,17 @@ public:
         static void mergeFrameTimelineInfo(FrameTimelineInfo& t, const FrameTimelineInfo& other);
 
     protected:
-        std::unordered_map<sp<IBinder>, ComposerState, IBinderHash> mComposerStates;
+        // Most transactions touch a handful of layers and a single listener, so both are kept in
+        // flat maps with inline storage. Lookups are linear, which beats hashing at these sizes.
+        static const size_t STATIC_COMPOSER_STATES = 4u;
+        static const size_t STATIC_LISTENER_CALLBACKS = 2u;
+        using ComposerStateMap = ftl::SmallMap<sp<IBinder>, ComposerState, STATIC_COMPOSER_STATES>;
+        using ListenerCallbackMap = ftl::SmallMap<sp<ITransactionCompletedListener>, CallbackInfo,
+                                                  STATIC_LISTENER_CALLBACKS>;
+
+        ComposerStateMap mComposerStates;
         SortedVector<DisplayState> mDisplayStates;
-        std::unordered_map<sp<ITransactionCompletedListener>, CallbackInfo, TCLHash>
-                mListenerCallbacks;
+        ListenerCallbackMap mListenerCallbacks;
         std::vector<client_cache_t> mUncacheBuffers;
 
         // We keep track of the last MAX_MERGE_HISTORY_LENGTH merged transaction ids.
@@ -852,6 +861,12 @@ public:
                                    const sp<IScreenCaptureListener>&);
     static status_t captureLayers(const LayerCaptureArgs&, const sp<IScreenCaptureListener>&,
                                   bool sync);
+    // Hands the buffer of a completed capture back to SurfaceFlinger so that later captures of
+    // the same size and format can reuse it. releaseFence must signal once all pending reads of
+    // the buffer, for example by the GPU, are complete. The buffer must not be used after this
+    // call.
+    static status_t releaseCaptureBuffer(const sp<GraphicBuffer>& buffer,
+                                         const sp<Fence>& releaseFence = Fence::NO_FENCE);
 
     [[deprecated]] static status_t captureDisplay(DisplayId id,
                                                   const sp<IScreenCaptureListener>& listener) {
@@ -1335,6 +1335,58 @@ TEST_F(BufferQueueTest, TestProducerConnectDisconnect) {
     ASSERT_EQ(NO_INIT, mProducer->disconnect(NATIVE_WINDOW_API_CPU));
 }
 
+TEST_F(BufferQueueTest, TestBatchedRequestAndCancel) {
+    createBufferQueue();
+    sp<MockConsumer> mc(new MockConsumer);
+    ASSERT_EQ(OK, mConsumer->consumerConnect(mc, false));
+    IGraphicBufferProducer::QueueBufferOutput output;
+    ASSERT_EQ(OK,
+              mProducer->connect(new StubProducerListener, NATIVE_WINDOW_API_CPU, false, &output));
+    ASSERT_EQ(OK, mProducer->setMaxDequeuedBufferCount(2));
+
+    std::vector<int32_t> slots;
+    for (int i = 0; i < 2; i++) {
+        int slot;
+        sp<Fence> fence;
+        ASSERT_EQ(IGraphicBufferProducer::BUFFER_NEEDS_REALLOCATION,
+                  mProducer->dequeueBuffer(&slot, &fence, 0, 0, 0, GRALLOC_USAGE_SW_WRITE_OFTEN,
+                                           nullptr, nullptr));
+        slots.push_back(slot);
+    }
+    // A slot that is not dequeued fails on its own without affecting the others.
+    slots.push_back(BufferQueueDefs::NUM_BUFFER_SLOTS);
+
+    std::vector<IGraphicBufferProducer::RequestBufferOutput> requestOutputs;
+    ASSERT_EQ(OK, mProducer->requestBuffers(slots, &requestOutputs));
+    ASSERT_EQ(slots.size(), requestOutputs.size());
+    EXPECT_EQ(OK, requestOutputs[0].result);
+    EXPECT_NE(nullptr, requestOutputs[0].buffer);
+    EXPECT_EQ(OK, requestOutputs[1].result);
+    EXPECT_NE(nullptr, requestOutputs[1].buffer);
+    EXPECT_EQ(BAD_VALUE, requestOutputs[2].result);
+
+    std::vector<IGraphicBufferProducer::CancelBufferInput> cancelInputs(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        cancelInputs[i].slot = slots[i];
+        cancelInputs[i].fence = Fence::NO_FENCE;
+    }
+    std::vector<status_t> cancelResults;
+    ASSERT_EQ(OK, mProducer->cancelBuffers(cancelInputs, &cancelResults));
+    ASSERT_EQ(slots.size(), cancelResults.size());
+    EXPECT_EQ(OK, cancelResults[0]);
+    EXPECT_EQ(OK, cancelResults[1]);
+    EXPECT_EQ(BAD_VALUE, cancelResults[2]);
+
+    // Both buffers were returned, so they can be dequeued again without reallocation.
+    for (int i = 0; i < 2; i++) {
+        int slot;
+        sp<Fence> fence;
+        ASSERT_EQ(OK,
+                  mProducer->dequeueBuffer(&slot, &fence, 0, 0, 0, GRALLOC_USAGE_SW_WRITE_OFTEN,
+                                           nullptr, nullptr));
+    }
+}
+
 TEST_F(BufferQueueTest, TestBqSetFrameRateFlagBuildTimeIsSet) {
     ASSERT_EQ(flags::bq_setframerate(), COM_ANDROID_GRAPHICS_LIBGUI_FLAGS(BQ_SETFRAMERATE));
 }
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <android-base/unique_fd.h>
+#include <binder/Parcel.h>
+#include <unistd.h>
+
+#include <gui/ITransactionCompletedListener.h>
+
+namespace android {
+
+namespace test {
+
+TEST(ListenerStats, ParcellingSendsSharedPresentFenceOnce) {
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    base::unique_fd readEnd(fds[0]);
+    base::unique_fd writeEnd(fds[1]);
+
+    const auto presentFence = sp<Fence>::make(dup(readEnd.get()));
+    const auto otherPresentFence = sp<Fence>::make(dup(writeEnd.get()));
+
+    auto makeTransactionStats = [](int64_t id, CallbackId::Type type, nsecs_t latchTime,
+                                   const sp<Fence>& fence) {
+        return TransactionStats({CallbackId(id, type)}, latchTime, fence, {});
+    };
+
+    ListenerStats stats;
+    stats.transactionStats.push_back(
+            makeTransactionStats(1, CallbackId::Type::ON_COMPLETE, 10, presentFence));
+    stats.transactionStats.push_back(
+            makeTransactionStats(2, CallbackId::Type::ON_COMPLETE, 10, presentFence));
+    stats.transactionStats.push_back(
+            makeTransactionStats(3, CallbackId::Type::ON_COMMIT, -1, nullptr));
+    stats.transactionStats.push_back(
+            makeTransactionStats(4, CallbackId::Type::ON_COMPLETE, 20, otherPresentFence));
+
+    Parcel p;
+    ASSERT_EQ(NO_ERROR, stats.writeToParcel(&p));
+    EXPECT_EQ(2u, p.objectsCount());
+    p.setDataPosition(0);
+
+    ListenerStats stats2;
+    ASSERT_EQ(NO_ERROR, stats2.readFromParcel(&p));
+    ASSERT_EQ(4u, stats2.transactionStats.size());
+    for (size_t i = 0; i < stats.transactionStats.size(); i++) {
+        EXPECT_EQ(stats.transactionStats[i].callbackIds, stats2.transactionStats[i].callbackIds);
+        EXPECT_EQ(stats.transactionStats[i].latchTime, stats2.transactionStats[i].latchTime);
+    }
+    ASSERT_NE(nullptr, stats2.transactionStats[0].presentFence);
+    EXPECT_EQ(stats2.transactionStats[0].presentFence, stats2.transactionStats[1].presentFence);
+    EXPECT_EQ(nullptr, stats2.transactionStats[2].presentFence);
+    ASSERT_NE(nullptr, stats2.transactionStats[3].presentFence);
+    EXPECT_NE(stats2.transactionStats[0].presentFence, stats2.transactionStats[3].presentFence);
+}
+
+} // namespace test
+} // namespace android
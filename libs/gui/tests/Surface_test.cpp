@@ -800,6 +800,12 @@ public:
         return binder::Status::ok();
     }
 
+    binder::Status releaseScreenCaptureBuffer(
+            int64_t /*bufferId*/,
+            const std::optional<os::ParcelFileDescriptor>& /*releaseFence*/) override {
+        return binder::Status::ok();
+    }
+
     binder::Status clearAnimationFrameStats() override { return binder::Status::ok(); }
 
     binder::Status getAnimationFrameStats(gui::FrameStats* /*outStats*/) override {
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <binder/Binder.h>
+#include <binder/Parcel.h>
+#include <binder/ProcessState.h>
+#include <gui/SurfaceComposerClient.h>
+#include <gui/SurfaceControl.h>
+
+namespace android {
+
+namespace {
+
+using Transaction = SurfaceComposerClient::Transaction;
+
+// Layer counts for the typical transaction shapes: a single app surface, an app with a few child
+// surfaces and a system_server animation touching several leashes.
+void layerCounts(benchmark::internal::Benchmark* b) {
+    b->Arg(1)->Arg(4)->Arg(8)->Arg(16);
+}
+
+// Surface controls that are never sent to SurfaceFlinger, for benchmarks that stay in-process.
+std::vector<sp<SurfaceControl>> makeLocalSurfaceControls(size_t count) {
+    std::vector<sp<SurfaceControl>> surfaceControls;
+    for (size_t i = 0; i < count; i++) {
+        surfaceControls.push_back(sp<SurfaceControl>::make(/*client=*/nullptr,
+                                                           sp<BBinder>::make(),
+                                                           static_cast<int32_t>(i),
+                                                           "TransactionBenchmark"));
+    }
+    return surfaceControls;
+}
+
+void fillTransaction(Transaction& t, const std::vector<sp<SurfaceControl>>& surfaceControls,
+                     float offset) {
+    for (const auto& sc : surfaceControls) {
+        t.setPosition(sc, offset, offset).setAlpha(sc, 0.5f).setCornerRadius(sc, 8.f);
+    }
+}
+
+void BM_Transaction_build(benchmark::State& state) {
+    const auto surfaceControls = makeLocalSurfaceControls(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Transaction t;
+        fillTransaction(t, surfaceControls, 1.f);
+        benchmark::DoNotOptimize(t);
+    }
+}
+
+void BM_Transaction_merge(benchmark::State& state) {
+    const auto surfaceControls = makeLocalSurfaceControls(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Transaction t;
+        Transaction other;
+        fillTransaction(t, surfaceControls, 1.f);
+        fillTransaction(other, surfaceControls, 2.f);
+        t.merge(std::move(other));
+        benchmark::DoNotOptimize(t);
+    }
+}
+
+void BM_Transaction_parcel(benchmark::State& state) {
+    const auto surfaceControls = makeLocalSurfaceControls(static_cast<size_t>(state.range(0)));
+    Transaction t;
+    fillTransaction(t, surfaceControls, 1.f);
+    for (auto _ : state) {
+        Parcel parcel;
+        t.writeToParcel(&parcel);
+        parcel.setDataPosition(0);
+        Transaction received;
+        received.readFromParcel(&parcel);
+        benchmark::DoNotOptimize(received);
+    }
+}
+
+// Builds and applies a transaction on real layers, including the binder call to SurfaceFlinger.
+void BM_Transaction_apply(benchmark::State& state) {
+    ProcessState::self()->startThreadPool();
+    sp<SurfaceComposerClient> client = sp<SurfaceComposerClient>::make();
+    if (client->initCheck() != NO_ERROR) {
+        state.SkipWithError("Unable to connect to SurfaceFlinger");
+        return;
+    }
+
+    std::vector<sp<SurfaceControl>> surfaceControls;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        surfaceControls.push_back(client->createSurface(String8("TransactionBenchmark"), 0, 0,
+                                                        PIXEL_FORMAT_RGBA_8888,
+                                                        ISurfaceComposerClient::eFXSurfaceEffect));
+    }
+
+    float offset = 0.f;
+    for (auto _ : state) {
+        Transaction t;
+        fillTransaction(t, surfaceControls, offset);
+        t.apply();
+        offset = offset > 100.f ? 0.f : offset + 1.f;
+    }
+
+    Transaction t;
+    for (const auto& sc : surfaceControls) {
+        t.reparent(sc, nullptr);
+    }
+    t.apply(/*synchronous=*/true);
+}
+
+} // namespace
+
+BENCHMARK(BM_Transaction_build)->Apply(layerCounts);
+BENCHMARK(BM_Transaction_merge)->Apply(layerCounts);
+BENCHMARK(BM_Transaction_parcel)->Apply(layerCounts);
+BENCHMARK(BM_Transaction_apply)->Apply(layerCounts);
+
+} // namespace android
+
+BENCHMARK_MAIN();
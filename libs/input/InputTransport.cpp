@@ -123,6 +123,9 @@ namespace android {
 // behind processing touches.
 static const size_t SOCKET_BUFFER_SIZE = 32 * 1024;
 
+// Maximum number of messages written to the socket by a single sendmmsg call.
+static constexpr size_t MAX_BATCHED_MESSAGES = 8;
+
 // Nanoseconds per milliseconds.
 static const nsecs_t NANOS_PER_MS = 1000000;
 
@@ -499,6 +502,68 @@ status_t InputChannel::sendMessage(const InputMessage* msg) {
     return OK;
 }
 
+status_t InputChannel::sendMessages(const InputMessage* msgs, size_t count,
+                                    size_t* outSentCount) {
+    ATRACE_NAME_IF(ATRACE_ENABLED(),
+                   StringPrintf("sendMessages(inputChannel=%s, count=%zu, firstSeq=0x%" PRIx32
+                                ", type=0x%" PRIx32 ")",
+                                name.c_str(), count, count > 0 ? msgs[0].header.seq : 0,
+                                count > 0 ? static_cast<uint32_t>(msgs[0].header.type) : 0));
+    *outSentCount = 0;
+    while (*outSentCount < count) {
+        const size_t batchSize = std::min(count - *outSentCount, MAX_BATCHED_MESSAGES);
+        InputMessage cleanMsgs[MAX_BATCHED_MESSAGES];
+        struct iovec iovs[MAX_BATCHED_MESSAGES];
+        struct mmsghdr headers[MAX_BATCHED_MESSAGES] = {};
+        for (size_t i = 0; i < batchSize; i++) {
+            const InputMessage& msg = msgs[*outSentCount + i];
+            msg.getSanitizedCopy(&cleanMsgs[i]);
+            iovs[i].iov_base = &cleanMsgs[i];
+            iovs[i].iov_len = msg.size();
+            headers[i].msg_hdr.msg_iov = &iovs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int nSent;
+        do {
+            nSent = ::sendmmsg(getFd(), headers, batchSize, MSG_DONTWAIT | MSG_NOSIGNAL);
+        } while (nSent == -1 && errno == EINTR);
+
+        if (nSent < 0) {
+            int error = errno;
+            ALOGD_IF(DEBUG_CHANNEL_MESSAGES, "channel '%s' ~ error sending %zu messages, %s",
+                     name.c_str(), batchSize, strerror(error));
+            if (error == EAGAIN || error == EWOULDBLOCK) {
+                return WOULD_BLOCK;
+            }
+            if (error == EPIPE || error == ENOTCONN || error == ECONNREFUSED ||
+                error == ECONNRESET) {
+                return DEAD_OBJECT;
+            }
+            return -error;
+        }
+
+        for (int i = 0; i < nSent; i++) {
+            if (headers[i].msg_len != iovs[i].iov_len) {
+                ALOGD_IF(DEBUG_CHANNEL_MESSAGES,
+                         "channel '%s' ~ error sending message type %s, send was incomplete",
+                         name.c_str(), ftl::enum_string(cleanMsgs[i].header.type).c_str());
+                return DEAD_OBJECT;
+            }
+            (*outSentCount)++;
+        }
+
+        ALOGD_IF(DEBUG_CHANNEL_MESSAGES, "channel '%s' ~ sent %d messages", name.c_str(), nSent);
+
+        if (static_cast<size_t>(nSent) < batchSize) {
+            // The kernel stops at the first message that cannot be sent, which is almost always
+            // because the socket buffer is full. Any other error will be reported on the next send.
+            return WOULD_BLOCK;
+        }
+    }
+    return OK;
+}
+
 status_t InputChannel::receiveMessage(InputMessage* msg) {
     ssize_t nRead;
     do {
@@ -952,9 +1017,8 @@ status_t InputConsumer::consume(InputEventFactoryInterface* factory, bool consum
                 // Start a new batch if needed.
                 if (mMsg.body.motion.action == AMOTION_EVENT_ACTION_MOVE ||
                     mMsg.body.motion.action == AMOTION_EVENT_ACTION_HOVER_MOVE) {
-                    Batch batch;
+                    Batch& batch = mBatches.emplace_back();
                     batch.samples.push_back(mMsg);
-                    mBatches.push_back(batch);
                     ALOGD_IF(DEBUG_TRANSPORT_CONSUMER,
                              "channel '%s' consumer ~ started batch event",
                              mChannel->getName().c_str());
@@ -1082,6 +1146,7 @@ status_t InputConsumer::consumeSamples(InputEventFactoryInterface* factory,
             addSample(motionEvent, &msg);
         } else {
             initializeMotionEvent(motionEvent, &msg);
+            motionEvent->reserveSamples(count);
         }
         chain = msg.header.seq;
     }
@@ -1339,42 +1404,42 @@ status_t InputConsumer::sendFinishedSignal(uint32_t seq, bool handled) {
         return BAD_VALUE;
     }
 
-    // Send finished signals for the batch sequence chain first.
-    size_t seqChainCount = mSeqChains.size();
-    if (seqChainCount) {
-        uint32_t currentSeq = seq;
-        uint32_t chainSeqs[seqChainCount];
-        size_t chainIndex = 0;
-        for (size_t i = seqChainCount; i > 0; ) {
-             i--;
-             const SeqChain& seqChain = mSeqChains[i];
-             if (seqChain.seq == currentSeq) {
-                 currentSeq = seqChain.chain;
-                 chainSeqs[chainIndex++] = currentSeq;
-                 mSeqChains.erase(mSeqChains.begin() + i);
-             }
-        }
-        status_t status = OK;
-        while (!status && chainIndex > 0) {
-            chainIndex--;
-            status = sendUnchainedFinishedSignal(chainSeqs[chainIndex], handled);
-        }
-        if (status) {
-            // An error occurred so at least one signal was not sent, reconstruct the chain.
-            for (;;) {
-                SeqChain seqChain;
-                seqChain.seq = chainIndex != 0 ? chainSeqs[chainIndex - 1] : seq;
-                seqChain.chain = chainSeqs[chainIndex];
-                mSeqChains.push_back(seqChain);
-                if (!chainIndex) break;
-                chainIndex--;
-            }
-            return status;
+    // Collect the batch sequence chain. The finished signals for the chain are sent first, oldest
+    // first, followed by the finished signal for the last message in the batch. All of them are
+    // written to the channel together.
+    const size_t seqChainCount = mSeqChains.size();
+    uint32_t seqs[seqChainCount + 1];
+    size_t count = seqChainCount + 1;
+    uint32_t currentSeq = seq;
+    seqs[--count] = seq;
+    for (size_t i = seqChainCount; i > 0;) {
+        i--;
+        const SeqChain& seqChain = mSeqChains[i];
+        if (seqChain.seq == currentSeq) {
+            currentSeq = seqChain.chain;
+            seqs[--count] = currentSeq;
+            mSeqChains.erase(mSeqChains.begin() + i);
         }
     }
+    const uint32_t* finishSeqs = &seqs[count];
+    const size_t finishCount = seqChainCount + 1 - count;
 
-    // Send finished signal for the last message in the batch.
-    return sendUnchainedFinishedSignal(seq, handled);
+    if (finishCount == 1) {
+        return sendUnchainedFinishedSignal(seq, handled);
+    }
+
+    size_t sentCount;
+    status_t status = sendUnchainedFinishedSignals(finishSeqs, finishCount, handled, &sentCount);
+    if (status && sentCount + 1 < finishCount) {
+        // At least one signal for the chain was not sent, so reconstruct the remaining chain.
+        for (size_t i = sentCount; i + 1 < finishCount; i++) {
+            SeqChain seqChain;
+            seqChain.seq = finishSeqs[i + 1];
+            seqChain.chain = finishSeqs[i];
+            mSeqChains.push_back(seqChain);
+        }
+    }
+    return status;
 }
 
 status_t InputConsumer::sendTimeline(int32_t inputEventId,
@@ -1426,6 +1491,26 @@ status_t InputConsumer::sendUnchainedFinishedSignal(uint32_t seq, bool handled)
     return result;
 }
 
+status_t InputConsumer::sendUnchainedFinishedSignals(const uint32_t* seqs, size_t count,
+                                                     bool handled, size_t* outSentCount) {
+    mFinishedMessages.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        InputMessage& msg = mFinishedMessages[i];
+        msg.header.type = InputMessage::Type::FINISHED;
+        msg.header.seq = seqs[i];
+        msg.body.finished.handled = handled;
+        msg.body.finished.consumeTime = getConsumeTime(seqs[i]);
+    }
+    status_t result = mChannel->sendMessages(mFinishedMessages.data(), count, outSentCount);
+    // As in sendUnchainedFinishedSignal, only forget the consume times of the messages that were
+    // actually written; the rest will be retried.
+    for (size_t i = 0; i < *outSentCount; i++) {
+        popConsumeTime(seqs[i]);
+        ATRACE_ASYNC_END("InputConsumer processing", /*cookie=*/seqs[i]);
+    }
+    return result;
+}
+
 bool InputConsumer::hasPendingBatch() const {
     return !mBatches.empty();
 }
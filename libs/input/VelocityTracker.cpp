@@ -404,17 +404,22 @@ void AccumulatingVelocityTrackerStrategy::addMovement(nsecs_t eventTime, int32_t
         // for this time (i.e. pop out the last element, and insert the updated movement).
         // We only compare against the last value, as it is likely that addMovement is called
         // in chronological order as events occur.
-        movements.popBack();
+        onMovementRemoved(pointerId, movements.popBack());
     }
 
+    if (movements.size() == movements.capacity()) {
+        // The oldest movement is about to be overwritten.
+        onMovementRemoved(pointerId, movements[0]);
+    }
     movements.pushBack({eventTime, position});
+    onMovementAdded(pointerId, movements[movements.size() - 1]);
 
     // Clear movements that do not fall within `mHorizonNanos` of the latest movement.
     // Note that, if in the future we decide to use more movements (i.e. increase HISTORY_SIZE),
     // we can consider making this step binary-search based, which will give us some improvement.
     if (mMaintainHorizonDuringAdd) {
         while (eventTime - movements[0].eventTime > mHorizonNanos) {
-            movements.popFront();
+            onMovementRemoved(pointerId, movements.popFront());
         }
     }
 }
@@ -430,6 +435,63 @@ LeastSquaresVelocityTrackerStrategy::LeastSquaresVelocityTrackerStrategy(uint32_
 
 LeastSquaresVelocityTrackerStrategy::~LeastSquaresVelocityTrackerStrategy() {}
 
+void LeastSquaresVelocityTrackerStrategy::clearPointer(int32_t pointerId) {
+    AccumulatingVelocityTrackerStrategy::clearPointer(pointerId);
+    mMoments.erase(pointerId);
+}
+
+void LeastSquaresVelocityTrackerStrategy::Moments::update(const Movement& movement,
+                                                          int32_t sign) {
+    const double x = (movement.eventTime - originTime) * 1E-9;
+    const double y = static_cast<double>(movement.position) - originPosition;
+    const double x2 = x * x;
+    count += sign;
+    sx += sign * x;
+    sx2 += sign * x2;
+    sx3 += sign * x2 * x;
+    sx4 += sign * x2 * x2;
+    sy += sign * y;
+    sxy += sign * x * y;
+    sx2y += sign * x2 * y;
+}
+
+void LeastSquaresVelocityTrackerStrategy::rebaseMoments(Moments& moments,
+                                                        const RingBuffer<Movement>& movements) {
+    moments = {};
+    moments.originTime = movements[0].eventTime;
+    moments.originPosition = movements[0].position;
+    for (const Movement& movement : movements) {
+        moments.update(movement, 1);
+    }
+}
+
+void LeastSquaresVelocityTrackerStrategy::onMovementAdded(int32_t pointerId,
+                                                          const Movement& movement) {
+    if (!usesMoments()) {
+        return;
+    }
+    auto [it, inserted] = mMoments.try_emplace(pointerId);
+    Moments& moments = it->second;
+    if (inserted || moments.count == 0 ||
+        movement.eventTime - moments.originTime > MOMENTS_REBASE_INTERVAL) {
+        // The movement has already been appended to the history, so it is included here.
+        rebaseMoments(moments, mMovements.at(pointerId));
+        return;
+    }
+    moments.update(movement, 1);
+}
+
+void LeastSquaresVelocityTrackerStrategy::onMovementRemoved(int32_t pointerId,
+                                                            const Movement& movement) {
+    if (!usesMoments()) {
+        return;
+    }
+    const auto it = mMoments.find(pointerId);
+    if (it != mMoments.end()) {
+        it->second.update(movement, -1);
+    }
+}
+
 /**
  * Solves a linear least squares problem to obtain a N degree polynomial that fits
  * the specified input data as nearly as possible.
@@ -597,52 +659,32 @@ static std::optional<float> solveLeastSquares(const std::vector<float>& x,
 }
 
 /*
- * Optimized unweighted second-order least squares fit. About 2x speed improvement compared to
- * the default implementation
+ * Optimized unweighted second-order least squares fit, using the running moments of the pointer.
+ * This is O(1) per query, rather than O(history size).
  */
 std::optional<float> LeastSquaresVelocityTrackerStrategy::solveUnweightedLeastSquaresDeg2(
-        const RingBuffer<Movement>& movements) const {
+        const Moments& moments, nsecs_t newestEventTime) const {
     // Solving y = a*x^2 + b*x + c, where
-    //      - "x" is age (i.e. duration since latest movement) of the movemnets
-    //      - "y" is positions of the movements.
-    float sxi = 0, sxiyi = 0, syi = 0, sxi2 = 0, sxi3 = 0, sxi2yi = 0, sxi4 = 0;
-
-    const size_t count = movements.size();
-    const Movement& newestMovement = movements[count - 1];
-    for (size_t i = 0; i < count; i++) {
-        const Movement& movement = movements[i];
-        nsecs_t age = newestMovement.eventTime - movement.eventTime;
-        float xi = -age * SECONDS_PER_NANO;
-        float yi = movement.position;
-
-        float xi2 = xi*xi;
-        float xi3 = xi2*xi;
-        float xi4 = xi3*xi;
-        float xiyi = xi*yi;
-        float xi2yi = xi2*yi;
-
-        sxi += xi;
-        sxi2 += xi2;
-        sxiyi += xiyi;
-        sxi2yi += xi2yi;
-        syi += yi;
-        sxi3 += xi3;
-        sxi4 += xi4;
-    }
-
-    float Sxx = sxi2 - sxi*sxi / count;
-    float Sxy = sxiyi - sxi*syi / count;
-    float Sxx2 = sxi3 - sxi*sxi2 / count;
-    float Sx2y = sxi2yi - sxi2*syi / count;
-    float Sx2x2 = sxi4 - sxi2*sxi2 / count;
-
-    float denominator = Sxx*Sx2x2 - Sxx2*Sxx2;
+    //      - "x" is the time of the movements relative to the moment origin
+    //      - "y" is positions of the movements relative to the moment origin.
+    // The velocity is the derivative of the fit at the newest movement, 2*a*xn + b.
+    const double count = moments.count;
+    const double Sxx = moments.sx2 - moments.sx * moments.sx / count;
+    const double Sxy = moments.sxy - moments.sx * moments.sy / count;
+    const double Sxx2 = moments.sx3 - moments.sx * moments.sx2 / count;
+    const double Sx2y = moments.sx2y - moments.sx2 * moments.sy / count;
+    const double Sx2x2 = moments.sx4 - moments.sx2 * moments.sx2 / count;
+
+    const double denominator = Sxx * Sx2x2 - Sxx2 * Sxx2;
     if (denominator == 0) {
         ALOGW("division by 0 when computing velocity, Sxx=%f, Sx2x2=%f, Sxx2=%f", Sxx, Sx2x2, Sxx2);
         return std::nullopt;
     }
 
-    return (Sxy * Sx2x2 - Sx2y * Sxx2) / denominator;
+    const double a = (Sx2y * Sxx - Sxy * Sxx2) / denominator;
+    const double b = (Sxy * Sx2x2 - Sx2y * Sxx2) / denominator;
+    const double xn = (newestEventTime - moments.originTime) * 1E-9;
+    return static_cast<float>(2 * a * xn + b);
 }
 
 std::optional<float> LeastSquaresVelocityTrackerStrategy::getVelocity(int32_t pointerId) const {
@@ -668,7 +710,8 @@ std::optional<float> LeastSquaresVelocityTrackerStrategy::getVelocity(int32_t po
 
     if (degree == 2 && mWeighting == Weighting::NONE) {
         // Optimize unweighted, quadratic polynomial fit
-        return solveUnweightedLeastSquaresDeg2(movements);
+        return solveUnweightedLeastSquaresDeg2(mMoments.at(pointerId),
+                                               movements[size - 1].eventTime);
     }
 
     // Iterate over movement samples in reverse time order and collect samples.
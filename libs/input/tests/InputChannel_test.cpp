@@ -228,6 +228,41 @@ TEST_F(InputChannelTest, SendAndReceive_MotionClassification) {
     }
 }
 
+TEST_F(InputChannelTest, SendMessages_ReceivedInOrder) {
+    std::unique_ptr<InputChannel> serverChannel, clientChannel;
+    status_t result = InputChannel::openInputChannelPair("channel name",
+            serverChannel, clientChannel);
+    ASSERT_EQ(OK, result)
+            << "should have successfully opened a channel pair";
+
+    // More messages than are written by a single system call.
+    constexpr size_t MESSAGE_COUNT = 20;
+    std::vector<InputMessage> clientMsgs(MESSAGE_COUNT);
+    for (size_t i = 0; i < MESSAGE_COUNT; i++) {
+        clientMsgs[i].header.type = InputMessage::Type::FINISHED;
+        clientMsgs[i].header.seq = i + 1;
+        clientMsgs[i].body.finished.handled = (i % 2) == 0;
+        clientMsgs[i].body.finished.consumeTime = 1000 + i;
+    }
+
+    size_t sentCount = 0;
+    EXPECT_EQ(OK, clientChannel->sendMessages(clientMsgs.data(), MESSAGE_COUNT, &sentCount))
+            << "client channel should be able to send messages to server channel";
+    EXPECT_EQ(MESSAGE_COUNT, sentCount);
+
+    InputMessage serverMsg;
+    for (size_t i = 0; i < MESSAGE_COUNT; i++) {
+        EXPECT_EQ(OK, serverChannel->receiveMessage(&serverMsg))
+                << "server channel should be able to receive message from client channel";
+        EXPECT_EQ(InputMessage::Type::FINISHED, serverMsg.header.type);
+        EXPECT_EQ(i + 1, serverMsg.header.seq);
+        EXPECT_EQ((i % 2) == 0, serverMsg.body.finished.handled);
+        EXPECT_EQ(static_cast<nsecs_t>(1000 + i), serverMsg.body.finished.consumeTime);
+    }
+    EXPECT_EQ(WOULD_BLOCK, serverChannel->receiveMessage(&serverMsg))
+            << "server channel should not have any more messages";
+}
+
 TEST_F(InputChannelTest, DuplicateChannelAndAssertEqual) {
     std::unique_ptr<InputChannel> serverChannel, clientChannel;
 
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <gui/constants.h>
+#include <input/Input.h>
+#include <input/MotionPredictor.h>
+
+namespace android {
+
+namespace {
+
+constexpr nsecs_t NSEC_PER_MSEC = 1'000'000;
+
+// Interval between the recorded stylus samples, roughly 240 Hz.
+constexpr nsecs_t SAMPLE_INTERVAL = 4 * NSEC_PER_MSEC;
+
+MotionEvent getStylusEvent(int32_t action, float x, float y, nsecs_t eventTime) {
+    PointerProperties properties;
+    properties.clear();
+    properties.id = 0;
+    properties.toolType = ToolType::STYLUS;
+    PointerCoords coords;
+    coords.clear();
+    coords.setAxisValue(AMOTION_EVENT_AXIS_X, x);
+    coords.setAxisValue(AMOTION_EVENT_AXIS_Y, y);
+    coords.setAxisValue(AMOTION_EVENT_AXIS_PRESSURE, 0.5);
+
+    MotionEvent event;
+    ui::Transform identityTransform;
+    event.initialize(InputEvent::nextId(), /*deviceId=*/0, AINPUT_SOURCE_STYLUS,
+                     ADISPLAY_ID_DEFAULT, {0}, action, /*actionButton=*/0, /*flags=*/0,
+                     AMOTION_EVENT_EDGE_FLAG_NONE, AMETA_NONE, /*buttonState=*/0,
+                     MotionClassification::NONE, identityTransform, /*xPrecision=*/0.1,
+                     /*yPrecision=*/0.2, /*xCursorPosition=*/280, /*yCursorPosition=*/540,
+                     identityTransform, /*downTime=*/0, eventTime, /*pointerCount=*/1, &properties,
+                     &coords);
+    return event;
+}
+
+// Records a stroke long enough to fill the model's input buffers.
+nsecs_t recordStroke(MotionPredictor& predictor) {
+    nsecs_t eventTime = 0;
+    predictor.record(getStylusEvent(AMOTION_EVENT_ACTION_DOWN, 0, 0, eventTime));
+    for (int i = 1; i <= 20; i++) {
+        eventTime += SAMPLE_INTERVAL;
+        predictor.record(getStylusEvent(AMOTION_EVENT_ACTION_MOVE, 5 * i, 3 * i, eventTime));
+    }
+    return eventTime;
+}
+
+void BM_MotionPredictor_predict(benchmark::State& state) {
+    MotionPredictor predictor(/*predictionTimestampOffsetNanos=*/0, []() { return true; });
+    const nsecs_t lastEventTime = recordStroke(predictor);
+    for (auto _ : state) {
+        std::unique_ptr<MotionEvent> prediction =
+                predictor.predict(lastEventTime + 4 * SAMPLE_INTERVAL);
+        benchmark::DoNotOptimize(prediction);
+    }
+}
+
+void BM_MotionPredictor_predictIntoReusedEvent(benchmark::State& state) {
+    MotionPredictor predictor(/*predictionTimestampOffsetNanos=*/0, []() { return true; });
+    const nsecs_t lastEventTime = recordStroke(predictor);
+    MotionEvent prediction;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                predictor.predict(lastEventTime + 4 * SAMPLE_INTERVAL, prediction));
+    }
+}
+
+// Includes the cost of recording a new sample, as happens on every frame of a stroke.
+void BM_MotionPredictor_recordAndPredict(benchmark::State& state) {
+    MotionPredictor predictor(/*predictionTimestampOffsetNanos=*/0, []() { return true; });
+    nsecs_t eventTime = recordStroke(predictor);
+    MotionEvent prediction;
+    float position = 100;
+    for (auto _ : state) {
+        eventTime += SAMPLE_INTERVAL;
+        position += 5;
+        predictor.record(getStylusEvent(AMOTION_EVENT_ACTION_MOVE, position, position, eventTime));
+        benchmark::DoNotOptimize(predictor.predict(eventTime + SAMPLE_INTERVAL, prediction));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_MotionPredictor_predict);
+BENCHMARK(BM_MotionPredictor_predictIntoReusedEvent);
+BENCHMARK(BM_MotionPredictor_recordAndPredict);
+
+} // namespace android
+
+BENCHMARK_MAIN();
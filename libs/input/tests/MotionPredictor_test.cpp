@@ -108,6 +108,32 @@ TEST(MotionPredictorTest, FollowsGesture) {
     EXPECT_EQ(nullptr, predictor.predict(20 * NSEC_PER_MSEC));
 }
 
+TEST(MotionPredictorTest, PredictIntoReusedEvent) {
+    MotionPredictor predictor(/*predictionTimestampOffsetNanos=*/0,
+                              []() { return true /*enable prediction*/; });
+    MotionEvent prediction;
+
+    predictor.record(getMotionEvent(DOWN, 2, 5, 20ms));
+    predictor.record(getMotionEvent(MOVE, 2, 7, 30ms));
+    predictor.record(getMotionEvent(MOVE, 3, 9, 40ms));
+    ASSERT_TRUE(predictor.predict(50 * NSEC_PER_MSEC, prediction));
+    const nsecs_t firstPredictionTime = prediction.getEventTime();
+    EXPECT_GT(firstPredictionTime, 40 * NSEC_PER_MSEC);
+
+    // The same event is overwritten by the next prediction.
+    predictor.record(getMotionEvent(MOVE, 4, 11, 50ms));
+    ASSERT_TRUE(predictor.predict(60 * NSEC_PER_MSEC, prediction));
+    EXPECT_GT(prediction.getEventTime(), firstPredictionTime);
+    EXPECT_EQ(AMOTION_EVENT_ACTION_MOVE, prediction.getAction());
+    EXPECT_EQ(1u, prediction.getPointerCount());
+
+    // The event is left untouched when there is no prediction.
+    predictor.record(getMotionEvent(UP, 4, 11, 60ms));
+    const nsecs_t lastPredictionTime = prediction.getEventTime();
+    EXPECT_FALSE(predictor.predict(70 * NSEC_PER_MSEC, prediction));
+    EXPECT_EQ(lastPredictionTime, prediction.getEventTime());
+}
+
 TEST(MotionPredictorTest, MultipleDevicesNotSupported) {
     MotionPredictor predictor(/*predictionTimestampOffsetNanos=*/0,
                               []() { return true /*enable prediction*/; });
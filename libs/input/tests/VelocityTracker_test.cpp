@@ -1335,6 +1335,22 @@ TEST_F(VelocityTrackerTest, LeastSquaresVelocityTrackerStrategy_Parabolic3) {
     computeAndCheckQuadraticVelocity(motions, 0E3);
 }
 
+/*
+ * Straight line over a long gesture. Movements continuously leave the history, both because they
+ * fall outside the horizon and because the history is full, so the fit must stay exact as the
+ * history slides.
+ */
+TEST_F(VelocityTrackerTest, LeastSquaresVelocityTrackerStrategy_LinearLongGesture) {
+    std::vector<PlanarMotionEventEntry> motions;
+    for (int i = 0; i < 400; i++) {
+        const float position = 100 + 2 * i;
+        motions.push_back({i * 4ms, {{position, position}}});
+    }
+    motions.push_back(motions.back()); // ACTION_UP
+    // 2 pixels every 4 ms.
+    computeAndCheckQuadraticVelocity(motions, 500);
+}
+
 // Recorded by hand on sailfish, but only the diffs are taken to test cumulative axis velocity.
 TEST_F(VelocityTrackerTest, AxisScrollVelocity) {
     std::vector<std::pair<std::chrono::nanoseconds, float>> motions = {
@@ -31,7 +31,8 @@ namespace skia {
 
 sk_sp<SkRuntimeEffect> buildRuntimeEffect(const shaders::LinearEffect& linearEffect) {
     ATRACE_CALL();
-    SkString shaderString = SkString(shaders::buildLinearEffectSkSL(linearEffect));
+    const std::string& sksl = shaders::buildLinearEffectSkSL(linearEffect);
+    SkString shaderString(sksl.data(), sksl.size());
 
     auto [shader, error] = SkRuntimeEffect::MakeForShader(shaderString);
     if (!shader) {
@@ -50,13 +51,13 @@ sk_sp<SkShader> createLinearEffectShader(
 
     effectBuilder.child("child") = shader;
 
-    const auto uniforms =
-            shaders::buildLinearEffectUniforms(linearEffect, colorTransform, maxDisplayLuminance,
-                                               currentDisplayLuminanceNits, maxLuminance, buffer,
-                                               renderIntent);
+    shaders::LinearEffectUniforms uniforms;
+    shaders::buildLinearEffectUniforms(linearEffect, colorTransform, maxDisplayLuminance,
+                                       currentDisplayLuminanceNits, maxLuminance, buffer,
+                                       renderIntent, uniforms);
 
     for (const auto& uniform : uniforms) {
-        effectBuilder.uniform(uniform.name.c_str()).set(uniform.value.data(), uniform.value.size());
+        effectBuilder.uniform(uniform.name.data()).set(uniform.value.data(), uniform.value.size());
     }
 
     return effectBuilder.makeShader();
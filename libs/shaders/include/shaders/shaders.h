@@ -19,7 +19,10 @@
 #include <math/mat4.h>
 #include <tonemap/tonemap.h>
 #include <ui/GraphicTypes.h>
+#include <array>
 #include <cstddef>
+#include <span>
+#include <string_view>
 
 namespace android::shaders {
 
@@ -90,11 +93,52 @@ struct LinearEffectHasher {
     }
 };
 
+// Fixed-capacity block of shader uniforms, so that the uniforms of the LinearEffect shader can be
+// rebuilt for every draw without heap allocations. The names and values of the uniforms are copied
+// into the block, and remain valid until it is cleared or destroyed.
+class LinearEffectUniforms {
+public:
+    struct Uniform {
+        // Name of the uniform, which is also null-terminated.
+        std::string_view name;
+        std::span<const uint8_t> value;
+    };
+
+    LinearEffectUniforms() = default;
+    LinearEffectUniforms(const LinearEffectUniforms&) = delete;
+    LinearEffectUniforms& operator=(const LinearEffectUniforms&) = delete;
+
+    // Appends a uniform to the block.
+    void append(std::string_view name, std::span<const uint8_t> value);
+
+    // Removes all uniforms from the block.
+    void clear();
+
+    const Uniform* begin() const { return mUniforms.data(); }
+    const Uniform* end() const { return mUniforms.data() + mSize; }
+    size_t size() const { return mSize; }
+
+private:
+    static constexpr size_t kMaxUniforms = 8;
+    static constexpr size_t kNameCapacity = 512;
+    static constexpr size_t kValueCapacity = 256;
+
+    std::array<Uniform, kMaxUniforms> mUniforms;
+    size_t mSize = 0;
+    std::array<char, kNameCapacity> mNames;
+    size_t mNamesSize = 0;
+    alignas(16) std::array<uint8_t, kValueCapacity> mValues;
+    size_t mValuesSize = 0;
+};
+
 // Generates a shader string that applies color transforms in linear space.
 // Typical use-cases supported:
 // 1. Apply tone-mapping
 // 2. Apply color transform matrices in linear space
-std::string buildLinearEffectSkSL(const LinearEffect& linearEffect);
+//
+// The shader string only depends on the effect, so it is generated once for each effect and
+// reused for the lifetime of the process.
+const std::string& buildLinearEffectSkSL(const LinearEffect& linearEffect);
 
 // Generates a list of uniforms to set on the LinearEffect shader above.
 std::vector<tonemap::ShaderUniform> buildLinearEffectUniforms(
@@ -103,4 +147,12 @@ std::vector<tonemap::ShaderUniform> buildLinearEffectUniforms(
         aidl::android::hardware::graphics::composer3::RenderIntent renderIntent =
                 aidl::android::hardware::graphics::composer3::RenderIntent::TONE_MAP_COLORIMETRIC);
 
+// Allocation-free variant of buildLinearEffectUniforms() above, which replaces the contents of
+// uniforms with the uniforms to set on the LinearEffect shader.
+void buildLinearEffectUniforms(
+        const LinearEffect& linearEffect, const mat4& colorTransform, float maxDisplayLuminance,
+        float currentDisplayLuminanceNits, float maxLuminance, AHardwareBuffer* buffer,
+        aidl::android::hardware::graphics::composer3::RenderIntent renderIntent,
+        LinearEffectUniforms& uniforms);
+
 } // namespace android::shaders
@@ -18,15 +18,22 @@
 
 #include <tonemap/tonemap.h>
 
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
+#include <log/log.h>
 #include <math/mat4.h>
 #include <system/graphics-base-v1.0.h>
 #include <ui/ColorSpace.h>
 
 namespace android::shaders {
 
+ColorSpace toColorSpace(ui::Dataspace dataspace);
+
 namespace {
 
 aidl::android::hardware::graphics::common::Dataspace toAidlDataspace(ui::Dataspace dataspace) {
@@ -221,16 +228,11 @@ void generateEffectiveOOTF(bool undoPremultipliedAlpha, LinearEffect::SkSLType t
 }
 
 template <typename T, std::enable_if_t<std::is_trivially_copyable<T>::value, bool> = true>
-std::vector<uint8_t> buildUniformValue(T value) {
-    std::vector<uint8_t> result;
-    result.resize(sizeof(value));
-    std::memcpy(result.data(), &value, sizeof(value));
-    return result;
+std::span<const uint8_t> uniformValue(const T& value) {
+    return {reinterpret_cast<const uint8_t*>(&value), sizeof(value)};
 }
 
-} // namespace
-
-std::string buildLinearEffectSkSL(const LinearEffect& linearEffect) {
+std::string generateLinearEffectSkSL(const LinearEffect& linearEffect) {
     std::string shaderString;
     generateXYZTransforms(shaderString);
     generateOOTF(linearEffect.inputDataspace, linearEffect.outputDataspace, shaderString);
@@ -245,6 +247,79 @@ std::string buildLinearEffectSkSL(const LinearEffect& linearEffect) {
     return shaderString;
 }
 
+// The gamut matrices of the color space of each dataspace standard, which are the only part of a
+// dataspace that the uniforms depend on.
+struct GamutTransforms {
+    mat3 xyzToRgb;
+    mat4 rgbToXyz4;
+    mat4 xyzToRgb4;
+};
+
+constexpr size_t kStandardCount = (HAL_DATASPACE_STANDARD_MASK >> HAL_DATASPACE_STANDARD_SHIFT) + 1;
+
+const GamutTransforms& getGamutTransforms(ui::Dataspace dataspace) {
+    static const auto sTransforms = [] {
+        std::array<GamutTransforms, kStandardCount> transforms;
+        for (size_t i = 0; i < kStandardCount; i++) {
+            const auto colorSpace = toColorSpace(
+                    static_cast<ui::Dataspace>(i << HAL_DATASPACE_STANDARD_SHIFT));
+            transforms[i] = {.xyzToRgb = colorSpace.getXYZtoRGB(),
+                             .rgbToXyz4 = mat4(colorSpace.getRGBtoXYZ()),
+                             .xyzToRgb4 = mat4(colorSpace.getXYZtoRGB())};
+        }
+        return transforms;
+    }();
+    return sTransforms[(static_cast<uint32_t>(dataspace) & HAL_DATASPACE_STANDARD_MASK) >>
+                       HAL_DATASPACE_STANDARD_SHIFT];
+}
+
+} // namespace
+
+const std::string& buildLinearEffectSkSL(const LinearEffect& linearEffect) {
+    // LinearEffect equality ignores the SkSL type, so each type has its own cache. Entries are
+    // never removed: a device only ever sees a handful of effects, and references to the cached
+    // strings are handed out to callers.
+    using Cache = std::unordered_map<LinearEffect, std::string, LinearEffectHasher>;
+    static std::mutex sMutex;
+    static std::array<Cache, 2> sCaches;
+
+    const size_t typeIndex = linearEffect.type == LinearEffect::SkSLType::Shader ? 0 : 1;
+    std::lock_guard lock(sMutex);
+    Cache& cache = sCaches[typeIndex];
+    if (const auto it = cache.find(linearEffect); it != cache.end()) {
+        return it->second;
+    }
+    return cache.emplace(linearEffect, generateLinearEffectSkSL(linearEffect)).first->second;
+}
+
+void LinearEffectUniforms::append(std::string_view name, std::span<const uint8_t> value) {
+    LOG_ALWAYS_FATAL_IF(mSize == kMaxUniforms, "Too many LinearEffect uniforms: %zu", mSize + 1);
+    LOG_ALWAYS_FATAL_IF(mNamesSize + name.size() + 1 > kNameCapacity,
+                        "LinearEffect uniform names exceed %zu bytes", kNameCapacity);
+    // Keep values 4-byte aligned, which is the alignment of every SkSL uniform type.
+    const size_t valueOffset = (mValuesSize + 3) & ~size_t(3);
+    LOG_ALWAYS_FATAL_IF(valueOffset + value.size() > kValueCapacity,
+                        "LinearEffect uniform values exceed %zu bytes", kValueCapacity);
+
+    char* nameData = mNames.data() + mNamesSize;
+    std::memcpy(nameData, name.data(), name.size());
+    nameData[name.size()] = '\0';
+    mNamesSize += name.size() + 1;
+
+    uint8_t* valueData = mValues.data() + valueOffset;
+    std::memcpy(valueData, value.data(), value.size());
+    mValuesSize = valueOffset + value.size();
+
+    mUniforms[mSize++] = {.name = std::string_view(nameData, name.size()),
+                          .value = std::span<const uint8_t>(valueData, value.size())};
+}
+
+void LinearEffectUniforms::clear() {
+    mSize = 0;
+    mNamesSize = 0;
+    mValuesSize = 0;
+}
+
 ColorSpace toColorSpace(ui::Dataspace dataspace) {
     switch (dataspace & HAL_DATASPACE_STANDARD_MASK) {
         case HAL_DATASPACE_STANDARD_BT709:
@@ -276,26 +351,44 @@ std::vector<tonemap::ShaderUniform> buildLinearEffectUniforms(
         const LinearEffect& linearEffect, const mat4& colorTransform, float maxDisplayLuminance,
         float currentDisplayLuminanceNits, float maxLuminance, AHardwareBuffer* buffer,
         aidl::android::hardware::graphics::composer3::RenderIntent renderIntent) {
+    LinearEffectUniforms block;
+    buildLinearEffectUniforms(linearEffect, colorTransform, maxDisplayLuminance,
+                              currentDisplayLuminanceNits, maxLuminance, buffer, renderIntent,
+                              block);
+
     std::vector<tonemap::ShaderUniform> uniforms;
+    uniforms.reserve(block.size());
+    for (const auto& uniform : block) {
+        uniforms.push_back({.name = std::string(uniform.name),
+                            .value = std::vector<uint8_t>(uniform.value.begin(),
+                                                          uniform.value.end())});
+    }
+    return uniforms;
+}
+
+void buildLinearEffectUniforms(
+        const LinearEffect& linearEffect, const mat4& colorTransform, float maxDisplayLuminance,
+        float currentDisplayLuminanceNits, float maxLuminance, AHardwareBuffer* buffer,
+        aidl::android::hardware::graphics::composer3::RenderIntent renderIntent,
+        LinearEffectUniforms& uniforms) {
+    static const mat3 sLinearExtendedSRGBToXyz = ColorSpace::linearExtendedSRGB().getRGBtoXYZ();
+    static const mat4 sXyzToLinearExtendedSRGB =
+            mat4(ColorSpace::linearExtendedSRGB().getXYZtoRGB());
 
-    auto inputColorSpace = toColorSpace(linearEffect.inputDataspace);
-    auto outputColorSpace = toColorSpace(linearEffect.outputDataspace);
+    uniforms.clear();
 
-    uniforms.push_back(
-            {.name = "in_rgbToXyz",
-             .value = buildUniformValue<mat3>(ColorSpace::linearExtendedSRGB().getRGBtoXYZ())});
-    uniforms.push_back({.name = "in_xyzToSrcRgb",
-                        .value = buildUniformValue<mat3>(inputColorSpace.getXYZtoRGB())});
+    const GamutTransforms& input = getGamutTransforms(linearEffect.inputDataspace);
+    const GamutTransforms& output = getGamutTransforms(linearEffect.outputDataspace);
+
+    uniforms.append("in_rgbToXyz", uniformValue(sLinearExtendedSRGBToXyz));
+    uniforms.append("in_xyzToSrcRgb", uniformValue(input.xyzToRgb));
     // Transforms xyz colors to linear source colors, then applies the color transform, then
     // transforms to linear extended RGB for skia to color manage.
-    uniforms.push_back({.name = "in_colorTransform",
-                        .value = buildUniformValue<mat4>(
-                                mat4(ColorSpace::linearExtendedSRGB().getXYZtoRGB()) *
-                                // TODO: the color transform ideally should be applied
-                                // in the source colorspace, but doing that breaks
-                                // renderengine tests
-                                mat4(outputColorSpace.getRGBtoXYZ()) * colorTransform *
-                                mat4(outputColorSpace.getXYZtoRGB()))});
+    // TODO: the color transform ideally should be applied in the source colorspace, but doing that
+    // breaks renderengine tests
+    const mat4 xyzColorTransform =
+            sXyzToLinearExtendedSRGB * output.rgbToXyz4 * colorTransform * output.xyzToRgb4;
+    uniforms.append("in_colorTransform", uniformValue(xyzColorTransform));
 
     tonemap::Metadata metadata{.displayMaxLuminance = maxDisplayLuminance,
                                // If the input luminance is unknown, use display luminance (aka,
@@ -309,11 +402,11 @@ std::vector<tonemap::ShaderUniform> buildLinearEffectUniforms(
                                .buffer = buffer,
                                .renderIntent = renderIntent};
 
-    for (const auto uniform : tonemap::getToneMapper()->generateShaderSkSLUniforms(metadata)) {
-        uniforms.push_back(uniform);
-    }
-
-    return uniforms;
+    tonemap::getToneMapper()->writeShaderSkSLUniforms(metadata,
+                                                      [&](std::string_view name,
+                                                          std::span<const uint8_t> value) {
+                                                          uniforms.append(name, value);
+                                                      });
 }
 
 } // namespace android::shaders
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <math/mat4.h>
+#include <shaders/shaders.h>
+
+namespace android {
+
+namespace {
+
+using aidl::android::hardware::graphics::composer3::RenderIntent;
+
+// A PQ layer tone mapped to a Display P3 display, which is the most expensive effect to set up.
+const shaders::LinearEffect kEffect{.inputDataspace = ui::Dataspace::BT2020_ITU_PQ,
+                                    .outputDataspace = ui::Dataspace::DISPLAY_P3,
+                                    .fakeOutputDataspace = ui::Dataspace::UNKNOWN};
+
+const mat4 kColorTransform = mat4::scale(vec4(.9, .9, .9, 1.));
+
+void BM_buildLinearEffectSkSL(benchmark::State& state) {
+    for (auto _ : state) {
+        const std::string& shader = shaders::buildLinearEffectSkSL(kEffect);
+        benchmark::DoNotOptimize(shader.data());
+    }
+}
+
+void BM_buildLinearEffectUniforms(benchmark::State& state) {
+    for (auto _ : state) {
+        auto uniforms = shaders::buildLinearEffectUniforms(kEffect, kColorTransform, 500.f, 250.f,
+                                                           1000.f, nullptr,
+                                                           RenderIntent::TONE_MAP_COLORIMETRIC);
+        benchmark::DoNotOptimize(uniforms);
+    }
+}
+
+void BM_buildLinearEffectUniformsIntoBlock(benchmark::State& state) {
+    shaders::LinearEffectUniforms uniforms;
+    for (auto _ : state) {
+        shaders::buildLinearEffectUniforms(kEffect, kColorTransform, 500.f, 250.f, 1000.f,
+                                           nullptr, RenderIntent::TONE_MAP_COLORIMETRIC,
+                                           uniforms);
+        benchmark::DoNotOptimize(uniforms);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_buildLinearEffectSkSL);
+BENCHMARK(BM_buildLinearEffectUniforms);
+BENCHMARK(BM_buildLinearEffectUniformsIntoBlock);
+
+} // namespace android
+
+BENCHMARK_MAIN();
@@ -26,6 +26,7 @@ namespace android {
 
 using testing::Contains;
 using testing::HasSubstr;
+using testing::Not;
 
 struct ShadersTest : public ::testing::Test {};
 
@@ -93,4 +94,71 @@ TEST_F(ShadersTest, buildLinearEffectUniforms_selectsGamutTransformMatrices) {
     EXPECT_THAT(uniforms, Contains(UniformNameEq("in_colorTransform")));
 }
 
+TEST_F(ShadersTest, buildLinearEffectSkSL_reusesShaderForEqualEffects) {
+    const shaders::LinearEffect effect{.inputDataspace = ui::Dataspace::BT2020_ITU_PQ,
+                                       .outputDataspace = ui::Dataspace::DISPLAY_P3,
+                                       .fakeOutputDataspace = ui::Dataspace::UNKNOWN};
+    const shaders::LinearEffect sameEffect = effect;
+
+    const std::string& shader = shaders::buildLinearEffectSkSL(effect);
+    EXPECT_EQ(&shader, &shaders::buildLinearEffectSkSL(sameEffect));
+    EXPECT_THAT(shader, HasSubstr("half4 main(float2 xy)"));
+}
+
+TEST_F(ShadersTest, buildLinearEffectSkSL_separatesShaderAndColorFilter) {
+    shaders::LinearEffect effect{.inputDataspace = ui::Dataspace::BT2020_ITU_HLG,
+                                 .outputDataspace = ui::Dataspace::DISPLAY_P3,
+                                 .fakeOutputDataspace = ui::Dataspace::UNKNOWN};
+    const std::string& shader = shaders::buildLinearEffectSkSL(effect);
+    effect.type = shaders::LinearEffect::SkSLType::ColorFilter;
+    const std::string& colorFilter = shaders::buildLinearEffectSkSL(effect);
+
+    EXPECT_NE(shader, colorFilter);
+    EXPECT_THAT(colorFilter, HasSubstr("half4 main(half4 inputColor)"));
+}
+
+TEST_F(ShadersTest, buildLinearEffectUniforms_fillsBlock) {
+    const shaders::LinearEffect effect{.inputDataspace = ui::Dataspace::BT2020_ITU_PQ,
+                                       .outputDataspace = ui::Dataspace::DISPLAY_P3,
+                                       .fakeOutputDataspace = ui::Dataspace::UNKNOWN};
+    const mat4 colorTransform = mat4::scale(vec4(.9, .8, .7, 1.));
+    const auto renderIntent =
+            aidl::android::hardware::graphics::composer3::RenderIntent::TONE_MAP_COLORIMETRIC;
+
+    shaders::LinearEffectUniforms block;
+    // Fill the block first, to check that it is cleared before it is rebuilt.
+    block.append("in_stale", std::vector<uint8_t>(4));
+    shaders::buildLinearEffectUniforms(effect, colorTransform, 500.f, 250.f, 1000.f, nullptr,
+                                       renderIntent, block);
+
+    std::vector<tonemap::ShaderUniform> uniforms;
+    for (const auto& uniform : block) {
+        // Names are passed to Skia as C strings.
+        EXPECT_EQ('\0', uniform.name.data()[uniform.name.size()]);
+        uniforms.push_back({.name = std::string(uniform.name),
+                            .value = std::vector<uint8_t>(uniform.value.begin(),
+                                                          uniform.value.end())});
+    }
+
+    EXPECT_THAT(uniforms, Not(Contains(UniformNameEq("in_stale"))));
+    EXPECT_THAT(uniforms,
+                Contains(UniformEq("in_rgbToXyz",
+                                   buildUniformValue<mat3>(
+                                           ColorSpace::linearExtendedSRGB().getRGBtoXYZ()))));
+    EXPECT_THAT(uniforms,
+                Contains(UniformEq("in_xyzToSrcRgb",
+                                   buildUniformValue<mat3>(
+                                           ColorSpace::BT2020().getXYZtoRGB()))));
+    EXPECT_THAT(uniforms,
+                Contains(UniformEq("in_colorTransform",
+                                   buildUniformValue<mat4>(
+                                           mat4(ColorSpace::linearExtendedSRGB().getXYZtoRGB()) *
+                                           mat4(ColorSpace::DisplayP3().getRGBtoXYZ()) *
+                                           colorTransform *
+                                           mat4(ColorSpace::DisplayP3().getXYZtoRGB())))));
+    EXPECT_THAT(uniforms,
+                Contains(UniformEq("in_libtonemap_displayMaxLuminance",
+                                   buildUniformValue<float>(500.f))));
+}
+
 } // namespace android
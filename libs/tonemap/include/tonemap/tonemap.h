@@ -21,7 +21,10 @@
 #include <android/hardware_buffer.h>
 #include <math/vec3.h>
 
+#include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace android::tonemap {
@@ -135,6 +138,14 @@ public:
     // in_libtonemap_inputMaxLuminance inside of the body of the tone-mapping shader.
     virtual std::vector<ShaderUniform> generateShaderSkSLUniforms(const Metadata& metadata) = 0;
 
+    // Allocation-free variant of generateShaderSkSLUniforms(), for callers that bind the uniforms
+    // for every draw. Each uniform is passed to writeUniform instead of being returned in a list,
+    // and its name and value are only valid for the duration of that call.
+    using UniformWriter =
+            std::function<void(std::string_view name, std::span<const uint8_t> value)>;
+    virtual void writeShaderSkSLUniforms(const Metadata& metadata,
+                                         const UniformWriter& writeUniform) = 0;
+
     // CPU implementation of the tonemapping gain. This must match the GPU implementation returned
     // by generateTonemapGainShaderSKSL() above, with some epsilon difference to account for
     // differences in hardware precision.
@@ -148,8 +159,24 @@ public:
             aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
             aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
             const std::vector<Color>& colors, const Metadata& metadata) = 0;
+
+    // Batched CPU implementation of the tonemapping gain, for tonemapping large numbers of colors
+    // such as when processing images offline. The gain for colors[i] is written to gains[i], so
+    // gains must hold at least as many elements as colors.
+    //
+    // The gains are interpolated in single precision from a table of the tonemapping curve, which
+    // is built from lookupTonemapGain() once for each combination of transfer functions and
+    // metadata and then reused across calls. Each gain is within kTonemapGainLutTolerance of the
+    // gain returned by lookupTonemapGain(), relative to that gain.
+    virtual void lookupTonemapGains(
+            aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
+            aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
+            std::span<const Color> colors, const Metadata& metadata, std::span<float> gains) = 0;
 };
 
+// Maximum relative error of the gains returned by ToneMapper::lookupTonemapGains().
+static constexpr float kTonemapGainLutTolerance = 2e-3f;
+
 // Retrieves a tonemapper instance.
 // This instance is globally constructed.
 ToneMapper* getToneMapper();
@@ -18,12 +18,44 @@
 #include <gtest/gtest.h>
 #include <tonemap/tonemap.h>
 #include <cmath>
+#include <vector>
 
 namespace android {
 
+using aidl::android::hardware::graphics::common::Dataspace;
 using testing::HasSubstr;
 
-struct TonemapTest : public ::testing::Test {};
+struct TonemapTest : public ::testing::Test {
+    // Colors whose luminances span from below to above the range of HDR content, including black
+    // and negative colors.
+    static std::vector<tonemap::Color> generateColors() {
+        std::vector<tonemap::Color> colors;
+        for (float nits = 1e-8f; nits < 1e6f; nits *= 1.0137f) {
+            colors.push_back({.linearRGB = vec3(nits * 0.25f, nits, nits * 0.5f),
+                              .xyz = vec3(nits * 0.9f, nits * 0.8f, nits)});
+        }
+        colors.push_back({.linearRGB = vec3(0.f), .xyz = vec3(0.f)});
+        colors.push_back({.linearRGB = vec3(-1.f), .xyz = vec3(-1.f)});
+        return colors;
+    }
+
+    static void expectGainsMatch(Dataspace sourceDataspace, Dataspace destinationDataspace,
+                                 const tonemap::Metadata& metadata) {
+        const auto colors = generateColors();
+        const auto expected =
+                tonemap::getToneMapper()->lookupTonemapGain(sourceDataspace, destinationDataspace,
+                                                            colors, metadata);
+        std::vector<float> gains(colors.size());
+        tonemap::getToneMapper()->lookupTonemapGains(sourceDataspace, destinationDataspace, colors,
+                                                     metadata, gains);
+        for (size_t i = 0; i < colors.size(); i++) {
+            ASSERT_NEAR(expected[i], gains[i], expected[i] * tonemap::kTonemapGainLutTolerance)
+                    << "for luminance " << colors[i].linearRGB.g << " tonemapped from "
+                    << static_cast<int32_t>(sourceDataspace) << " to "
+                    << static_cast<int32_t>(destinationDataspace);
+        }
+    }
+};
 
 TEST_F(TonemapTest, generateShaderSkSLUniforms_containsDefaultUniforms) {
     static const constexpr float kDisplayMaxLuminance = 1.f;
@@ -85,4 +117,34 @@ TEST_F(TonemapTest, generateTonemapGainShaderSkSL_containsEntryPointForHLG) {
     EXPECT_THAT(shader, HasSubstr("float libtonemap_LookupTonemapGain(vec3 linearRGB, vec3 xyz)"));
 }
 
+TEST_F(TonemapTest, lookupTonemapGains_matchesLookupTonemapGain) {
+    const Dataspace dataspaces[] = {Dataspace::BT2020_ITU_PQ, Dataspace::BT2020_ITU_HLG,
+                                    Dataspace::DISPLAY_P3};
+    for (const auto sourceDataspace : dataspaces) {
+        for (const auto destinationDataspace : dataspaces) {
+            for (const float displayMaxLuminance : {100.f, 500.f, 1000.f}) {
+                for (const float currentDisplayLuminance : {50.f, 1500.f}) {
+                    expectGainsMatch(sourceDataspace, destinationDataspace,
+                                     {.displayMaxLuminance = displayMaxLuminance,
+                                      .contentMaxLuminance = 4000.f,
+                                      .currentDisplayLuminance = currentDisplayLuminance});
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TonemapTest, lookupTonemapGains_tracksMetadataChanges) {
+    // Cycle through more metadata than there are cached tables, so that tables are evicted and
+    // built again.
+    for (int i = 0; i < 3; i++) {
+        for (const float displayMaxLuminance : {100.f, 200.f, 300.f, 400.f, 500.f, 600.f}) {
+            expectGainsMatch(Dataspace::BT2020_ITU_PQ, Dataspace::DISPLAY_P3,
+                             {.displayMaxLuminance = displayMaxLuminance,
+                              .contentMaxLuminance = 4000.f,
+                              .currentDisplayLuminance = displayMaxLuminance});
+        }
+    }
+}
+
 } // namespace android
@@ -16,8 +16,14 @@
 
 #include <tonemap/tonemap.h>
 
+#include <log/log.h>
+
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 
@@ -41,11 +47,21 @@ static const constexpr auto kTransferHLG =
         static_cast<int32_t>(aidl::android::hardware::graphics::common::Dataspace::TRANSFER_HLG);
 
 template <typename T, std::enable_if_t<std::is_trivially_copyable<T>::value, bool> = true>
-std::vector<uint8_t> buildUniformValue(T value) {
-    std::vector<uint8_t> result;
-    result.resize(sizeof(value));
-    std::memcpy(result.data(), &value, sizeof(value));
-    return result;
+std::span<const uint8_t> uniformValue(const T& value) {
+    return {reinterpret_cast<const uint8_t*>(&value), sizeof(value)};
+}
+
+// Collects the uniforms written by ToneMapper::writeShaderSkSLUniforms() into a list.
+std::vector<ShaderUniform> collectShaderSkSLUniforms(ToneMapper& toneMapper,
+                                                     const Metadata& metadata) {
+    std::vector<ShaderUniform> uniforms;
+    toneMapper.writeShaderSkSLUniforms(metadata,
+                                       [&](std::string_view name, std::span<const uint8_t> value) {
+                                           uniforms.push_back({.name = std::string(name),
+                                                               .value = {value.begin(),
+                                                                         value.end()}});
+                                       });
+    return uniforms;
 }
 
 // Refer to BT2100-2
@@ -64,6 +80,171 @@ float computeHlgGamma(float currentDisplayBrightnessNits) {
     return 1.2 + 0.42 * std::log10(currentDisplayBrightnessNits / 1000);
 }
 
+// Table of a tonemapping curve, which maps a luminance in nits to its gain.
+//
+// The tonemappers below compute the gain of a color from a single luminance value, which is
+// max(R, G, B) or Y depending on the algorithm, so the table is indexed by that value. Entries are
+// spaced evenly within each power of two, which resolves the curve as finely in the shadows as in
+// the highlights. The entry for a luminance and the position between it and the next entry then
+// come straight from the bits of its float representation, without any transcendental math.
+class TonemapGainLut {
+public:
+    TonemapGainLut(ToneMapper* toneMapper,
+                   aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
+                   aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
+                   const Metadata& metadata)
+          : mToneMapper(toneMapper),
+            mSourceDataspace(sourceDataspace),
+            mDestinationDataspace(destinationDataspace),
+            mMetadata(metadata) {
+        // The buffer is not used for the gain and may not outlive this call.
+        mMetadata.buffer = nullptr;
+
+        // Sample the reference implementation with grays, whose max(R, G, B) and Y are both the
+        // luminance of the entry.
+        std::vector<Color> samples(kEntryCount);
+        for (size_t i = 0; i < kEntryCount; i++) {
+            const float nits = std::ldexp(1.f + static_cast<float>(i % kEntriesPerOctave) /
+                                                  kEntriesPerOctave,
+                                          kMinExponent + static_cast<int>(i / kEntriesPerOctave));
+            samples[i] = {.linearRGB = vec3(nits), .xyz = vec3(nits)};
+        }
+        const auto gains = mToneMapper->lookupTonemapGain(mSourceDataspace, mDestinationDataspace,
+                                                          samples, mMetadata);
+        std::transform(gains.cbegin(), gains.cend(), mGains.begin(),
+                       [](ToneMapper::Gain gain) { return static_cast<float>(gain); });
+    }
+
+    // Writes the gain of each color into gains, where luminance(color) returns the luminance the
+    // tonemapping curve is indexed by.
+    template <typename Luminance>
+    void lookup(std::span<const Color> colors, std::span<float> gains, Luminance luminance) const {
+        LOG_ALWAYS_FATAL_IF(gains.size() < colors.size(), "Expected at least %zu gains, got %zu",
+                            colors.size(), gains.size());
+
+        // The loop is free of branches so that it can be vectorized. Luminances outside of the
+        // table are rare, so their gains are computed exactly in a second pass.
+        bool outOfRange = false;
+        for (size_t i = 0; i < colors.size(); i++) {
+            const float nits = luminance(colors[i]);
+            uint32_t bits;
+            std::memcpy(&bits, &nits, sizeof(bits));
+            // Zero, negative and non-finite luminances wrap around to offsets past the table.
+            const uint32_t offset = bits - kMinBits;
+            const bool inTable = offset < kTableBits;
+            const uint32_t index = inTable ? offset >> kFractionBits : 0;
+            const float t = static_cast<float>(offset & kFractionMask) * kFractionScale;
+            const float gain = mGains[index] + t * (mGains[index + 1] - mGains[index]);
+            gains[i] = inTable ? gain : 1.f;
+            outOfRange |= !inTable && nits > 0.f;
+        }
+        if (!outOfRange) {
+            return;
+        }
+
+        std::vector<size_t> indices;
+        std::vector<Color> outOfRangeColors;
+        for (size_t i = 0; i < colors.size(); i++) {
+            const float nits = luminance(colors[i]);
+            if (nits >= kMaxNits || (nits > 0.f && nits < kMinNits)) {
+                indices.push_back(i);
+                outOfRangeColors.push_back(colors[i]);
+            }
+        }
+        const auto exactGains = mToneMapper->lookupTonemapGain(mSourceDataspace,
+                                                               mDestinationDataspace,
+                                                               outOfRangeColors, mMetadata);
+        for (size_t i = 0; i < indices.size(); i++) {
+            gains[indices[i]] = static_cast<float>(exactGains[i]);
+        }
+    }
+
+private:
+    // The table covers luminances in [2^kMinExponent, 2^kMaxExponent) nits, which is well past
+    // both the darkest and brightest luminances of any HDR standard.
+    static constexpr int kMinExponent = -20;
+    static constexpr int kMaxExponent = 16;
+    static constexpr float kMinNits = 1.f / (1 << -kMinExponent);
+    static constexpr float kMaxNits = 1 << kMaxExponent;
+    static constexpr int kEntriesPerOctaveBits = 7;
+    static constexpr size_t kEntriesPerOctave = 1 << kEntriesPerOctaveBits;
+    static constexpr size_t kEntryCount =
+            ((kMaxExponent - kMinExponent) << kEntriesPerOctaveBits) + 1;
+
+    // The float representation of a luminance, offset by that of 2^kMinExponent, holds the index
+    // of its entry above kFractionBits and the position towards the next entry below.
+    static constexpr int kMantissaBits = 23;
+    static constexpr int kFractionBits = kMantissaBits - kEntriesPerOctaveBits;
+    static constexpr uint32_t kFractionMask = (1u << kFractionBits) - 1;
+    static constexpr float kFractionScale = 1.f / (1 << kFractionBits);
+    static constexpr uint32_t kMinBits = static_cast<uint32_t>(127 + kMinExponent) << kMantissaBits;
+    static constexpr uint32_t kTableBits = static_cast<uint32_t>(kMaxExponent - kMinExponent)
+            << kMantissaBits;
+
+    ToneMapper* const mToneMapper;
+    const aidl::android::hardware::graphics::common::Dataspace mSourceDataspace;
+    const aidl::android::hardware::graphics::common::Dataspace mDestinationDataspace;
+    Metadata mMetadata;
+    std::array<float, kEntryCount> mGains;
+};
+
+// Caches the gain tables of the most recently used transfer functions and metadata.
+class TonemapGainLutCache {
+public:
+    std::shared_ptr<const TonemapGainLut> get(
+            ToneMapper* toneMapper,
+            aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
+            aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
+            const Metadata& metadata) {
+        // Only the transfer functions and luminances determine the tonemapping curve.
+        const Key key{.sourceTransfer = static_cast<int32_t>(sourceDataspace) & kTransferMask,
+                      .destinationTransfer =
+                              static_cast<int32_t>(destinationDataspace) & kTransferMask,
+                      .displayMaxLuminance = metadata.displayMaxLuminance,
+                      .contentMaxLuminance = metadata.contentMaxLuminance,
+                      .currentDisplayLuminance = metadata.currentDisplayLuminance};
+
+        std::lock_guard lock(mMutex);
+        auto it = std::find_if(mEntries.begin(), mEntries.end(),
+                               [&](const auto& entry) { return entry.first == key; });
+        if (it != mEntries.end()) {
+            // Move the table to the front, so that the least recently used table is evicted.
+            std::rotate(mEntries.begin(), it, it + 1);
+            return mEntries.front().second;
+        }
+
+        if (mEntries.size() == kMaxEntries) {
+            mEntries.pop_back();
+        }
+        mEntries.emplace(mEntries.begin(), key,
+                         std::make_shared<const TonemapGainLut>(toneMapper, sourceDataspace,
+                                                                destinationDataspace, metadata));
+        return mEntries.front().second;
+    }
+
+private:
+    static constexpr size_t kMaxEntries = 4;
+
+    struct Key {
+        int32_t sourceTransfer;
+        int32_t destinationTransfer;
+        float displayMaxLuminance;
+        float contentMaxLuminance;
+        float currentDisplayLuminance;
+
+        bool operator==(const Key& other) const {
+            return sourceTransfer == other.sourceTransfer &&
+                    destinationTransfer == other.destinationTransfer &&
+                    displayMaxLuminance == other.displayMaxLuminance &&
+                    contentMaxLuminance == other.contentMaxLuminance &&
+                    currentDisplayLuminance == other.currentDisplayLuminance;
+        }
+    };
+
+    std::mutex mMutex;
+    std::vector<std::pair<Key, std::shared_ptr<const TonemapGainLut>>> mEntries;
+};
+
 class ToneMapperO : public ToneMapper {
 public:
     std::string generateTonemapGainShaderSkSL(
@@ -274,15 +455,15 @@ public:
     }
 
     std::vector<ShaderUniform> generateShaderSkSLUniforms(const Metadata& metadata) override {
-        std::vector<ShaderUniform> uniforms;
-
-        uniforms.reserve(2);
+        return collectShaderSkSLUniforms(*this, metadata);
+    }
 
-        uniforms.push_back({.name = "in_libtonemap_displayMaxLuminance",
-                            .value = buildUniformValue<float>(metadata.displayMaxLuminance)});
-        uniforms.push_back({.name = "in_libtonemap_inputMaxLuminance",
-                            .value = buildUniformValue<float>(metadata.contentMaxLuminance)});
-        return uniforms;
+    void writeShaderSkSLUniforms(const Metadata& metadata,
+                                 const UniformWriter& writeUniform) override {
+        writeUniform("in_libtonemap_displayMaxLuminance",
+                     uniformValue<float>(metadata.displayMaxLuminance));
+        writeUniform("in_libtonemap_inputMaxLuminance",
+                     uniformValue<float>(metadata.contentMaxLuminance));
     }
 
     std::vector<Gain> lookupTonemapGain(
@@ -432,6 +613,18 @@ public:
         }
         return gains;
     }
+
+    void lookupTonemapGains(
+            aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
+            aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
+            std::span<const Color> colors, const Metadata& metadata,
+            std::span<float> gains) override {
+        mGainLuts.get(this, sourceDataspace, destinationDataspace, metadata)
+                ->lookup(colors, gains, [](const Color& color) { return color.xyz.y; });
+    }
+
+private:
+    TonemapGainLutCache mGainLuts;
 };
 
 class ToneMapper13 : public ToneMapper {
@@ -457,6 +650,8 @@ private:
         return nits <= 1.0 / 12.0 ? std::sqrt(3.0 * nits) : a * std::log(12.0 * nits - b) + c;
     }
 
+    TonemapGainLutCache mGainLuts;
+
 public:
     std::string generateTonemapGainShaderSkSL(
             aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
@@ -612,18 +807,18 @@ public:
     }
 
     std::vector<ShaderUniform> generateShaderSkSLUniforms(const Metadata& metadata) override {
+        return collectShaderSkSLUniforms(*this, metadata);
+    }
+
+    void writeShaderSkSLUniforms(const Metadata& metadata,
+                                 const UniformWriter& writeUniform) override {
         // Hardcode the max content luminance to a "reasonable" level
         static const constexpr float kContentMaxLuminance = 4000.f;
-        std::vector<ShaderUniform> uniforms;
-        uniforms.reserve(3);
-        uniforms.push_back({.name = "in_libtonemap_displayMaxLuminance",
-                            .value = buildUniformValue<float>(metadata.displayMaxLuminance)});
-        uniforms.push_back({.name = "in_libtonemap_inputMaxLuminance",
-                            .value = buildUniformValue<float>(kContentMaxLuminance)});
-        uniforms.push_back({.name = "in_libtonemap_hlgGamma",
-                            .value = buildUniformValue<float>(
-                                    computeHlgGamma(metadata.currentDisplayLuminance))});
-        return uniforms;
+        const float hlgGamma = computeHlgGamma(metadata.currentDisplayLuminance);
+        writeUniform("in_libtonemap_displayMaxLuminance",
+                     uniformValue<float>(metadata.displayMaxLuminance));
+        writeUniform("in_libtonemap_inputMaxLuminance", uniformValue<float>(kContentMaxLuminance));
+        writeUniform("in_libtonemap_hlgGamma", uniformValue<float>(hlgGamma));
     }
 
     std::vector<Gain> lookupTonemapGain(
@@ -726,6 +921,17 @@ public:
         }
         return gains;
     }
+
+    void lookupTonemapGains(
+            aidl::android::hardware::graphics::common::Dataspace sourceDataspace,
+            aidl::android::hardware::graphics::common::Dataspace destinationDataspace,
+            std::span<const Color> colors, const Metadata& metadata,
+            std::span<float> gains) override {
+        mGainLuts.get(this, sourceDataspace, destinationDataspace, metadata)
+                ->lookup(colors, gains, [](const Color& color) {
+                    return std::max({color.linearRGB.r, color.linearRGB.g, color.linearRGB.b});
+                });
+    }
 };
 
 } // namespace
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <ultrahdr/gainmapmath.h>
@@ -772,4 +773,432 @@ uint64_t colorToRgbaF16(Color e_gamma) {
        | (((uint64_t) floatToHalf(1.0f)) << 48);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Row kernels
+//
+// Rows are processed in chunks of kRowChunkSize pixels, running each stage of the per-pixel math
+// over the whole chunk before starting the next one. The arithmetic stages (YUV to RGB, gamut
+// conversion, luminance, applying the gain) thereby become loops over contiguous floats that the
+// compiler vectorizes for the target (NEON, SSE, ...), while the table lookups and log2 of the
+// remaining stages stay in loops of their own. Every stage performs exactly the same operations as
+// the per-pixel helpers above, so the results are bit-identical.
+
+#define USE_SRGB_INVOETF_LUT 1
+#define USE_HLG_OETF_LUT 1
+#define USE_PQ_OETF_LUT 1
+#define USE_HLG_INVOETF_LUT 1
+#define USE_PQ_INVOETF_LUT 1
+#define USE_APPLY_GAIN_LUT 1
+
+namespace {
+
+constexpr size_t kRowChunkSize = 64;
+
+#if USE_SRGB_INVOETF_LUT
+constexpr ColorTransformFn kSrgbInvOetf = srgbInvOetfLUT;
+#else
+constexpr ColorTransformFn kSrgbInvOetf = srgbInvOetf;
+#endif
+#if USE_HLG_INVOETF_LUT
+constexpr ColorTransformFn kHlgInvOetf = hlgInvOetfLUT;
+#else
+constexpr ColorTransformFn kHlgInvOetf = hlgInvOetf;
+#endif
+#if USE_PQ_INVOETF_LUT
+constexpr ColorTransformFn kPqInvOetf = pqInvOetfLUT;
+#else
+constexpr ColorTransformFn kPqInvOetf = pqInvOetf;
+#endif
+#if USE_HLG_OETF_LUT
+constexpr ColorTransformFn kHlgOetf = hlgOetfLUT;
+#else
+constexpr ColorTransformFn kHlgOetf = hlgOetf;
+#endif
+#if USE_PQ_OETF_LUT
+constexpr ColorTransformFn kPqOetf = pqOetfLUT;
+#else
+constexpr ColorTransformFn kPqOetf = pqOetf;
+#endif
+
+// Structure-of-arrays storage for the colors of one chunk.
+struct ColorChunk {
+  float r[kRowChunkSize];
+  float g[kRowChunkSize];
+  float b[kRowChunkSize];
+
+  Color get(size_t i) const { return {{{ r[i], g[i], b[i] }}}; }
+  void set(size_t i, Color e) {
+    r[i] = e.r;
+    g[i] = e.g;
+    b[i] = e.b;
+  }
+};
+
+template <ColorTransformFn fn>
+inline void transformChunk(ColorChunk& chunk, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    chunk.set(i, fn(chunk.get(i)));
+  }
+}
+
+// Same as getYuv420Pixel, given the rows of the planes that hold the pixel.
+inline Color yuv420PixelInRow(const uint8_t* luma_row, const uint8_t* u_row, const uint8_t* v_row,
+                              size_t x) {
+  return {{{ static_cast<float>(luma_row[x]) / 255.0f,
+             (static_cast<float>(u_row[x / 2]) - 128.0f) / 255.0f,
+             (static_cast<float>(v_row[x / 2]) - 128.0f) / 255.0f }}};
+}
+
+// Same as getP010Pixel, given the rows of the planes that hold the pixel.
+inline Color p010PixelInRow(const uint16_t* luma_row, const uint16_t* chroma_row, size_t x) {
+  uint16_t y_uint = luma_row[x] >> 6;
+  uint16_t u_uint = chroma_row[x & ~0x1] >> 6;
+  uint16_t v_uint = chroma_row[(x & ~0x1) + 1] >> 6;
+  return {{{ (static_cast<float>(y_uint) - 64.0f) / 876.0f,
+             (static_cast<float>(u_uint) - 64.0f) / 896.0f - 0.5f,
+             (static_cast<float>(v_uint) - 64.0f) / 896.0f - 0.5f }}};
+}
+
+// Same as sampleYuv420 with kMapDimensionScaleFactor, for count map pixels starting at map_x.
+void sampleYuv420Chunk(jr_uncompressed_ptr image, size_t map_x, size_t map_y, size_t count,
+                       ColorChunk& chunk) {
+  const uint8_t* luma_data = reinterpret_cast<uint8_t*>(image->data);
+  const uint8_t* chroma_data = reinterpret_cast<uint8_t*>(image->chroma_data);
+  const size_t luma_stride = image->luma_stride;
+  const size_t chroma_stride = image->chroma_stride;
+  const size_t offset_cr = chroma_stride * (image->height / 2);
+
+  const uint8_t* luma_rows[kMapDimensionScaleFactor];
+  const uint8_t* u_rows[kMapDimensionScaleFactor];
+  const uint8_t* v_rows[kMapDimensionScaleFactor];
+  for (size_t dy = 0; dy < kMapDimensionScaleFactor; ++dy) {
+    const size_t y = map_y * kMapDimensionScaleFactor + dy;
+    luma_rows[dy] = luma_data + y * luma_stride;
+    u_rows[dy] = chroma_data + (y / 2) * chroma_stride;
+    v_rows[dy] = u_rows[dy] + offset_cr;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    const size_t x = (map_x + i) * kMapDimensionScaleFactor;
+    Color e = {{{ 0.0f, 0.0f, 0.0f }}};
+    for (size_t dy = 0; dy < kMapDimensionScaleFactor; ++dy) {
+      for (size_t dx = 0; dx < kMapDimensionScaleFactor; ++dx) {
+        e += yuv420PixelInRow(luma_rows[dy], u_rows[dy], v_rows[dy], x + dx);
+      }
+    }
+    chunk.set(i, e / static_cast<float>(kMapDimensionScaleFactor * kMapDimensionScaleFactor));
+  }
+}
+
+// Same as sampleP010 with kMapDimensionScaleFactor, for count map pixels starting at map_x.
+void sampleP010Chunk(jr_uncompressed_ptr image, size_t map_x, size_t map_y, size_t count,
+                     ColorChunk& chunk) {
+  const uint16_t* luma_data = reinterpret_cast<uint16_t*>(image->data);
+  const uint16_t* chroma_data = reinterpret_cast<uint16_t*>(image->chroma_data);
+  const size_t luma_stride = image->luma_stride == 0 ? image->width : image->luma_stride;
+  const size_t chroma_stride = image->chroma_stride;
+
+  const uint16_t* luma_rows[kMapDimensionScaleFactor];
+  const uint16_t* chroma_rows[kMapDimensionScaleFactor];
+  for (size_t dy = 0; dy < kMapDimensionScaleFactor; ++dy) {
+    const size_t y = map_y * kMapDimensionScaleFactor + dy;
+    luma_rows[dy] = luma_data + y * luma_stride;
+    chroma_rows[dy] = chroma_data + (y >> 1) * chroma_stride;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    const size_t x = (map_x + i) * kMapDimensionScaleFactor;
+    Color e = {{{ 0.0f, 0.0f, 0.0f }}};
+    for (size_t dy = 0; dy < kMapDimensionScaleFactor; ++dy) {
+      for (size_t dx = 0; dx < kMapDimensionScaleFactor; ++dx) {
+        e += p010PixelInRow(luma_rows[dy], chroma_rows[dy], x + dx);
+      }
+    }
+    chunk.set(i, e / static_cast<float>(kMapDimensionScaleFactor * kMapDimensionScaleFactor));
+  }
+}
+
+template <ColorTransformFn sdrYuvToRgbFn, ColorCalculationFn luminanceFn,
+          ColorTransformFn hdrYuvToRgbFn, ColorTransformFn hdrInvOetfFn,
+          ColorTransformFn hdrGamutConversionFn>
+void generateGainMapRow(const GainMapRowParams& params, size_t map_y, size_t map_x_begin,
+                        size_t map_x_end, uint8_t* dest) {
+  ColorChunk sdr;
+  ColorChunk hdr;
+  float sdr_y_nits[kRowChunkSize];
+  float hdr_y_nits[kRowChunkSize];
+
+  for (size_t map_x = map_x_begin; map_x < map_x_end; map_x += kRowChunkSize) {
+    const size_t count = std::min(kRowChunkSize, map_x_end - map_x);
+
+    sampleYuv420Chunk(params.sdr_yuv420_image, map_x, map_y, count, sdr);
+    transformChunk<sdrYuvToRgbFn>(sdr, count);
+    // We are assuming the SDR input is always sRGB transfer.
+    transformChunk<kSrgbInvOetf>(sdr, count);
+    for (size_t i = 0; i < count; ++i) {
+      sdr_y_nits[i] = luminanceFn(sdr.get(i)) * kSdrWhiteNits;
+    }
+
+    sampleP010Chunk(params.hdr_p010_image, map_x, map_y, count, hdr);
+    transformChunk<hdrYuvToRgbFn>(hdr, count);
+    transformChunk<hdrInvOetfFn>(hdr, count);
+    transformChunk<hdrGamutConversionFn>(hdr, count);
+    for (size_t i = 0; i < count; ++i) {
+      hdr_y_nits[i] = luminanceFn(hdr.get(i)) * params.hdr_white_nits;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      dest[map_x - map_x_begin + i] = encodeGain(sdr_y_nits[i], hdr_y_nits[i], params.metadata,
+                                                 params.log2_min_content_boost,
+                                                 params.log2_max_content_boost);
+    }
+  }
+}
+
+// The selectors below resolve one conversion at a time, in the same way as the switch statements
+// in JpegR::generateGainMap used to, until every template argument of generateGainMapRow is known.
+
+template <ColorTransformFn sdrYuvToRgbFn, ColorCalculationFn luminanceFn,
+          ColorTransformFn hdrYuvToRgbFn, ColorTransformFn hdrInvOetfFn>
+GenerateGainMapRowFn selectHdrGamutConversion(ultrahdr_color_gamut sdr_gamut,
+                                              ultrahdr_color_gamut hdr_gamut) {
+  // Mirrors getHdrConversionFn.
+  switch (sdr_gamut) {
+    case ULTRAHDR_COLORGAMUT_BT709:
+      switch (hdr_gamut) {
+        case ULTRAHDR_COLORGAMUT_BT709:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    identityConversion>;
+        case ULTRAHDR_COLORGAMUT_P3:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    p3ToBt709>;
+        case ULTRAHDR_COLORGAMUT_BT2100:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    bt2100ToBt709>;
+        case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+          return nullptr;
+      }
+      break;
+    case ULTRAHDR_COLORGAMUT_P3:
+      switch (hdr_gamut) {
+        case ULTRAHDR_COLORGAMUT_BT709:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    bt709ToP3>;
+        case ULTRAHDR_COLORGAMUT_P3:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    identityConversion>;
+        case ULTRAHDR_COLORGAMUT_BT2100:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    bt2100ToP3>;
+        case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+          return nullptr;
+      }
+      break;
+    case ULTRAHDR_COLORGAMUT_BT2100:
+      switch (hdr_gamut) {
+        case ULTRAHDR_COLORGAMUT_BT709:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    bt709ToBt2100>;
+        case ULTRAHDR_COLORGAMUT_P3:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    p3ToBt2100>;
+        case ULTRAHDR_COLORGAMUT_BT2100:
+          return generateGainMapRow<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, hdrInvOetfFn,
+                                    identityConversion>;
+        case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+          return nullptr;
+      }
+      break;
+    case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+template <ColorTransformFn sdrYuvToRgbFn, ColorCalculationFn luminanceFn,
+          ColorTransformFn hdrYuvToRgbFn>
+GenerateGainMapRowFn selectHdrInvOetf(ultrahdr_color_gamut sdr_gamut,
+                                      ultrahdr_color_gamut hdr_gamut,
+                                      ultrahdr_transfer_function hdr_tf) {
+  switch (hdr_tf) {
+    case ULTRAHDR_TF_LINEAR:
+      return selectHdrGamutConversion<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn,
+                                      identityConversion>(sdr_gamut, hdr_gamut);
+    case ULTRAHDR_TF_HLG:
+      return selectHdrGamutConversion<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, kHlgInvOetf>(
+              sdr_gamut, hdr_gamut);
+    case ULTRAHDR_TF_PQ:
+      return selectHdrGamutConversion<sdrYuvToRgbFn, luminanceFn, hdrYuvToRgbFn, kPqInvOetf>(
+              sdr_gamut, hdr_gamut);
+    default:
+      return nullptr;
+  }
+}
+
+template <ColorTransformFn sdrYuvToRgbFn, ColorCalculationFn luminanceFn>
+GenerateGainMapRowFn selectHdrYuvToRgb(ultrahdr_color_gamut sdr_gamut,
+                                       ultrahdr_color_gamut hdr_gamut,
+                                       ultrahdr_transfer_function hdr_tf) {
+  switch (hdr_gamut) {
+    case ULTRAHDR_COLORGAMUT_BT709:
+      return selectHdrInvOetf<sdrYuvToRgbFn, luminanceFn, srgbYuvToRgb>(sdr_gamut, hdr_gamut,
+                                                                         hdr_tf);
+    case ULTRAHDR_COLORGAMUT_P3:
+      return selectHdrInvOetf<sdrYuvToRgbFn, luminanceFn, p3YuvToRgb>(sdr_gamut, hdr_gamut,
+                                                                       hdr_tf);
+    case ULTRAHDR_COLORGAMUT_BT2100:
+      return selectHdrInvOetf<sdrYuvToRgbFn, luminanceFn, bt2100YuvToRgb>(sdr_gamut, hdr_gamut,
+                                                                           hdr_tf);
+    case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+template <ColorCalculationFn luminanceFn, ColorTransformFn sdrYuvToRgbFn>
+GenerateGainMapRowFn selectSdrYuvToRgb(ultrahdr_color_gamut sdr_gamut,
+                                       ultrahdr_color_gamut hdr_gamut,
+                                       ultrahdr_transfer_function hdr_tf, bool sdr_is_601) {
+  if (sdr_is_601) {
+    return selectHdrYuvToRgb<p3YuvToRgb, luminanceFn>(sdr_gamut, hdr_gamut, hdr_tf);
+  }
+  return selectHdrYuvToRgb<sdrYuvToRgbFn, luminanceFn>(sdr_gamut, hdr_gamut, hdr_tf);
+}
+
+// Same as sampleMap with kMapDimensionScaleFactor and a ShepardsIDW table, for every pixel of a
+// row of the image. The data of map starts at row first_row of the gain map.
+class GainMapRowSampler {
+public:
+  GainMapRowSampler(jr_uncompressed_ptr map, size_t first_row, ShepardsIDW& weight_tables,
+                    size_t y)
+        : mMapWidth(map->width), mWeightTables(weight_tables) {
+    int y_lower = y / kMapDimensionScaleFactor;
+    int y_upper = y_lower + 1;
+    y_lower = std::min(y_lower, map->height - 1);
+    y_upper = std::min(y_upper, map->height - 1);
+
+    const uint8_t* map_data = reinterpret_cast<uint8_t*>(map->data);
+    mLowerRow = map_data + (y_lower - first_row) * map->width;
+    mUpperRow = map_data + (y_upper - first_row) * map->width;
+    mHasBottom = y_lower != y_upper;
+    mWeightsOffsetY = (y % kMapDimensionScaleFactor) * kMapDimensionScaleFactor * 4;
+  }
+
+  float sample(size_t x) const {
+    int x_lower = x / kMapDimensionScaleFactor;
+    int x_upper = x_lower + 1;
+    x_lower = std::min(x_lower, mMapWidth - 1);
+    x_upper = std::min(x_upper, mMapWidth - 1);
+
+    float e1 = mapUintToFloat(mLowerRow[x_lower]);
+    float e2 = mapUintToFloat(mUpperRow[x_lower]);
+    float e3 = mapUintToFloat(mLowerRow[x_upper]);
+    float e4 = mapUintToFloat(mUpperRow[x_upper]);
+
+    const bool hasRight = x_lower != x_upper;
+    const float* weights = mWeightTables.mWeights;
+    if (!hasRight && !mHasBottom) weights = mWeightTables.mWeightsC;
+    else if (!hasRight) weights = mWeightTables.mWeightsNR;
+    else if (!mHasBottom) weights = mWeightTables.mWeightsNB;
+    weights += mWeightsOffsetY + (x % kMapDimensionScaleFactor) * 4;
+
+    return e1 * weights[0] + e2 * weights[1] + e3 * weights[2] + e4 * weights[3];
+  }
+
+private:
+  const int mMapWidth;
+  const ShepardsIDW& mWeightTables;
+  const uint8_t* mLowerRow;
+  const uint8_t* mUpperRow;
+  bool mHasBottom;
+  size_t mWeightsOffsetY;
+};
+
+template <ultrahdr_output_format output_format>
+void applyGainMapRow(const ApplyGainMapRowParams& params, size_t y, size_t x_begin, size_t x_end,
+                     void* dest) {
+  jr_uncompressed_ptr image = params.sdr_yuv420_image;
+  const size_t sdr_y = y - params.sdr_first_row;
+  const uint8_t* luma_row = reinterpret_cast<uint8_t*>(image->data) + sdr_y * image->luma_stride;
+  const uint8_t* u_row =
+          reinterpret_cast<uint8_t*>(image->chroma_data) + (sdr_y / 2) * image->chroma_stride;
+  const uint8_t* v_row = u_row + image->chroma_stride * (image->height / 2);
+  const GainMapRowSampler map_sampler(params.gainmap_image, params.gainmap_first_row,
+                                      *params.idw_table, y);
+
+  ColorChunk rgb;
+  float gain[kRowChunkSize];
+
+  for (size_t x = x_begin; x < x_end; x += kRowChunkSize) {
+    const size_t count = std::min(kRowChunkSize, x_end - x);
+
+    for (size_t i = 0; i < count; ++i) {
+      rgb.set(i, yuv420PixelInRow(luma_row, u_row, v_row, x + i));
+    }
+    // Assuming the sdr image is a decoded JPEG, we should always use Rec.601 YUV coefficients
+    transformChunk<p3YuvToRgb>(rgb, count);
+    // We are assuming the SDR base image is always sRGB transfer.
+    transformChunk<kSrgbInvOetf>(rgb, count);
+
+    for (size_t i = 0; i < count; ++i) {
+      gain[i] = map_sampler.sample(x + i);
+    }
+    for (size_t i = 0; i < count; ++i) {
+#if USE_APPLY_GAIN_LUT
+      Color rgb_hdr = applyGainLUT(rgb.get(i), gain[i], *params.gain_lut);
+#else
+      Color rgb_hdr = applyGain(rgb.get(i), gain[i], params.metadata, params.display_boost);
+#endif
+      rgb.set(i, rgb_hdr / params.display_boost);
+    }
+
+    if constexpr (output_format == ULTRAHDR_OUTPUT_HDR_LINEAR) {
+      uint64_t* out = reinterpret_cast<uint64_t*>(dest) + (x - x_begin);
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = colorToRgbaF16(rgb.get(i));
+      }
+    } else {
+      transformChunk<output_format == ULTRAHDR_OUTPUT_HDR_HLG ? kHlgOetf : kPqOetf>(rgb, count);
+      uint32_t* out = reinterpret_cast<uint32_t*>(dest) + (x - x_begin);
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = colorToRgba1010102(rgb.get(i));
+      }
+    }
+  }
+}
+
+} // namespace
+
+GenerateGainMapRowFn getGenerateGainMapRowFn(ultrahdr_color_gamut sdr_gamut,
+                                             ultrahdr_color_gamut hdr_gamut,
+                                             ultrahdr_transfer_function hdr_tf, bool sdr_is_601) {
+  switch (sdr_gamut) {
+    case ULTRAHDR_COLORGAMUT_BT709:
+      return selectSdrYuvToRgb<srgbLuminance, srgbYuvToRgb>(sdr_gamut, hdr_gamut, hdr_tf,
+                                                            sdr_is_601);
+    case ULTRAHDR_COLORGAMUT_P3:
+      return selectSdrYuvToRgb<p3Luminance, p3YuvToRgb>(sdr_gamut, hdr_gamut, hdr_tf,
+                                                        sdr_is_601);
+    case ULTRAHDR_COLORGAMUT_BT2100:
+      return selectSdrYuvToRgb<bt2100Luminance, bt2100YuvToRgb>(sdr_gamut, hdr_gamut, hdr_tf,
+                                                                sdr_is_601);
+    case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+ApplyGainMapRowFn getApplyGainMapRowFn(ultrahdr_output_format output_format) {
+  switch (output_format) {
+    case ULTRAHDR_OUTPUT_HDR_LINEAR:
+      return applyGainMapRow<ULTRAHDR_OUTPUT_HDR_LINEAR>;
+    case ULTRAHDR_OUTPUT_HDR_HLG:
+      return applyGainMapRow<ULTRAHDR_OUTPUT_HDR_HLG>;
+    case ULTRAHDR_OUTPUT_HDR_PQ:
+      return applyGainMapRow<ULTRAHDR_OUTPUT_HDR_PQ>;
+    default:
+      return nullptr;
+  }
+}
+
 } // namespace android::ultrahdr
@@ -500,6 +500,91 @@ uint32_t colorToRgba1010102(Color e_gamma);
  */
 uint64_t colorToRgbaF16(Color e_gamma);
 
+////////////////////////////////////////////////////////////////////////////////
+// Row kernels
+//
+// Each row kernel processes the columns [x_begin, x_end) of one row, and writes them to a
+// destination pointer which points at the value of column x_begin, not at the start of the row.
+// This lets callers write a tile or a cropped region straight into a buffer that only holds those
+// columns.
+
+/*
+ * Inputs for generating a gain map from an SDR YUV 420 image and an HDR P010 image of the same
+ * dimensions.
+ */
+struct GainMapRowParams {
+  jr_uncompressed_ptr sdr_yuv420_image;
+  jr_uncompressed_ptr hdr_p010_image;
+  ultrahdr_metadata_ptr metadata;
+  float hdr_white_nits;
+  float log2_min_content_boost;
+  float log2_max_content_boost;
+};
+
+/*
+ * Writes the gain values of columns [map_x_begin, map_x_end) of row map_y of the gain map to dest,
+ * which points at the value of column map_x_begin.
+ *
+ * Each value is identical to sampling both images with sampleYuv420 and sampleP010, converting the
+ * samples to linear luminance and encoding the result with encodeGain.
+ */
+typedef void (*GenerateGainMapRowFn)(const GainMapRowParams& params, size_t map_y,
+                                     size_t map_x_begin, size_t map_x_end, uint8_t* dest);
+
+/*
+ * Get the gain map row kernel for the given combination of SDR gamut, HDR gamut and HDR transfer
+ * function. The color conversions are resolved at compile time for every combination, so none of
+ * them are called through a function pointer per pixel.
+ *
+ * sdr_is_601 selects Rec.601 YUV coefficients for the SDR image regardless of its gamut.
+ *
+ * Returns nullptr for unspecified gamuts or unknown transfer functions.
+ */
+GenerateGainMapRowFn getGenerateGainMapRowFn(ultrahdr_color_gamut sdr_gamut,
+                                             ultrahdr_color_gamut hdr_gamut,
+                                             ultrahdr_transfer_function hdr_tf, bool sdr_is_601);
+
+/*
+ * Inputs for applying a gain map to an SDR YUV 420 image. The gain map must be
+ * kMapDimensionScaleFactor times smaller than the image in both dimensions.
+ *
+ * Either image may only hold a band of rows, so that large images can be processed without
+ * holding all of them in memory:
+ * - sdr_yuv420_image holds rows [sdr_first_row, sdr_first_row + height) of the image, with
+ *   sdr_first_row even.
+ * - The data of gainmap_image starts at row gainmap_first_row of the gain map, while its height is
+ *   the height of the whole gain map. The band must include the rows that the requested image rows
+ *   are interpolated from.
+ */
+struct ApplyGainMapRowParams {
+  jr_uncompressed_ptr sdr_yuv420_image;
+  jr_uncompressed_ptr gainmap_image;
+  ultrahdr_metadata_ptr metadata;
+  ShepardsIDW* idw_table;
+  GainLUT* gain_lut;
+  float display_boost;
+  size_t sdr_first_row = 0;
+  size_t gainmap_first_row = 0;
+};
+
+/*
+ * Writes the pixels of columns [x_begin, x_end) of row y of the HDR output image to dest, which
+ * points at the pixel of column x_begin. Pixels are stored in the output format the kernel was
+ * created for.
+ *
+ * Each pixel is identical to reading the SDR image with getYuv420Pixel, linearizing it, sampling
+ * the gain map with sampleMap and applying the gain with applyGainLUT.
+ */
+typedef void (*ApplyGainMapRowFn)(const ApplyGainMapRowParams& params, size_t y, size_t x_begin,
+                                  size_t x_end, void* dest);
+
+/*
+ * Get the gain map application row kernel for the given output format.
+ *
+ * Returns nullptr for output formats that are not HDR.
+ */
+ApplyGainMapRowFn getApplyGainMapRowFn(ultrahdr_output_format output_format);
+
 } // namespace android::ultrahdr
 
 #endif // ANDROID_ULTRAHDR_RECOVERYMAPMATH_H
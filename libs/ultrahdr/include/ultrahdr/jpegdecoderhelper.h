@@ -24,6 +24,7 @@ extern "C" {
 #include <jpeglib.h>
 }
 #include <utils/Errors.h>
+#include <memory>
 #include <vector>
 
 // constraint on max width and max height is only due to device alloc constraints
@@ -112,8 +113,54 @@ public:
                                       size_t* pHeight, std::vector<uint8_t>* iccData,
                                       std::vector<uint8_t>* exifData);
 
+    /*
+     * Starts decompressing the image incrementally, one batch of rows at a time, so that only the
+     * current batch is held in memory. The output format is the same as for decompressImage(),
+     * except that rows are delivered by decompressNextRows().
+     *
+     * The image is scaled down by 1/scaleDenom while decoding; scaleDenom must be 1, 2, 4 or 8.
+     * Scaled YUV images are still delivered in 4:2:0 layout.
+     *
+     * After this returns true, getDecompressedImageWidth() and getDecompressedImageHeight() return
+     * the scaled dimensions and the XMP, EXIF and ICC accessors are valid.
+     * Returns false if the image can not be decoded.
+     */
+    bool startDecompressRows(const void* image, int length, bool decodeToRGBA = false,
+                             int scaleDenom = 1);
+    /*
+     * Decompresses the next batch of rows. Returns the number of image rows in the batch, 0 once
+     * all rows have been decompressed and -1 if an error occurs.
+     */
+    int decompressNextRows();
+    /*
+     * Returns the index of the first image row of the current batch.
+     */
+    size_t getRowsTop();
+    /*
+     * Returns the number of rows that the buffer of every batch holds. The last batch may
+     * contain fewer image rows.
+     */
+    size_t getRowsCapacity();
+    /*
+     * Returns the first row of the given plane (0: Y, grey or RGBA, 1: U, 2: V) of the current
+     * batch, and the distance in bytes between rows of that plane. The V plane follows the U plane
+     * with the same stride, i.e. at getRowsPtr(1) + getRowsStride(1) * getRowsCapacity() / 2.
+     */
+    uint8_t* getRowsPtr(int plane);
+    size_t getRowsStride(int plane);
+    /*
+     * Stops incremental decompression, whether or not all rows have been decompressed, and
+     * releases the batch buffer.
+     */
+    void finishDecompressRows();
+
 private:
+    struct RowDecoder;
+
     bool decode(const void* image, int length, bool decodeToRGBA);
+    // Saves the first XMP, EXIF and ICC packages of the image.
+    void saveMetadata(jpeg_decompress_struct* cinfo);
+    bool readRowBatch();
     // Returns false if errors occur.
     bool decompress(jpeg_decompress_struct* cinfo, const uint8_t* dest, bool isSingleChannel);
     bool decompressYUV(jpeg_decompress_struct* cinfo, const uint8_t* dest);
@@ -137,6 +184,10 @@ private:
 
     // Position of EXIF package, default value is -1 which means no EXIF package appears.
     ssize_t mExifPos = -1;
+
+    // State of incremental decompression, between startDecompressRows() and
+    // finishDecompressRows().
+    std::unique_ptr<RowDecoder> mRowDecoder;
 };
 } /* namespace android::ultrahdr  */
 
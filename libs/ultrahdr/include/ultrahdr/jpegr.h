@@ -114,10 +114,21 @@ struct jpegr_exif_struct {
     int length;
 };
 
+/*
+ * Holds a rectangular region [left, right) x [top, bottom) of an image, in pixels.
+ */
+struct jpegr_region_struct {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
 typedef struct jpegr_uncompressed_struct* jr_uncompressed_ptr;
 typedef struct jpegr_compressed_struct* jr_compressed_ptr;
 typedef struct jpegr_exif_struct* jr_exif_ptr;
 typedef struct jpegr_info_struct* jr_info_ptr;
+typedef struct jpegr_region_struct* jr_region_ptr;
 
 class JpegR {
 public:
@@ -281,6 +292,35 @@ public:
                          jr_uncompressed_ptr gainmap_image_ptr = nullptr,
                          ultrahdr_metadata_ptr metadata = nullptr);
 
+    /*
+     * Decode API, streaming
+     * Decompress JPEGR image, or a region of it, band by band.
+     *
+     * Produces the same output as decodeJPEGR(), but the primary image and the gain map are
+     * decompressed a few MCU rows at a time and the gain map is applied to every band as soon as
+     * it is decompressed, so memory use is bounded by the image width instead of its area. Rows
+     * below the region are not decompressed at all.
+     *
+     * The same assumptions as for decodeJPEGR() apply to the JPEGR image.
+     * @param jpegr_image_ptr compressed JPEGR image.
+     * @param dest destination of the uncompressed JPEGR image. It must be large enough to hold the
+     *             region in the output color format of decodeJPEGR(); rows are packed without
+     *             padding. On success, width and height are set to the size of the region.
+     * @param max_display_boost (optional) the maximum available boost supported by a display,
+     *                          the value must be greater than or equal to 1.0.
+     * @param output_format flag for setting output color format, see decodeJPEGR().
+     * @param scale_denom (optional) the image is scaled down by 1 / scale_denom while it is
+     *                    decompressed, which is much cheaper than decompressing and then scaling
+     *                    it. Must be 1, 2, 4 or 8.
+     * @param region (optional) region of the scaled image to decompress. The default value is NULL
+     *               which decompresses the whole image.
+     * @return NO_ERROR if decoding succeeds, error code if error occurs.
+     */
+    status_t decodeJPEGRStreaming(jr_compressed_ptr jpegr_image_ptr, jr_uncompressed_ptr dest,
+                                  float max_display_boost = FLT_MAX,
+                                  ultrahdr_output_format output_format = ULTRAHDR_OUTPUT_HDR_LINEAR,
+                                  int scale_denom = 1, jr_region_ptr region = nullptr);
+
     /*
      * Gets Info from JPEGR file without decoding it.
      *
@@ -295,6 +335,17 @@ public:
      */
     status_t getJPEGRInfo(jr_compressed_ptr jpegr_image_ptr, jr_info_ptr jpeg_image_info_ptr);
 
+    /*
+     * Limits the number of threads used by this instance to generate and apply gain maps.
+     *
+     * The work runs on a thread pool shared by all instances and the calling thread, which is
+     * sized to the number of CPU cores.
+     *
+     * @param count maximum number of threads including the calling thread, 1 runs everything on
+     *              the calling thread. 0 (the default) uses every thread of the pool.
+     */
+    void setMaxThreadCount(int count);
+
 protected:
     /*
      * This method is called in the encoding pipeline. It will take the uncompressed 8-bit and
@@ -446,6 +497,9 @@ private:
                                     jr_uncompressed_ptr yuv420_image_ptr,
                                     ultrahdr_transfer_function hdr_tf, jr_compressed_ptr dest,
                                     int quality);
+
+    // Maximum number of threads for gain map generation and application, 0 for no limit.
+    size_t mMaxThreadCount = 0;
 };
 } // namespace android::ultrahdr
 
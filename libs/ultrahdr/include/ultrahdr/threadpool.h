@@ -0,0 +1,108 @@
+/*
+ * Copyright 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_ULTRAHDR_THREADPOOL_H
+#define ANDROID_ULTRAHDR_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace android::ultrahdr {
+
+/*
+ * Returns the number of online CPU cores, or 1 if multithreading is disabled.
+ */
+int GetCPUCoreCount();
+
+/*
+ * A rectangular region [left, right) x [top, bottom) of the area passed to
+ * ThreadPool::forEachTile().
+ */
+struct Tile {
+  size_t left;
+  size_t top;
+  size_t right;
+  size_t bottom;
+};
+
+/*
+ * A pool of worker threads that is created once and reused by every JpegR call, so encoding or
+ * decoding a burst of images does not pay for thread creation each time.
+ *
+ * Work is submitted as a 2D area split into tiles. Every participating thread starts with a
+ * contiguous share of the tiles and, once its share is exhausted, steals half of the remaining
+ * tiles of the busiest other participant. The calling thread always participates, so a call makes
+ * progress even when all workers are busy with other calls, and calls may be nested.
+ *
+ * This class is thread-safe.
+ */
+class ThreadPool {
+public:
+  /*
+   * Creates a pool with the given number of worker threads. Callers participate in their own
+   * calls, so a pool with n workers runs up to n + 1 tiles at a time.
+   */
+  explicit ThreadPool(size_t workerCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /*
+   * Returns the pool shared by all JpegR instances. It is created on first use with one worker
+   * per CPU core besides the calling thread.
+   */
+  static ThreadPool& getInstance();
+
+  /*
+   * Returns the maximum number of threads that can run the tiles of one call, including the
+   * calling thread.
+   */
+  size_t getMaxParallelism() const { return mWorkers.size() + 1; }
+
+  /*
+   * Splits [0, width) x [0, height) into tiles of at most tileWidth x tileHeight and calls fn
+   * once for every tile. Tiles are ordered row by row, so every thread starts in its own band of
+   * the area. Returns once all tiles have been processed.
+   *
+   * @param maxParallelism upper bound on the number of threads used for this call, including the
+   *                       calling thread. 0 uses as many as the pool has.
+   */
+  void forEachTile(size_t width, size_t height, size_t tileWidth, size_t tileHeight,
+                   const std::function<void(const Tile&)>& fn, size_t maxParallelism = 0);
+
+private:
+  struct Batch;
+
+  void workerLoop();
+  static void runTiles(Batch& batch, size_t slot);
+
+  std::mutex mMutex;
+  std::condition_variable mCv;
+  std::deque<std::shared_ptr<Batch>> mBatches;
+  bool mExiting = false;
+  std::vector<std::thread> mWorkers;
+};
+
+} // namespace android::ultrahdr
+
+#endif // ANDROID_ULTRAHDR_THREADPOOL_H
@@ -20,6 +20,7 @@
 
 #include <errno.h>
 #include <setjmp.h>
+#include <algorithm>
 #include <string>
 
 using namespace std;
@@ -97,6 +98,49 @@ static void jpegrerror_exit(j_common_ptr cinfo) {
     longjmp(err->setjmp_buffer, 1);
 }
 
+#if JPEG_LIB_VERSION >= 70
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_h_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_v_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_v_scaled_size)
+#else
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_scaled_size)
+#endif
+
+// State of an incremental decompression. Rows are decompressed into a buffer that holds one batch
+// of `capacity` rows at a time: the Y (or grey, or RGBA) plane, followed by the U and V planes at
+// half resolution in both dimensions.
+struct JpegDecoderHelper::RowDecoder {
+    RowDecoder(const uint8_t* ptr, int len) : cinfo{}, mgr(ptr, len) {}
+    ~RowDecoder() { jpeg_destroy_decompress(&cinfo); }
+
+    jpeg_decompress_struct cinfo;
+    jpegrerror_mgr err;
+    jpegr_source_mgr mgr;
+
+    bool isRGBA = false;
+    int componentCount = 1;
+    // Number of rows of every batch, a multiple of linesPerIMcu.
+    size_t capacity = 0;
+    // Number of image rows that jpeg_read_raw_data() returns per call.
+    size_t linesPerIMcu = 0;
+    // Index of the first image row and number of image rows of the current batch.
+    size_t rowsTop = 0;
+    size_t rowsCount = 0;
+
+    std::unique_ptr<uint8_t[]> buffer;
+    uint8_t* planes[3] = {};
+    size_t strides[3] = {};
+
+    // Rows that jpeg_read_raw_data() writes for every component. When libjpeg scales the chroma
+    // components to the resolution of the luma component, which it may do when scaling the image
+    // down, they point into rawChroma and the chroma rows are subsampled into the batch buffer.
+    std::vector<JSAMPROW> rows[3];
+    std::unique_ptr<uint8_t[]> rawChroma;
+    size_t rawChromaStride = 0;
+};
+
 JpegDecoderHelper::JpegDecoderHelper() {}
 
 JpegDecoderHelper::~JpegDecoderHelper() {}
@@ -227,45 +271,7 @@ bool JpegDecoderHelper::decode(const void* image, int length, bool decodeToRGBA)
         return false;
     }
 
-    // Save XMP data, EXIF data, and ICC data.
-    // Here we only handle the first XMP / EXIF / ICC package.
-    // We assume that all packages are starting with two bytes marker (eg FF E1 for EXIF package),
-    // two bytes of package length which is stored in marker->original_length, and the real data
-    // which is stored in marker->data.
-    bool exifAppears = false;
-    bool xmpAppears = false;
-    bool iccAppears = false;
-    size_t pos = 2;  // position after SOI
-    for (jpeg_marker_struct* marker = cinfo.marker_list;
-         marker && !(exifAppears && xmpAppears && iccAppears);
-         marker = marker->next) {
-         pos += 4;
-         pos += marker->original_length;
-        if (marker->marker != kAPP1Marker && marker->marker != kAPP2Marker) {
-            continue;
-        }
-        const unsigned int len = marker->data_length;
-        if (!xmpAppears &&
-            len > sizeof(kXmpNameSpace) &&
-            !memcmp(marker->data, kXmpNameSpace, sizeof(kXmpNameSpace))) {
-            mXMPBuffer.resize(len+1, 0);
-            memcpy(static_cast<void*>(mXMPBuffer.data()), marker->data, len);
-            xmpAppears = true;
-        } else if (!exifAppears &&
-                   len > sizeof(kExifIdCode) &&
-                   !memcmp(marker->data, kExifIdCode, sizeof(kExifIdCode))) {
-            mEXIFBuffer.resize(len, 0);
-            memcpy(static_cast<void*>(mEXIFBuffer.data()), marker->data, len);
-            exifAppears = true;
-            mExifPos = pos - marker->original_length;
-        } else if (!iccAppears &&
-                   len > sizeof(kICCSig) &&
-                   !memcmp(marker->data, kICCSig, sizeof(kICCSig))) {
-            mICCBuffer.resize(len, 0);
-            memcpy(static_cast<void*>(mICCBuffer.data()), marker->data, len);
-            iccAppears = true;
-        }
-    }
+    saveMetadata(&cinfo);
 
     mWidth = cinfo.image_width;
     mHeight = cinfo.image_height;
@@ -327,6 +333,47 @@ CleanUp:
     return status;
 }
 
+void JpegDecoderHelper::saveMetadata(jpeg_decompress_struct* cinfo) {
+    // Here we only handle the first XMP / EXIF / ICC package.
+    // We assume that all packages are starting with two bytes marker (eg FF E1 for EXIF package),
+    // two bytes of package length which is stored in marker->original_length, and the real data
+    // which is stored in marker->data.
+    bool exifAppears = false;
+    bool xmpAppears = false;
+    bool iccAppears = false;
+    size_t pos = 2;  // position after SOI
+    for (jpeg_marker_struct* marker = cinfo->marker_list;
+         marker && !(exifAppears && xmpAppears && iccAppears);
+         marker = marker->next) {
+         pos += 4;
+         pos += marker->original_length;
+        if (marker->marker != kAPP1Marker && marker->marker != kAPP2Marker) {
+            continue;
+        }
+        const unsigned int len = marker->data_length;
+        if (!xmpAppears &&
+            len > sizeof(kXmpNameSpace) &&
+            !memcmp(marker->data, kXmpNameSpace, sizeof(kXmpNameSpace))) {
+            mXMPBuffer.resize(len+1, 0);
+            memcpy(static_cast<void*>(mXMPBuffer.data()), marker->data, len);
+            xmpAppears = true;
+        } else if (!exifAppears &&
+                   len > sizeof(kExifIdCode) &&
+                   !memcmp(marker->data, kExifIdCode, sizeof(kExifIdCode))) {
+            mEXIFBuffer.resize(len, 0);
+            memcpy(static_cast<void*>(mEXIFBuffer.data()), marker->data, len);
+            exifAppears = true;
+            mExifPos = pos - marker->original_length;
+        } else if (!iccAppears &&
+                   len > sizeof(kICCSig) &&
+                   !memcmp(marker->data, kICCSig, sizeof(kICCSig))) {
+            mICCBuffer.resize(len, 0);
+            memcpy(static_cast<void*>(mICCBuffer.data()), marker->data, len);
+            iccAppears = true;
+        }
+    }
+}
+
 bool JpegDecoderHelper::decompress(jpeg_decompress_struct* cinfo, const uint8_t* dest,
                                    bool isSingleChannel) {
     return isSingleChannel
@@ -401,6 +448,240 @@ bool JpegDecoderHelper::getCompressedImageParameters(const void* image, int leng
     return true;
 }
 
+bool JpegDecoderHelper::startDecompressRows(const void* image, int length, bool decodeToRGBA,
+                                            int scaleDenom) {
+    mRowDecoder.reset();
+    if (image == nullptr || length <= 0) {
+        ALOGE("Image size can not be handled: %d", length);
+        return false;
+    }
+    if (scaleDenom != 1 && scaleDenom != 2 && scaleDenom != 4 && scaleDenom != 8) {
+        ALOGE("Scale denominator can not be handled: %d", scaleDenom);
+        return false;
+    }
+    mResultBuffer.clear();
+    mXMPBuffer.clear();
+
+    mRowDecoder = std::make_unique<RowDecoder>(static_cast<const uint8_t*>(image), length);
+    RowDecoder* const d = mRowDecoder.get();
+    jpeg_decompress_struct* const cinfo = &d->cinfo;
+    cinfo->err = jpeg_std_error(&d->err.pub);
+    d->err.pub.error_exit = jpegrerror_exit;
+    if (setjmp(d->err.setjmp_buffer)) {
+        mRowDecoder.reset();
+        return false;
+    }
+
+    jpeg_create_decompress(cinfo);
+
+    jpeg_save_markers(cinfo, kAPP0Marker, 0xFFFF);
+    jpeg_save_markers(cinfo, kAPP1Marker, 0xFFFF);
+    jpeg_save_markers(cinfo, kAPP2Marker, 0xFFFF);
+
+    cinfo->src = &d->mgr;
+    if (jpeg_read_header(cinfo, TRUE) != JPEG_HEADER_OK) {
+        mRowDecoder.reset();
+        return false;
+    }
+
+    saveMetadata(cinfo);
+
+    if (cinfo->image_width > kMaxWidth || cinfo->image_height > kMaxHeight) {
+        mRowDecoder.reset();
+        return false;
+    }
+
+    if (cinfo->jpeg_color_space == JCS_YCbCr) {
+        if (cinfo->comp_info[0].h_samp_factor != 2 || cinfo->comp_info[0].v_samp_factor != 2 ||
+            cinfo->comp_info[1].h_samp_factor != 1 || cinfo->comp_info[1].v_samp_factor != 1 ||
+            cinfo->comp_info[2].h_samp_factor != 1 || cinfo->comp_info[2].v_samp_factor != 1) {
+            ALOGE("%s: only 4:2:0 subsampling is supported", __func__);
+            mRowDecoder.reset();
+            return false;
+        }
+    } else if (cinfo->jpeg_color_space != JCS_GRAYSCALE || decodeToRGBA) {
+        ALOGE("%s: unexpected jpeg color space", __func__);
+        mRowDecoder.reset();
+        return false;
+    }
+
+    d->isRGBA = decodeToRGBA;
+    if (decodeToRGBA) {
+        cinfo->out_color_space = JCS_EXT_RGBA;
+    } else {
+        cinfo->out_color_space = cinfo->jpeg_color_space;
+        cinfo->raw_data_out = TRUE;
+    }
+    cinfo->scale_num = 1;
+    cinfo->scale_denom = scaleDenom;
+    cinfo->dct_method = JDCT_ISLOW;
+    jpeg_start_decompress(cinfo);
+
+    mWidth = cinfo->output_width;
+    mHeight = cinfo->output_height;
+
+    if (decodeToRGBA) {
+        d->capacity = kCompressBatchSize;
+        d->strides[0] = cinfo->output_width * 4;
+        d->buffer = std::make_unique<uint8_t[]>(d->strides[0] * d->capacity);
+        d->planes[0] = d->buffer.get();
+        return true;
+    }
+
+    d->componentCount = cinfo->num_components;
+    d->linesPerIMcu = cinfo->max_v_samp_factor * MIN_DCT_V_SCALED_SIZE(cinfo);
+    d->capacity = ALIGNM(kCompressBatchSize, d->linesPerIMcu);
+
+    size_t lines[3];
+    size_t widths[3];
+    for (int c = 0; c < d->componentCount; c++) {
+        jpeg_component_info* comp = &cinfo->comp_info[c];
+        lines[c] = comp->v_samp_factor * DCT_V_SCALED_SIZE(comp);
+        widths[c] = ALIGNM(comp->width_in_blocks, comp->h_samp_factor) * DCT_H_SCALED_SIZE(comp);
+        d->rows[c].resize(d->capacity * lines[c] / d->linesPerIMcu);
+    }
+
+    bool subsampleChroma = false;
+    d->strides[0] = widths[0];
+    if (d->componentCount == 3) {
+        if (lines[1] != lines[2] || widths[1] != widths[2]) {
+            ALOGE("%s: unexpected chroma scaling", __func__);
+            mRowDecoder.reset();
+            return false;
+        }
+        if (lines[1] * 2 == d->linesPerIMcu) {
+            d->strides[1] = d->strides[2] = widths[1];
+        } else if (lines[1] == d->linesPerIMcu) {
+            subsampleChroma = true;
+            d->strides[1] = d->strides[2] = widths[1] / 2;
+        } else {
+            ALOGE("%s: unexpected chroma scaling", __func__);
+            mRowDecoder.reset();
+            return false;
+        }
+    }
+
+    const size_t chromaPlaneSize = d->strides[1] * d->capacity / 2;
+    d->buffer = std::make_unique<uint8_t[]>(d->strides[0] * d->capacity + 2 * chromaPlaneSize);
+    d->planes[0] = d->buffer.get();
+    for (size_t i = 0; i < d->rows[0].size(); i++) {
+        d->rows[0][i] = d->planes[0] + i * d->strides[0];
+    }
+    if (d->componentCount == 3) {
+        d->planes[1] = d->planes[0] + d->strides[0] * d->capacity;
+        d->planes[2] = d->planes[1] + chromaPlaneSize;
+        if (subsampleChroma) {
+            d->rawChromaStride = widths[1];
+            d->rawChroma = std::make_unique<uint8_t[]>(2 * d->rawChromaStride * d->capacity);
+        }
+        for (int c = 1; c < 3; c++) {
+            uint8_t* base = subsampleChroma
+                    ? d->rawChroma.get() + (c - 1) * d->rawChromaStride * d->capacity
+                    : d->planes[c];
+            size_t stride = subsampleChroma ? d->rawChromaStride : d->strides[c];
+            for (size_t i = 0; i < d->rows[c].size(); i++) {
+                d->rows[c][i] = base + i * stride;
+            }
+        }
+    }
+    return true;
+}
+
+int JpegDecoderHelper::decompressNextRows() {
+    if (mRowDecoder == nullptr) {
+        return -1;
+    }
+    RowDecoder* const d = mRowDecoder.get();
+    if (d->cinfo.output_scanline >= d->cinfo.output_height) {
+        d->rowsCount = 0;
+        return 0;
+    }
+    if (setjmp(d->err.setjmp_buffer)) {
+        mRowDecoder.reset();
+        return -1;
+    }
+    d->rowsTop = d->cinfo.output_scanline;
+    d->rowsCount = std::min(d->capacity, static_cast<size_t>(d->cinfo.output_height) - d->rowsTop);
+    if (!readRowBatch()) {
+        ALOGE("%s: failed to decompress rows %zu to %zu", __func__, d->rowsTop,
+              d->rowsTop + d->rowsCount);
+        mRowDecoder.reset();
+        return -1;
+    }
+    return static_cast<int>(d->rowsCount);
+}
+
+bool JpegDecoderHelper::readRowBatch() {
+    RowDecoder* const d = mRowDecoder.get();
+    jpeg_decompress_struct* const cinfo = &d->cinfo;
+
+    if (d->isRGBA) {
+        for (size_t i = 0; i < d->rowsCount; i++) {
+            JSAMPROW row = d->planes[0] + i * d->strides[0];
+            if (jpeg_read_scanlines(cinfo, &row, 1) != 1) return false;
+        }
+        return true;
+    }
+
+    for (size_t line = 0; line < d->capacity && cinfo->output_scanline < cinfo->output_height;
+         line += d->linesPerIMcu) {
+        JSAMPARRAY planes[3];
+        for (int c = 0; c < d->componentCount; c++) {
+            planes[c] = d->rows[c].data() + line * d->rows[c].size() / d->capacity;
+        }
+        if (jpeg_read_raw_data(cinfo, planes, d->linesPerIMcu) != d->linesPerIMcu) {
+            return false;
+        }
+    }
+
+    if (d->rawChroma != nullptr) {
+        // Average 2x2 blocks. Samples past the right or bottom edge of the image hold padding, so
+        // blocks on an odd edge only average the samples inside the image.
+        const size_t width = cinfo->output_width;
+        const size_t chromaWidth = (width + 1) / 2;
+        for (int c = 1; c < 3; c++) {
+            for (size_t y = 0; y < (d->rowsCount + 1) / 2; y++) {
+                const uint8_t* src0 = d->rows[c][2 * y];
+                const uint8_t* src1 = 2 * y + 1 < d->rowsCount ? d->rows[c][2 * y + 1] : src0;
+                uint8_t* dst = d->planes[c] + y * d->strides[c];
+                for (size_t x = 0; x < chromaWidth; x++) {
+                    const size_t x0 = 2 * x;
+                    const size_t x1 = x0 + 1 < width ? x0 + 1 : x0;
+                    int sum = src0[x0] + src0[x1] + src1[x0] + src1[x1];
+                    dst[x] = static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+size_t JpegDecoderHelper::getRowsTop() {
+    return mRowDecoder != nullptr ? mRowDecoder->rowsTop : 0;
+}
+
+size_t JpegDecoderHelper::getRowsCapacity() {
+    return mRowDecoder != nullptr ? mRowDecoder->capacity : 0;
+}
+
+uint8_t* JpegDecoderHelper::getRowsPtr(int plane) {
+    if (mRowDecoder == nullptr || plane < 0 || plane >= 3) {
+        return nullptr;
+    }
+    return mRowDecoder->planes[plane];
+}
+
+size_t JpegDecoderHelper::getRowsStride(int plane) {
+    if (mRowDecoder == nullptr || plane < 0 || plane >= 3) {
+        return 0;
+    }
+    return mRowDecoder->strides[plane];
+}
+
+void JpegDecoderHelper::finishDecompressRows() {
+    mRowDecoder.reset();
+}
+
 bool JpegDecoderHelper::decompressRGBA(jpeg_decompress_struct* cinfo, const uint8_t* dest) {
     JSAMPLE* out = (JSAMPLE*)dest;
 
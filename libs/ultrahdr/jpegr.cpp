@@ -15,17 +15,15 @@
  */
 
 #include <cmath>
-#include <condition_variable>
-#include <deque>
+#include <functional>
 #include <memory>
-#include <mutex>
-#include <thread>
 
 #include <ultrahdr/gainmapmath.h>
 #include <ultrahdr/icc.h>
 #include <ultrahdr/jpegr.h>
 #include <ultrahdr/jpegrutils.h>
 #include <ultrahdr/multipictureformat.h>
+#include <ultrahdr/threadpool.h>
 
 #include <image_io/base/data_segment_data_source.h>
 #include <image_io/jpeg/jpeg_info.h>
@@ -40,13 +38,6 @@ using namespace photos_editing_formats::image_io;
 
 namespace android::ultrahdr {
 
-#define USE_SRGB_INVOETF_LUT 1
-#define USE_HLG_OETF_LUT 1
-#define USE_PQ_OETF_LUT 1
-#define USE_HLG_INVOETF_LUT 1
-#define USE_PQ_INVOETF_LUT 1
-#define USE_APPLY_GAIN_LUT 1
-
 #define JPEGR_CHECK(x)          \
   {                             \
     status_t status = (x);      \
@@ -58,20 +49,6 @@ namespace android::ultrahdr {
 // JPEG compress quality (0 ~ 100) for gain map
 static const int kMapCompressQuality = 85;
 
-#define CONFIG_MULTITHREAD 1
-int GetCPUCoreCount() {
-  int cpuCoreCount = 1;
-#if CONFIG_MULTITHREAD
-#if defined(_SC_NPROCESSORS_ONLN)
-  cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
-#else
-  // _SC_NPROC_ONLN must be defined...
-  cpuCoreCount = sysconf(_SC_NPROC_ONLN);
-#endif
-#endif
-  return cpuCoreCount;
-}
-
 /*
  * Helper function copies the JPEG image from without EXIF.
  *
@@ -746,62 +723,17 @@ status_t JpegR::compressGainMap(jr_uncompressed_ptr gainmap_image_ptr,
   return NO_ERROR;
 }
 
+// Tile dimensions in image pixels for the gain map passes. A tile covers kJobSzInRows rows of
+// the image, i.e. several whole gain map rows, and spans enough columns to amortize scheduling.
 const int kJobSzInRows = 16;
+const int kJobSzInColumns = 256;
 static_assert(kJobSzInRows > 0 && kJobSzInRows % kMapDimensionScaleFactor == 0,
               "align job size to kMapDimensionScaleFactor");
+static_assert(kJobSzInColumns > 0 && kJobSzInColumns % kMapDimensionScaleFactor == 0,
+              "align job size to kMapDimensionScaleFactor");
 
-class JobQueue {
-public:
-  bool dequeueJob(size_t& rowStart, size_t& rowEnd);
-  void enqueueJob(size_t rowStart, size_t rowEnd);
-  void markQueueForEnd();
-  void reset();
-
-private:
-  bool mQueuedAllJobs = false;
-  std::deque<std::tuple<size_t, size_t>> mJobs;
-  std::mutex mMutex;
-  std::condition_variable mCv;
-};
-
-bool JobQueue::dequeueJob(size_t& rowStart, size_t& rowEnd) {
-  std::unique_lock<std::mutex> lock{mMutex};
-  while (true) {
-    if (mJobs.empty()) {
-      if (mQueuedAllJobs) {
-        return false;
-      } else {
-        mCv.wait_for(lock, std::chrono::milliseconds(100));
-      }
-    } else {
-      auto it = mJobs.begin();
-      rowStart = std::get<0>(*it);
-      rowEnd = std::get<1>(*it);
-      mJobs.erase(it);
-      return true;
-    }
-  }
-  return false;
-}
-
-void JobQueue::enqueueJob(size_t rowStart, size_t rowEnd) {
-  std::unique_lock<std::mutex> lock{mMutex};
-  mJobs.push_back(std::make_tuple(rowStart, rowEnd));
-  lock.unlock();
-  mCv.notify_one();
-}
-
-void JobQueue::markQueueForEnd() {
-  std::unique_lock<std::mutex> lock{mMutex};
-  mQueuedAllJobs = true;
-  lock.unlock();
-  mCv.notify_all();
-}
-
-void JobQueue::reset() {
-  std::unique_lock<std::mutex> lock{mMutex};
-  mJobs.clear();
-  mQueuedAllJobs = false;
+void JpegR::setMaxThreadCount(int count) {
+  mMaxThreadCount = std::max(count, 0);
 }
 
 status_t JpegR::generateGainMap(jr_uncompressed_ptr yuv420_image_ptr,
@@ -838,29 +770,17 @@ status_t JpegR::generateGainMap(jr_uncompressed_ptr yuv420_image_ptr,
   std::unique_ptr<uint8_t[]> map_data;
   map_data.reset(reinterpret_cast<uint8_t*>(dest->data));
 
-  ColorTransformFn hdrInvOetf = nullptr;
   float hdr_white_nits;
   switch (hdr_tf) {
     case ULTRAHDR_TF_LINEAR:
-      hdrInvOetf = identityConversion;
       // Note: this will produce clipping if the input exceeds kHlgMaxNits.
       // TODO: TF LINEAR will be deprecated.
       hdr_white_nits = kHlgMaxNits;
       break;
     case ULTRAHDR_TF_HLG:
-#if USE_HLG_INVOETF_LUT
-      hdrInvOetf = hlgInvOetfLUT;
-#else
-      hdrInvOetf = hlgInvOetf;
-#endif
       hdr_white_nits = kHlgMaxNits;
       break;
     case ULTRAHDR_TF_PQ:
-#if USE_PQ_INVOETF_LUT
-      hdrInvOetf = pqInvOetfLUT;
-#else
-      hdrInvOetf = pqInvOetf;
-#endif
       hdr_white_nits = kPqMaxNits;
       break;
     default:
@@ -876,117 +796,42 @@ status_t JpegR::generateGainMap(jr_uncompressed_ptr yuv420_image_ptr,
   metadata->hdrCapacityMin = 1.0f;
   metadata->hdrCapacityMax = metadata->maxContentBoost;
 
-  float log2MinBoost = log2(metadata->minContentBoost);
-  float log2MaxBoost = log2(metadata->maxContentBoost);
-
-  ColorTransformFn hdrGamutConversionFn =
-          getHdrConversionFn(yuv420_image_ptr->colorGamut, p010_image_ptr->colorGamut);
-
-  ColorCalculationFn luminanceFn = nullptr;
-  ColorTransformFn sdrYuvToRgbFn = nullptr;
-  switch (yuv420_image_ptr->colorGamut) {
-    case ULTRAHDR_COLORGAMUT_BT709:
-      luminanceFn = srgbLuminance;
-      sdrYuvToRgbFn = srgbYuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_P3:
-      luminanceFn = p3Luminance;
-      sdrYuvToRgbFn = p3YuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_BT2100:
-      luminanceFn = bt2100Luminance;
-      sdrYuvToRgbFn = bt2100YuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
-      // Should be impossible to hit after input validation.
-      return ERROR_JPEGR_INVALID_COLORGAMUT;
-  }
-  if (sdr_is_601) {
-    sdrYuvToRgbFn = p3YuvToRgb;
+  GenerateGainMapRowFn generateRow =
+          getGenerateGainMapRowFn(yuv420_image_ptr->colorGamut, p010_image_ptr->colorGamut,
+                                  hdr_tf, sdr_is_601);
+  if (generateRow == nullptr) {
+    // Should be impossible to hit after input validation.
+    return ERROR_JPEGR_INVALID_COLORGAMUT;
   }
 
-  ColorTransformFn hdrYuvToRgbFn = nullptr;
-  switch (p010_image_ptr->colorGamut) {
-    case ULTRAHDR_COLORGAMUT_BT709:
-      hdrYuvToRgbFn = srgbYuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_P3:
-      hdrYuvToRgbFn = p3YuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_BT2100:
-      hdrYuvToRgbFn = bt2100YuvToRgb;
-      break;
-    case ULTRAHDR_COLORGAMUT_UNSPECIFIED:
-      // Should be impossible to hit after input validation.
-      return ERROR_JPEGR_INVALID_COLORGAMUT;
-  }
+  GainMapRowParams params;
+  params.sdr_yuv420_image = yuv420_image_ptr;
+  params.hdr_p010_image = p010_image_ptr;
+  params.metadata = metadata;
+  params.hdr_white_nits = hdr_white_nits;
+  params.log2_min_content_boost = log2(metadata->minContentBoost);
+  params.log2_max_content_boost = log2(metadata->maxContentBoost);
 
-  std::mutex mutex;
-  const int threads = std::clamp(GetCPUCoreCount(), 1, 4);
-  size_t rowStep = threads == 1 ? image_height : kJobSzInRows;
-  JobQueue jobQueue;
-
-  std::function<void()> generateMap = [yuv420_image_ptr, p010_image_ptr, metadata, dest, hdrInvOetf,
-                                       hdrGamutConversionFn, luminanceFn, sdrYuvToRgbFn,
-                                       hdrYuvToRgbFn, hdr_white_nits, log2MinBoost, log2MaxBoost,
-                                       &jobQueue]() -> void {
-    size_t rowStart, rowEnd;
-    while (jobQueue.dequeueJob(rowStart, rowEnd)) {
-      for (size_t y = rowStart; y < rowEnd; ++y) {
-        for (size_t x = 0; x < dest->width; ++x) {
-          Color sdr_yuv_gamma = sampleYuv420(yuv420_image_ptr, kMapDimensionScaleFactor, x, y);
-          Color sdr_rgb_gamma = sdrYuvToRgbFn(sdr_yuv_gamma);
-          // We are assuming the SDR input is always sRGB transfer.
-#if USE_SRGB_INVOETF_LUT
-          Color sdr_rgb = srgbInvOetfLUT(sdr_rgb_gamma);
-#else
-          Color sdr_rgb = srgbInvOetf(sdr_rgb_gamma);
-#endif
-          float sdr_y_nits = luminanceFn(sdr_rgb) * kSdrWhiteNits;
-
-          Color hdr_yuv_gamma = sampleP010(p010_image_ptr, kMapDimensionScaleFactor, x, y);
-          Color hdr_rgb_gamma = hdrYuvToRgbFn(hdr_yuv_gamma);
-          Color hdr_rgb = hdrInvOetf(hdr_rgb_gamma);
-          hdr_rgb = hdrGamutConversionFn(hdr_rgb);
-          float hdr_y_nits = luminanceFn(hdr_rgb) * hdr_white_nits;
-
-          size_t pixel_idx = x + y * dest->width;
-          reinterpret_cast<uint8_t*>(dest->data)[pixel_idx] =
-                  encodeGain(sdr_y_nits, hdr_y_nits, metadata, log2MinBoost, log2MaxBoost);
-        }
-      }
+  std::function<void(const Tile&)> generateMap = [&params, generateRow, map_width,
+                                                   dest](const Tile& tile) -> void {
+    for (size_t y = tile.top; y < tile.bottom; ++y) {
+      generateRow(params, y, tile.left, tile.right,
+                  reinterpret_cast<uint8_t*>(dest->data) + y * map_width + tile.left);
     }
   };
 
   // generate map
-  std::vector<std::thread> workers;
-  for (int th = 0; th < threads - 1; th++) {
-    workers.push_back(std::thread(generateMap));
-  }
-
-  rowStep = (threads == 1 ? image_height : kJobSzInRows) / kMapDimensionScaleFactor;
-  for (size_t rowStart = 0; rowStart < map_height;) {
-    size_t rowEnd = std::min(rowStart + rowStep, map_height);
-    jobQueue.enqueueJob(rowStart, rowEnd);
-    rowStart = rowEnd;
-  }
-  jobQueue.markQueueForEnd();
-  generateMap();
-  std::for_each(workers.begin(), workers.end(), [](std::thread& t) { t.join(); });
+  ThreadPool::getInstance().forEachTile(map_width, map_height,
+                                        kJobSzInColumns / kMapDimensionScaleFactor,
+                                        kJobSzInRows / kMapDimensionScaleFactor, generateMap,
+                                        mMaxThreadCount);
 
   map_data.release();
   return NO_ERROR;
 }
 
-status_t JpegR::applyGainMap(jr_uncompressed_ptr yuv420_image_ptr,
-                             jr_uncompressed_ptr gainmap_image_ptr, ultrahdr_metadata_ptr metadata,
-                             ultrahdr_output_format output_format, float max_display_boost,
-                             jr_uncompressed_ptr dest) {
-  if (yuv420_image_ptr == nullptr || gainmap_image_ptr == nullptr || metadata == nullptr ||
-      dest == nullptr || yuv420_image_ptr->data == nullptr ||
-      yuv420_image_ptr->chroma_data == nullptr || gainmap_image_ptr->data == nullptr) {
-    return ERROR_JPEGR_INVALID_NULL_PTR;
-  }
+// Checks that the gain map can be applied with the given metadata.
+static status_t checkGainMapMetadata(ultrahdr_metadata_ptr metadata) {
   if (metadata->version.compare(kJpegrVersion)) {
     ALOGE("Unsupported metadata version: %s", metadata->version.c_str());
     return ERROR_JPEGR_UNSUPPORTED_METADATA;
@@ -1005,6 +850,19 @@ status_t JpegR::applyGainMap(jr_uncompressed_ptr yuv420_image_ptr,
           metadata->hdrCapacityMax);
     return ERROR_JPEGR_UNSUPPORTED_METADATA;
   }
+  return NO_ERROR;
+}
+
+status_t JpegR::applyGainMap(jr_uncompressed_ptr yuv420_image_ptr,
+                             jr_uncompressed_ptr gainmap_image_ptr, ultrahdr_metadata_ptr metadata,
+                             ultrahdr_output_format output_format, float max_display_boost,
+                             jr_uncompressed_ptr dest) {
+  if (yuv420_image_ptr == nullptr || gainmap_image_ptr == nullptr || metadata == nullptr ||
+      dest == nullptr || yuv420_image_ptr->data == nullptr ||
+      yuv420_image_ptr->chroma_data == nullptr || gainmap_image_ptr->data == nullptr) {
+    return ERROR_JPEGR_INVALID_NULL_PTR;
+  }
+  JPEGR_CHECK(checkGainMapMetadata(metadata));
 
   // TODO: remove once map scaling factor is computed based on actual map dims
   size_t image_width = yuv420_image_ptr->width;
@@ -1024,97 +882,233 @@ status_t JpegR::applyGainMap(jr_uncompressed_ptr yuv420_image_ptr,
   float display_boost = std::min(max_display_boost, metadata->maxContentBoost);
   GainLUT gainLUT(metadata, display_boost);
 
-  JobQueue jobQueue;
-  std::function<void()> applyRecMap = [yuv420_image_ptr, gainmap_image_ptr, metadata, dest,
-                                       &jobQueue, &idwTable, output_format, &gainLUT,
-                                       display_boost]() -> void {
-    size_t width = yuv420_image_ptr->width;
-    size_t height = yuv420_image_ptr->height;
-
-    size_t rowStart, rowEnd;
-    while (jobQueue.dequeueJob(rowStart, rowEnd)) {
-      for (size_t y = rowStart; y < rowEnd; ++y) {
-        for (size_t x = 0; x < width; ++x) {
-          Color yuv_gamma_sdr = getYuv420Pixel(yuv420_image_ptr, x, y);
-          // Assuming the sdr image is a decoded JPEG, we should always use Rec.601 YUV coefficients
-          Color rgb_gamma_sdr = p3YuvToRgb(yuv_gamma_sdr);
-          // We are assuming the SDR base image is always sRGB transfer.
-#if USE_SRGB_INVOETF_LUT
-          Color rgb_sdr = srgbInvOetfLUT(rgb_gamma_sdr);
-#else
-          Color rgb_sdr = srgbInvOetf(rgb_gamma_sdr);
-#endif
-          float gain;
-          // TODO: determine map scaling factor based on actual map dims
-          size_t map_scale_factor = kMapDimensionScaleFactor;
-          // TODO: If map_scale_factor is guaranteed to be an integer, then remove the following.
-          // Currently map_scale_factor is of type size_t, but it could be changed to a float
-          // later.
-          if (map_scale_factor != floorf(map_scale_factor)) {
-            gain = sampleMap(gainmap_image_ptr, map_scale_factor, x, y);
-          } else {
-            gain = sampleMap(gainmap_image_ptr, map_scale_factor, x, y, idwTable);
-          }
+  ApplyGainMapRowFn applyRow = getApplyGainMapRowFn(output_format);
+  if (applyRow == nullptr) {
+    // Should be impossible to hit after input validation.
+    return ERROR_JPEGR_INVALID_OUTPUT_TYPE;
+  }
+
+  ApplyGainMapRowParams params;
+  params.sdr_yuv420_image = yuv420_image_ptr;
+  params.gainmap_image = gainmap_image_ptr;
+  params.metadata = metadata;
+  params.idw_table = &idwTable;
+  params.gain_lut = &gainLUT;
+  params.display_boost = display_boost;
+
+  const size_t dest_pixel_bytes =
+          output_format == ULTRAHDR_OUTPUT_HDR_LINEAR ? sizeof(uint64_t) : sizeof(uint32_t);
+  const size_t dest_row_bytes = image_width * dest_pixel_bytes;
+  std::function<void(const Tile&)> applyRecMap = [&params, applyRow, dest, dest_pixel_bytes,
+                                                   dest_row_bytes](const Tile& tile) -> void {
+    for (size_t y = tile.top; y < tile.bottom; ++y) {
+      applyRow(params, y, tile.left, tile.right,
+               reinterpret_cast<uint8_t*>(dest->data) + y * dest_row_bytes +
+                       tile.left * dest_pixel_bytes);
+    }
+  };
 
-#if USE_APPLY_GAIN_LUT
-          Color rgb_hdr = applyGainLUT(rgb_sdr, gain, gainLUT);
-#else
-          Color rgb_hdr = applyGain(rgb_sdr, gain, metadata, display_boost);
-#endif
-          rgb_hdr = rgb_hdr / display_boost;
-          size_t pixel_idx = x + y * width;
-
-          switch (output_format) {
-            case ULTRAHDR_OUTPUT_HDR_LINEAR: {
-              uint64_t rgba_f16 = colorToRgbaF16(rgb_hdr);
-              reinterpret_cast<uint64_t*>(dest->data)[pixel_idx] = rgba_f16;
-              break;
-            }
-            case ULTRAHDR_OUTPUT_HDR_HLG: {
-#if USE_HLG_OETF_LUT
-              ColorTransformFn hdrOetf = hlgOetfLUT;
-#else
-              ColorTransformFn hdrOetf = hlgOetf;
-#endif
-              Color rgb_gamma_hdr = hdrOetf(rgb_hdr);
-              uint32_t rgba_1010102 = colorToRgba1010102(rgb_gamma_hdr);
-              reinterpret_cast<uint32_t*>(dest->data)[pixel_idx] = rgba_1010102;
-              break;
-            }
-            case ULTRAHDR_OUTPUT_HDR_PQ: {
-#if USE_PQ_OETF_LUT
-              ColorTransformFn hdrOetf = pqOetfLUT;
-#else
-              ColorTransformFn hdrOetf = pqOetf;
-#endif
-              Color rgb_gamma_hdr = hdrOetf(rgb_hdr);
-              uint32_t rgba_1010102 = colorToRgba1010102(rgb_gamma_hdr);
-              reinterpret_cast<uint32_t*>(dest->data)[pixel_idx] = rgba_1010102;
-              break;
-            }
-            default: {
-            }
-              // Should be impossible to hit after input validation.
-          }
-        }
+  ThreadPool::getInstance().forEachTile(image_width, image_height, kJobSzInColumns, kJobSzInRows,
+                                        applyRecMap, mMaxThreadCount);
+  return NO_ERROR;
+}
+
+status_t JpegR::decodeJPEGRStreaming(jr_compressed_ptr jpegr_image_ptr, jr_uncompressed_ptr dest,
+                                     float max_display_boost,
+                                     ultrahdr_output_format output_format, int scale_denom,
+                                     jr_region_ptr region) {
+  if (jpegr_image_ptr == nullptr || jpegr_image_ptr->data == nullptr) {
+    ALOGE("received nullptr for compressed jpegr image");
+    return ERROR_JPEGR_INVALID_NULL_PTR;
+  }
+  if (dest == nullptr || dest->data == nullptr) {
+    ALOGE("received nullptr for dest image");
+    return ERROR_JPEGR_INVALID_NULL_PTR;
+  }
+  if (max_display_boost < 1.0f) {
+    ALOGE("received bad value for max_display_boost %f", max_display_boost);
+    return ERROR_JPEGR_INVALID_INPUT_TYPE;
+  }
+  if (output_format <= ULTRAHDR_OUTPUT_UNSPECIFIED || output_format > ULTRAHDR_OUTPUT_MAX) {
+    ALOGE("received bad value for output format %d", output_format);
+    return ERROR_JPEGR_INVALID_INPUT_TYPE;
+  }
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != 8) {
+    ALOGE("received bad value for scale denominator %d", scale_denom);
+    return ERROR_JPEGR_INVALID_INPUT_TYPE;
+  }
+
+  jpegr_compressed_struct primary_jpeg_image, gainmap_jpeg_image;
+  status_t status =
+          extractPrimaryImageAndGainMap(jpegr_image_ptr, &primary_jpeg_image, &gainmap_jpeg_image);
+  if (status != NO_ERROR) {
+    if (output_format != ULTRAHDR_OUTPUT_SDR || status != ERROR_JPEGR_GAIN_MAP_IMAGE_NOT_FOUND) {
+      ALOGE("received invalid compressed jpegr image");
+      return status;
+    }
+  }
+
+  JpegDecoderHelper jpeg_dec_obj_yuv420;
+  if (!jpeg_dec_obj_yuv420.startDecompressRows(primary_jpeg_image.data, primary_jpeg_image.length,
+                                               (output_format == ULTRAHDR_OUTPUT_SDR),
+                                               scale_denom)) {
+    return ERROR_JPEGR_DECODE_ERROR;
+  }
+  const size_t image_width = jpeg_dec_obj_yuv420.getDecompressedImageWidth();
+  const size_t image_height = jpeg_dec_obj_yuv420.getDecompressedImageHeight();
+
+  size_t region_left = 0, region_top = 0, region_right = image_width, region_bottom = image_height;
+  if (region != nullptr) {
+    if (region->left < 0 || region->top < 0 || region->left >= region->right ||
+        region->top >= region->bottom || region->right > static_cast<int>(image_width) ||
+        region->bottom > static_cast<int>(image_height)) {
+      ALOGE("received bad region [%d, %d) x [%d, %d) for image of size %zux%zu", region->left,
+            region->right, region->top, region->bottom, image_width, image_height);
+      return ERROR_JPEGR_INVALID_INPUT_TYPE;
+    }
+    region_left = region->left;
+    region_top = region->top;
+    region_right = region->right;
+    region_bottom = region->bottom;
+  }
+  const size_t region_width = region_right - region_left;
+  dest->width = region_width;
+  dest->height = region_bottom - region_top;
+  uint8_t* dest_data = reinterpret_cast<uint8_t*>(dest->data);
+  int rows;
+
+  if (output_format == ULTRAHDR_OUTPUT_SDR) {
+    const size_t dest_row_bytes = region_width * 4;
+    while ((rows = jpeg_dec_obj_yuv420.decompressNextRows()) > 0) {
+      const size_t top = jpeg_dec_obj_yuv420.getRowsTop();
+      const uint8_t* src = jpeg_dec_obj_yuv420.getRowsPtr(0) + region_left * 4;
+      const size_t src_stride = jpeg_dec_obj_yuv420.getRowsStride(0);
+      for (size_t y = std::max(top, region_top); y < std::min(top + rows, region_bottom); ++y) {
+        memcpy(dest_data + (y - region_top) * dest_row_bytes, src + (y - top) * src_stride,
+               dest_row_bytes);
       }
+      if (top + rows >= region_bottom) break;
     }
-  };
+    if (rows < 0) {
+      return ERROR_JPEGR_DECODE_ERROR;
+    }
+    return NO_ERROR;
+  }
 
-  const int threads = std::clamp(GetCPUCoreCount(), 1, 4);
-  std::vector<std::thread> workers;
-  for (int th = 0; th < threads - 1; th++) {
-    workers.push_back(std::thread(applyRecMap));
+  JpegDecoderHelper jpeg_dec_obj_gm;
+  if (!jpeg_dec_obj_gm.startDecompressRows(gainmap_jpeg_image.data, gainmap_jpeg_image.length,
+                                           /* decodeToRGBA */ false, scale_denom)) {
+    return ERROR_JPEGR_DECODE_ERROR;
   }
-  const int rowStep = threads == 1 ? yuv420_image_ptr->height : kJobSzInRows;
-  for (int rowStart = 0; rowStart < yuv420_image_ptr->height;) {
-    int rowEnd = std::min(rowStart + rowStep, yuv420_image_ptr->height);
-    jobQueue.enqueueJob(rowStart, rowEnd);
-    rowStart = rowEnd;
+
+  ultrahdr_metadata_struct uhdr_metadata;
+  if (!getMetadataFromXMP(static_cast<uint8_t*>(jpeg_dec_obj_gm.getXMPPtr()),
+                          jpeg_dec_obj_gm.getXMPSize(), &uhdr_metadata)) {
+    return ERROR_JPEGR_INVALID_METADATA;
+  }
+  JPEGR_CHECK(checkGainMapMetadata(&uhdr_metadata));
+
+  // Scaled dimensions are rounded up, so the gain map of a scaled image may be one sample larger
+  // than the image divided by kMapDimensionScaleFactor.
+  const size_t map_width = jpeg_dec_obj_gm.getDecompressedImageWidth();
+  const size_t map_height = jpeg_dec_obj_gm.getDecompressedImageHeight();
+  if (map_width == 0 || map_height == 0 || map_width < image_width / kMapDimensionScaleFactor ||
+      map_width > (image_width + kMapDimensionScaleFactor - 1) / kMapDimensionScaleFactor ||
+      map_height < image_height / kMapDimensionScaleFactor ||
+      map_height > (image_height + kMapDimensionScaleFactor - 1) / kMapDimensionScaleFactor) {
+    ALOGE("gain map dimensions and primary image dimensions are not to scale, primary image "
+          "resolution is %zux%zu, received gain map resolution is %zux%zu",
+          image_width, image_height, map_width, map_height);
+    return ERROR_JPEGR_INVALID_INPUT_TYPE;
+  }
+
+  ShepardsIDW idwTable(kMapDimensionScaleFactor);
+  float display_boost = std::min(max_display_boost, uhdr_metadata.maxContentBoost);
+  GainLUT gainLUT(&uhdr_metadata, display_boost);
+
+  ApplyGainMapRowFn applyRow = getApplyGainMapRowFn(output_format);
+  if (applyRow == nullptr) {
+    // Should be impossible to hit after input validation.
+    return ERROR_JPEGR_INVALID_OUTPUT_TYPE;
+  }
+
+  jpegr_uncompressed_struct yuv420_band;
+  yuv420_band.width = image_width;
+  yuv420_band.height = jpeg_dec_obj_yuv420.getRowsCapacity();
+  yuv420_band.colorGamut = IccHelper::readIccColorGamut(jpeg_dec_obj_yuv420.getICCPtr(),
+                                                        jpeg_dec_obj_yuv420.getICCSize());
+  jpegr_uncompressed_struct gainmap_band;
+  gainmap_band.width = map_width;
+  gainmap_band.height = map_height;
+  gainmap_band.colorGamut = ULTRAHDR_COLORGAMUT_UNSPECIFIED;
+
+  ApplyGainMapRowParams params;
+  params.sdr_yuv420_image = &yuv420_band;
+  params.gainmap_image = &gainmap_band;
+  params.metadata = &uhdr_metadata;
+  params.idw_table = &idwTable;
+  params.gain_lut = &gainLUT;
+  params.display_boost = display_boost;
+
+  // Gain map rows [map_end - map_window.size() / map_width, map_end), i.e. the rows that the
+  // current band is interpolated from plus the rest of the last decompressed gain map batch.
+  std::vector<uint8_t> map_window;
+  size_t map_end = 0;
+
+  const size_t dest_pixel_bytes =
+          output_format == ULTRAHDR_OUTPUT_HDR_LINEAR ? sizeof(uint64_t) : sizeof(uint32_t);
+  const size_t dest_row_bytes = region_width * dest_pixel_bytes;
+  while ((rows = jpeg_dec_obj_yuv420.decompressNextRows()) > 0) {
+    const size_t top = jpeg_dec_obj_yuv420.getRowsTop();
+    const size_t band_top = std::max(top, region_top);
+    const size_t band_bottom = std::min(top + rows, region_bottom);
+    if (band_top < band_bottom) {
+      const size_t map_first = std::min(band_top / kMapDimensionScaleFactor, map_height - 1);
+      const size_t map_last =
+              std::min((band_bottom - 1) / kMapDimensionScaleFactor + 1, map_height - 1);
+      while (map_end <= map_last) {
+        int map_rows = jpeg_dec_obj_gm.decompressNextRows();
+        if (map_rows <= 0) {
+          return ERROR_JPEGR_DECODE_ERROR;
+        }
+        const uint8_t* src = jpeg_dec_obj_gm.getRowsPtr(0);
+        const size_t src_stride = jpeg_dec_obj_gm.getRowsStride(0);
+        for (int i = 0; i < map_rows; ++i) {
+          map_window.insert(map_window.end(), src + i * src_stride,
+                            src + i * src_stride + map_width);
+        }
+        map_end += map_rows;
+      }
+      const size_t map_window_top = map_end - map_window.size() / map_width;
+      if (map_window_top < map_first) {
+        map_window.erase(map_window.begin(),
+                         map_window.begin() + (map_first - map_window_top) * map_width);
+      }
+      gainmap_band.data = map_window.data();
+      params.gainmap_first_row = map_end - map_window.size() / map_width;
+
+      yuv420_band.data = jpeg_dec_obj_yuv420.getRowsPtr(0);
+      yuv420_band.luma_stride = jpeg_dec_obj_yuv420.getRowsStride(0);
+      yuv420_band.chroma_data = jpeg_dec_obj_yuv420.getRowsPtr(1);
+      yuv420_band.chroma_stride = jpeg_dec_obj_yuv420.getRowsStride(1);
+      params.sdr_first_row = top;
+
+      std::function<void(const Tile&)> applyBand = [&params, applyRow, band_top, region_left,
+                                                    region_top, dest_data, dest_pixel_bytes,
+                                                    dest_row_bytes](const Tile& tile) -> void {
+        for (size_t y = band_top + tile.top; y < band_top + tile.bottom; ++y) {
+          applyRow(params, y, region_left + tile.left, region_left + tile.right,
+                   dest_data + (y - region_top) * dest_row_bytes + tile.left * dest_pixel_bytes);
+        }
+      };
+      ThreadPool::getInstance().forEachTile(region_width, band_bottom - band_top, kJobSzInColumns,
+                                            kJobSzInRows, applyBand, mMaxThreadCount);
+    }
+    if (top + rows >= region_bottom) break;
+  }
+  if (rows < 0) {
+    return ERROR_JPEGR_DECODE_ERROR;
   }
-  jobQueue.markQueueForEnd();
-  applyRecMap();
-  std::for_each(workers.begin(), workers.end(), [](std::thread& t) { t.join(); });
   return NO_ERROR;
 }
 
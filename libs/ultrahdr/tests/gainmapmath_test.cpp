@@ -1356,4 +1356,138 @@ TEST_F(GainMapMathTest, ApplyMap) {
                 RgbWhite() / 2.0f);
 }
 
+TEST_F(GainMapMathTest, GenerateGainMapRow) {
+  jpegr_uncompressed_struct sdr_image = Yuv420Image();
+  jpegr_uncompressed_struct hdr_image = P010Image();
+  ultrahdr_metadata_struct metadata;
+  metadata.maxContentBoost = kHlgMaxNits / kSdrWhiteNits;
+  metadata.minContentBoost = 1.0f;
+
+  GainMapRowParams params;
+  params.sdr_yuv420_image = &sdr_image;
+  params.hdr_p010_image = &hdr_image;
+  params.metadata = &metadata;
+  params.hdr_white_nits = kHlgMaxNits;
+  params.log2_min_content_boost = log2(metadata.minContentBoost);
+  params.log2_max_content_boost = log2(metadata.maxContentBoost);
+
+  EXPECT_EQ(getGenerateGainMapRowFn(ULTRAHDR_COLORGAMUT_UNSPECIFIED, ULTRAHDR_COLORGAMUT_BT709,
+                                    ULTRAHDR_TF_HLG, false),
+            nullptr);
+  EXPECT_EQ(getGenerateGainMapRowFn(ULTRAHDR_COLORGAMUT_BT709, ULTRAHDR_COLORGAMUT_UNSPECIFIED,
+                                    ULTRAHDR_TF_HLG, false),
+            nullptr);
+  EXPECT_EQ(getGenerateGainMapRowFn(ULTRAHDR_COLORGAMUT_BT709, ULTRAHDR_COLORGAMUT_BT709,
+                                    ULTRAHDR_TF_UNSPECIFIED, false),
+            nullptr);
+
+  // The row kernel must produce exactly what the per-pixel helpers do.
+  GenerateGainMapRowFn generateRow = getGenerateGainMapRowFn(ULTRAHDR_COLORGAMUT_BT709,
+                                                             ULTRAHDR_COLORGAMUT_BT2100,
+                                                             ULTRAHDR_TF_HLG, false);
+  ASSERT_NE(generateRow, nullptr);
+  uint8_t gain = 0;
+  generateRow(params, 0, 0, 1, &gain);
+
+  Color sdr_rgb = srgbInvOetfLUT(srgbYuvToRgb(sampleYuv420(&sdr_image, 4, 0, 0)));
+  Color hdr_rgb = bt2100ToBt709(hlgInvOetfLUT(bt2100YuvToRgb(sampleP010(&hdr_image, 4, 0, 0))));
+  EXPECT_EQ(gain, encodeGain(srgbLuminance(sdr_rgb) * kSdrWhiteNits,
+                             srgbLuminance(hdr_rgb) * kHlgMaxNits, &metadata,
+                             params.log2_min_content_boost, params.log2_max_content_boost));
+
+  generateRow = getGenerateGainMapRowFn(ULTRAHDR_COLORGAMUT_P3, ULTRAHDR_COLORGAMUT_P3,
+                                        ULTRAHDR_TF_LINEAR, true);
+  ASSERT_NE(generateRow, nullptr);
+  generateRow(params, 0, 0, 1, &gain);
+
+  sdr_rgb = srgbInvOetfLUT(p3YuvToRgb(sampleYuv420(&sdr_image, 4, 0, 0)));
+  hdr_rgb = p3YuvToRgb(sampleP010(&hdr_image, 4, 0, 0));
+  EXPECT_EQ(gain, encodeGain(p3Luminance(sdr_rgb) * kSdrWhiteNits,
+                             p3Luminance(hdr_rgb) * kHlgMaxNits, &metadata,
+                             params.log2_min_content_boost, params.log2_max_content_boost));
+}
+
+TEST_F(GainMapMathTest, ApplyGainMapRow) {
+  jpegr_uncompressed_struct sdr_image = Yuv420Image();
+  uint8_t map_pixel = 0x80;
+  jpegr_uncompressed_struct map_image = { &map_pixel, 1, 1, ULTRAHDR_COLORGAMUT_UNSPECIFIED };
+  ultrahdr_metadata_struct metadata;
+  metadata.maxContentBoost = 8.0f;
+  metadata.minContentBoost = 1.0f;
+  const float display_boost = 4.0f;
+  ShepardsIDW idwTable(kMapDimensionScaleFactor);
+  GainLUT gainLUT(&metadata, display_boost);
+
+  ApplyGainMapRowParams params;
+  params.sdr_yuv420_image = &sdr_image;
+  params.gainmap_image = &map_image;
+  params.metadata = &metadata;
+  params.idw_table = &idwTable;
+  params.gain_lut = &gainLUT;
+  params.display_boost = display_boost;
+
+  EXPECT_EQ(getApplyGainMapRowFn(ULTRAHDR_OUTPUT_SDR), nullptr);
+  EXPECT_EQ(getApplyGainMapRowFn(ULTRAHDR_OUTPUT_UNSPECIFIED), nullptr);
+
+  ApplyGainMapRowFn applyLinear = getApplyGainMapRowFn(ULTRAHDR_OUTPUT_HDR_LINEAR);
+  ApplyGainMapRowFn applyHlg = getApplyGainMapRowFn(ULTRAHDR_OUTPUT_HDR_HLG);
+  ApplyGainMapRowFn applyPq = getApplyGainMapRowFn(ULTRAHDR_OUTPUT_HDR_PQ);
+  ASSERT_NE(applyLinear, nullptr);
+  ASSERT_NE(applyHlg, nullptr);
+  ASSERT_NE(applyPq, nullptr);
+
+  // The row kernels must produce exactly what the per-pixel helpers do.
+  for (size_t y = 0; y < 4; ++y) {
+    uint64_t row_f16[4];
+    uint32_t row_hlg[4];
+    uint32_t row_pq[4];
+    applyLinear(params, y, 0, 4, row_f16);
+    applyHlg(params, y, 0, 4, row_hlg);
+    applyPq(params, y, 0, 4, row_pq);
+
+    for (size_t x = 0; x < 4; ++x) {
+      Color rgb_sdr = srgbInvOetfLUT(p3YuvToRgb(getYuv420Pixel(&sdr_image, x, y)));
+      float gain = sampleMap(&map_image, kMapDimensionScaleFactor, x, y, idwTable);
+      Color rgb_hdr = applyGainLUT(rgb_sdr, gain, gainLUT) / display_boost;
+
+      EXPECT_EQ(row_f16[x], colorToRgbaF16(rgb_hdr));
+      EXPECT_EQ(row_hlg[x], colorToRgba1010102(hlgOetfLUT(rgb_hdr)));
+      EXPECT_EQ(row_pq[x], colorToRgba1010102(pqOetfLUT(rgb_hdr)));
+    }
+  }
+
+  // Only the requested columns are written.
+  uint32_t row[4] = { 0, 0, 0, 0 };
+  applyHlg(params, 1, 1, 3, row + 1);
+  EXPECT_EQ(row[0], 0);
+  EXPECT_NE(row[1], 0);
+  EXPECT_NE(row[2], 0);
+  EXPECT_EQ(row[3], 0);
+
+  // A band of the SDR image gives the same result as the whole image.
+  uint8_t band_pixels[] = {
+    // Y
+    0x02, 0x12, 0x22, 0x32,
+    0x03, 0x13, 0x23, 0x33,
+    // U
+    0xA2, 0xA3,
+    // V
+    0xB2, 0xB3,
+  };
+  jpegr_uncompressed_struct band_image =
+          { band_pixels, 4, 2, ULTRAHDR_COLORGAMUT_BT709, band_pixels + 8, 4, 2 };
+  ApplyGainMapRowParams band_params = params;
+  band_params.sdr_yuv420_image = &band_image;
+  band_params.sdr_first_row = 2;
+  for (size_t y = 2; y < 4; ++y) {
+    uint32_t expected[4];
+    uint32_t actual[4];
+    applyHlg(params, y, 0, 4, expected);
+    applyHlg(band_params, y, 0, 4, actual);
+    for (size_t x = 0; x < 4; ++x) {
+      EXPECT_EQ(actual[x], expected[x]);
+    }
+  }
+}
+
 } // namespace android::ultrahdr
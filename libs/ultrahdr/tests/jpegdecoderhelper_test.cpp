@@ -123,6 +123,73 @@ TEST_F(JpegDecoderHelperTest, decodeGreyImage) {
     ASSERT_GT(decoder.getDecompressedImageSize(), static_cast<uint32_t>(0));
 }
 
+TEST_F(JpegDecoderHelperTest, decodeYuvImageRows) {
+    JpegDecoderHelper decoder;
+    ASSERT_TRUE(decoder.decompressImage(mYuvIccImage.buffer.get(), mYuvIccImage.size));
+    const uint8_t* yPlane = static_cast<const uint8_t*>(decoder.getDecompressedImagePtr());
+    const uint8_t* uPlane = yPlane + IMAGE_WIDTH * IMAGE_HEIGHT;
+    const uint8_t* vPlane = uPlane + IMAGE_WIDTH * IMAGE_HEIGHT / 4;
+
+    JpegDecoderHelper rowDecoder;
+    ASSERT_TRUE(rowDecoder.startDecompressRows(mYuvIccImage.buffer.get(), mYuvIccImage.size));
+    EXPECT_EQ(rowDecoder.getDecompressedImageWidth(), IMAGE_WIDTH);
+    EXPECT_EQ(rowDecoder.getDecompressedImageHeight(), IMAGE_HEIGHT);
+    EXPECT_EQ(IccHelper::readIccColorGamut(rowDecoder.getICCPtr(), rowDecoder.getICCSize()),
+              ULTRAHDR_COLORGAMUT_BT709);
+
+    const size_t capacity = rowDecoder.getRowsCapacity();
+    size_t rowCount = 0;
+    int rows;
+    while ((rows = rowDecoder.decompressNextRows()) > 0) {
+        const size_t top = rowDecoder.getRowsTop();
+        ASSERT_EQ(top, rowCount);
+        ASSERT_LE(static_cast<size_t>(rows), capacity);
+        const uint8_t* uRows = rowDecoder.getRowsPtr(1);
+        const uint8_t* vRows = rowDecoder.getRowsPtr(2);
+        ASSERT_EQ(vRows, uRows + rowDecoder.getRowsStride(1) * capacity / 2);
+        for (int y = 0; y < rows; y++) {
+            ASSERT_EQ(memcmp(rowDecoder.getRowsPtr(0) + y * rowDecoder.getRowsStride(0),
+                             yPlane + (top + y) * IMAGE_WIDTH, IMAGE_WIDTH),
+                      0);
+        }
+        for (int y = 0; y < rows / 2; y++) {
+            const size_t offset = (top / 2 + y) * (IMAGE_WIDTH / 2);
+            ASSERT_EQ(memcmp(uRows + y * rowDecoder.getRowsStride(1), uPlane + offset,
+                             IMAGE_WIDTH / 2),
+                      0);
+            ASSERT_EQ(memcmp(vRows + y * rowDecoder.getRowsStride(2), vPlane + offset,
+                             IMAGE_WIDTH / 2),
+                      0);
+        }
+        rowCount += rows;
+    }
+    EXPECT_EQ(rows, 0);
+    EXPECT_EQ(rowCount, IMAGE_HEIGHT);
+}
+
+TEST_F(JpegDecoderHelperTest, decodeScaledImageRows) {
+    for (int scaleDenom : {2, 4, 8}) {
+        for (bool decodeToRGBA : {false, true}) {
+            JpegDecoderHelper decoder;
+            ASSERT_TRUE(decoder.startDecompressRows(mYuvImage.buffer.get(), mYuvImage.size,
+                                                    decodeToRGBA, scaleDenom));
+            EXPECT_EQ(decoder.getDecompressedImageWidth(), IMAGE_WIDTH / scaleDenom);
+            EXPECT_EQ(decoder.getDecompressedImageHeight(), IMAGE_HEIGHT / scaleDenom);
+            size_t rowCount = 0;
+            int rows;
+            while ((rows = decoder.decompressNextRows()) > 0) {
+                rowCount += rows;
+            }
+            EXPECT_EQ(rows, 0);
+            EXPECT_EQ(rowCount, IMAGE_HEIGHT / scaleDenom);
+        }
+    }
+
+    JpegDecoderHelper decoder;
+    EXPECT_FALSE(decoder.startDecompressRows(mYuvImage.buffer.get(), mYuvImage.size, false, 3));
+    EXPECT_FALSE(decoder.startDecompressRows(mGreyImage.buffer.get(), mGreyImage.size, true));
+}
+
 TEST_F(JpegDecoderHelperTest, getCompressedImageParameters) {
     size_t width = 0, height = 0;
     std::vector<uint8_t> icc, exif;
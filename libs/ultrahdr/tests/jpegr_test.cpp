@@ -15,6 +15,7 @@
  */
 
 #include <sys/time.h>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
@@ -294,6 +295,44 @@ static bool readFile(const char* fileName, void*& result, int maxLength, int& le
   return false;
 }
 
+// Checks that streaming decodes match the given RGBA_F16 output of decodeJPEGR().
+void decodeJpegRImgStreaming(jr_compressed_ptr img, const uint8_t* expected) {
+  const size_t bpp = 8;
+  JpegR jpegHdr;
+  std::unique_ptr<uint8_t[]> data = std::make_unique<uint8_t[]>(kImageWidth * kImageHeight * bpp);
+  jpegr_uncompressed_struct destImage{};
+  destImage.data = data.get();
+  ASSERT_EQ(OK, jpegHdr.decodeJPEGRStreaming(img, &destImage));
+  ASSERT_EQ(kImageWidth, destImage.width);
+  ASSERT_EQ(kImageHeight, destImage.height);
+  ASSERT_EQ(0, memcmp(data.get(), expected, kImageWidth * kImageHeight * bpp));
+
+  jpegr_region_struct region{kImageWidth / 4, kImageHeight / 3, kImageWidth / 2 + 1,
+                             kImageHeight / 2 + 3};
+  ASSERT_EQ(OK,
+            jpegHdr.decodeJPEGRStreaming(img, &destImage, FLT_MAX, ULTRAHDR_OUTPUT_HDR_LINEAR,
+                                         /* scale_denom */ 1, &region));
+  ASSERT_EQ(region.right - region.left, destImage.width);
+  ASSERT_EQ(region.bottom - region.top, destImage.height);
+  const size_t regionRowBytes = destImage.width * bpp;
+  for (int y = 0; y < destImage.height; y++) {
+    ASSERT_EQ(0,
+              memcmp(data.get() + y * regionRowBytes,
+                     expected + ((region.top + y) * kImageWidth + region.left) * bpp,
+                     regionRowBytes))
+            << "row " << y;
+  }
+
+  // Thumbnails are decoded at the scaled resolution, rounded up.
+  for (int scaleDenom : {2, 4, 8}) {
+    ASSERT_EQ(OK,
+              jpegHdr.decodeJPEGRStreaming(img, &destImage, FLT_MAX, ULTRAHDR_OUTPUT_HDR_HLG,
+                                           scaleDenom));
+    ASSERT_EQ((kImageWidth + scaleDenom - 1) / scaleDenom, destImage.width);
+    ASSERT_EQ((kImageHeight + scaleDenom - 1) / scaleDenom, destImage.height);
+  }
+}
+
 void decodeJpegRImg(jr_compressed_ptr img, [[maybe_unused]] const char* outFileName) {
   std::vector<uint8_t> iccData(0);
   std::vector<uint8_t> exifData(0);
@@ -314,6 +353,7 @@ void decodeJpegRImg(jr_compressed_ptr img, [[maybe_unused]] const char* outFileN
     std::cerr << "unable to write output file" << std::endl;
   }
 #endif
+  ASSERT_NO_FATAL_FAILURE(decodeJpegRImgStreaming(img, data.get()));
 }
 
 // ============================================================================
@@ -1342,6 +1382,44 @@ TEST(JpegRTest, DecodeAPIWithInvalidArgs) {
           << "fail, API allows invalid output format";
 }
 
+/* Test streaming Decode API invalid arguments */
+TEST(JpegRTest, DecodeStreamingAPIWithInvalidArgs) {
+  JpegR uHdrLib;
+
+  UhdrCompressedStructWrapper jpgImg(16, 16);
+  jpegr_uncompressed_struct destImage{};
+  size_t outSize = 16 * 16 * 8;
+  std::unique_ptr<uint8_t[]> data = std::make_unique<uint8_t[]>(outSize);
+  destImage.data = data.get();
+
+  // test jpegr image
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(nullptr, &destImage), OK)
+          << "fail, API allows nullptr for jpegr img";
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(jpgImg.getImageHandle(), &destImage), OK)
+          << "fail, API allows nullptr for jpegr img";
+  ASSERT_TRUE(jpgImg.allocateMemory());
+
+  // test dest image
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(jpgImg.getImageHandle(), nullptr), OK)
+          << "fail, API allows nullptr for dest";
+
+  // test max display boost
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(jpgImg.getImageHandle(), &destImage, 0.5), OK)
+          << "fail, API allows invalid max display boost";
+
+  // test output format
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(jpgImg.getImageHandle(), &destImage, FLT_MAX,
+                                         static_cast<ultrahdr_output_format>(-1)),
+            OK)
+          << "fail, API allows invalid output format";
+
+  // test scale denominator
+  ASSERT_NE(uHdrLib.decodeJPEGRStreaming(jpgImg.getImageHandle(), &destImage, FLT_MAX,
+                                         ULTRAHDR_OUTPUT_HDR_LINEAR, 3),
+            OK)
+          << "fail, API allows invalid scale denominator";
+}
+
 TEST(JpegRTest, writeXmpThenRead) {
   ultrahdr_metadata_struct metadata_expected;
   metadata_expected.version = "1.0";
@@ -1938,49 +2016,70 @@ private:
   struct timeval mEndingTime;
 };
 
+// The number of iterations per measurement defaults to kDefaultProfileCount and can be raised with
+// the ULTRAHDR_PROFILE_COUNT environment variable for more stable numbers.
 class JpegRBenchmark : public JpegR {
 public:
+  JpegRBenchmark();
   void BenchmarkGenerateGainMap(jr_uncompressed_ptr yuv420Image, jr_uncompressed_ptr p010Image,
-                                ultrahdr_metadata_ptr metadata, jr_uncompressed_ptr map);
+                                ultrahdr_transfer_function hdr_tf, ultrahdr_metadata_ptr metadata,
+                                jr_uncompressed_ptr map);
   void BenchmarkApplyGainMap(jr_uncompressed_ptr yuv420Image, jr_uncompressed_ptr map,
-                             ultrahdr_metadata_ptr metadata, jr_uncompressed_ptr dest);
+                             ultrahdr_metadata_ptr metadata, ultrahdr_output_format output_format,
+                             jr_uncompressed_ptr dest);
 
 private:
-  const int kProfileCount = 10;
+  static const int kDefaultProfileCount = 10;
+  int mProfileCount;
 };
 
+JpegRBenchmark::JpegRBenchmark() : mProfileCount(kDefaultProfileCount) {
+  const char* profileCount = getenv("ULTRAHDR_PROFILE_COUNT");
+  if (profileCount != nullptr && atoi(profileCount) > 0) {
+    mProfileCount = atoi(profileCount);
+  }
+}
+
+static float megapixelsPerSecond(int width, int height, float milliseconds) {
+  return milliseconds > 0.0f ? width * height / (milliseconds * 1000.0f) : 0.0f;
+}
+
 void JpegRBenchmark::BenchmarkGenerateGainMap(jr_uncompressed_ptr yuv420Image,
                                               jr_uncompressed_ptr p010Image,
+                                              ultrahdr_transfer_function hdr_tf,
                                               ultrahdr_metadata_ptr metadata,
                                               jr_uncompressed_ptr map) {
   ASSERT_EQ(yuv420Image->width, p010Image->width);
   ASSERT_EQ(yuv420Image->height, p010Image->height);
   Profiler profileGenerateMap;
   profileGenerateMap.timerStart();
-  for (auto i = 0; i < kProfileCount; i++) {
-    ASSERT_EQ(OK,
-              generateGainMap(yuv420Image, p010Image, ultrahdr_transfer_function::ULTRAHDR_TF_HLG,
-                              metadata, map));
-    if (i != kProfileCount - 1) delete[] static_cast<uint8_t*>(map->data);
+  for (auto i = 0; i < mProfileCount; i++) {
+    ASSERT_EQ(OK, generateGainMap(yuv420Image, p010Image, hdr_tf, metadata, map));
+    if (i != mProfileCount - 1) delete[] static_cast<uint8_t*>(map->data);
   }
   profileGenerateMap.timerStop();
-  ALOGE("Generate Gain Map:- Res = %i x %i, time = %f ms", yuv420Image->width, yuv420Image->height,
-        profileGenerateMap.elapsedTime() / (kProfileCount * 1000.f));
+  float time = profileGenerateMap.elapsedTime() / (mProfileCount * 1000.f);
+  ALOGE("Generate Gain Map:- Res = %i x %i, tf = %d, time = %f ms, %f MP/s", yuv420Image->width,
+        yuv420Image->height, hdr_tf, time,
+        megapixelsPerSecond(yuv420Image->width, yuv420Image->height, time));
 }
 
 void JpegRBenchmark::BenchmarkApplyGainMap(jr_uncompressed_ptr yuv420Image, jr_uncompressed_ptr map,
                                            ultrahdr_metadata_ptr metadata,
+                                           ultrahdr_output_format output_format,
                                            jr_uncompressed_ptr dest) {
   Profiler profileRecMap;
   profileRecMap.timerStart();
-  for (auto i = 0; i < kProfileCount; i++) {
+  for (auto i = 0; i < mProfileCount; i++) {
     ASSERT_EQ(OK,
-              applyGainMap(yuv420Image, map, metadata, ULTRAHDR_OUTPUT_HDR_HLG,
+              applyGainMap(yuv420Image, map, metadata, output_format,
                            metadata->maxContentBoost /* displayBoost */, dest));
   }
   profileRecMap.timerStop();
-  ALOGE("Apply Gain Map:- Res = %i x %i, time = %f ms", yuv420Image->width, yuv420Image->height,
-        profileRecMap.elapsedTime() / (kProfileCount * 1000.f));
+  float time = profileRecMap.elapsedTime() / (mProfileCount * 1000.f);
+  ALOGE("Apply Gain Map:- Res = %i x %i, output format = %d, time = %f ms, %f MP/s",
+        yuv420Image->width, yuv420Image->height, output_format, time,
+        megapixelsPerSecond(yuv420Image->width, yuv420Image->height, time));
 }
 
 TEST(JpegRTest, ProfileGainMapFuncs) {
@@ -2017,19 +2116,27 @@ TEST(JpegRTest, ProfileGainMapFuncs) {
   }
 
   JpegRBenchmark benchmark;
-  ASSERT_NO_FATAL_FAILURE(benchmark.BenchmarkGenerateGainMap(rawImg420.getImageHandle(),
-                                                             rawImgP010.getImageHandle(), &metadata,
-                                                             &map));
+  for (auto hdr_tf : {ULTRAHDR_TF_LINEAR, ULTRAHDR_TF_PQ, ULTRAHDR_TF_HLG}) {
+    if (map.data != nullptr) delete[] static_cast<uint8_t*>(map.data);
+    ASSERT_NO_FATAL_FAILURE(benchmark.BenchmarkGenerateGainMap(rawImg420.getImageHandle(),
+                                                               rawImgP010.getImageHandle(), hdr_tf,
+                                                               &metadata, &map));
+  }
+  std::unique_ptr<uint8_t[]> mapData(static_cast<uint8_t*>(map.data));
 
-  const int dstSize = kImageWidth * kImageWidth * 4;
+  // Large enough for the 8 bytes per pixel of ULTRAHDR_OUTPUT_HDR_LINEAR.
+  const int dstSize = kImageWidth * kImageHeight * 8;
   auto bufferDst = std::make_unique<uint8_t[]>(dstSize);
   jpegr_uncompressed_struct dest = {.data = bufferDst.get(),
                                     .width = 0,
                                     .height = 0,
                                     .colorGamut = ULTRAHDR_COLORGAMUT_UNSPECIFIED};
 
-  ASSERT_NO_FATAL_FAILURE(
-          benchmark.BenchmarkApplyGainMap(rawImg420.getImageHandle(), &map, &metadata, &dest));
+  for (auto output_format :
+       {ULTRAHDR_OUTPUT_HDR_LINEAR, ULTRAHDR_OUTPUT_HDR_PQ, ULTRAHDR_OUTPUT_HDR_HLG}) {
+    ASSERT_NO_FATAL_FAILURE(benchmark.BenchmarkApplyGainMap(rawImg420.getImageHandle(), &map,
+                                                            &metadata, output_format, &dest));
+  }
 }
 
 } // namespace android::ultrahdr
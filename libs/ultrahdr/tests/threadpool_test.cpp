@@ -0,0 +1,160 @@
+/*
+ * Copyright 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ultrahdr/threadpool.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+
+namespace android::ultrahdr {
+
+// Runs forEachTile() and checks that every element of the area is covered by exactly one tile.
+static void expectEachElementVisitedOnce(ThreadPool& pool, size_t width, size_t height,
+                                         size_t tileWidth, size_t tileHeight,
+                                         size_t maxParallelism = 0) {
+  std::vector<std::atomic<int>> visits(width * height);
+  std::atomic<size_t> tileCount = 0;
+  pool.forEachTile(
+          width, height, tileWidth, tileHeight,
+          [&](const Tile& tile) {
+            EXPECT_LT(tile.left, tile.right);
+            EXPECT_LT(tile.top, tile.bottom);
+            EXPECT_LE(tile.right, width);
+            EXPECT_LE(tile.bottom, height);
+            EXPECT_LE(tile.right - tile.left, tileWidth);
+            EXPECT_LE(tile.bottom - tile.top, tileHeight);
+            for (size_t y = tile.top; y < tile.bottom; y++) {
+              for (size_t x = tile.left; x < tile.right; x++) {
+                visits[y * width + x]++;
+              }
+            }
+            tileCount++;
+          },
+          maxParallelism);
+
+  EXPECT_EQ(tileCount,
+            ((width + tileWidth - 1) / tileWidth) * ((height + tileHeight - 1) / tileHeight));
+  for (size_t i = 0; i < visits.size(); i++) {
+    ASSERT_EQ(visits[i], 1) << "element " << i % width << "," << i / width;
+  }
+}
+
+TEST(ThreadPoolTest, coversAreaWithoutWorkers) {
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.getMaxParallelism(), 1u);
+  expectEachElementVisitedOnce(pool, 100, 50, 16, 16);
+}
+
+TEST(ThreadPoolTest, coversArea) {
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.getMaxParallelism(), 4u);
+  expectEachElementVisitedOnce(pool, 100, 50, 16, 16);
+  expectEachElementVisitedOnce(pool, 1280, 720, 256, 16);
+  expectEachElementVisitedOnce(pool, 7, 3, 1, 1);
+  expectEachElementVisitedOnce(pool, 64, 64, 64, 64);
+  expectEachElementVisitedOnce(pool, 10, 10, 100, 100);
+}
+
+TEST(ThreadPoolTest, ignoresEmptyArea) {
+  ThreadPool pool(2);
+  bool called = false;
+  pool.forEachTile(0, 10, 4, 4, [&](const Tile&) { called = true; });
+  pool.forEachTile(10, 0, 4, 4, [&](const Tile&) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ThreadPoolTest, limitsParallelism) {
+  ThreadPool pool(3);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  pool.forEachTile(
+          64, 64, 1, 1,
+          [&](const Tile&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+          },
+          1);
+  ASSERT_EQ(threads.size(), 1u);
+  EXPECT_EQ(*threads.begin(), std::this_thread::get_id());
+
+  expectEachElementVisitedOnce(pool, 100, 50, 8, 8, 2);
+}
+
+TEST(ThreadPoolTest, usesWorkers) {
+  ThreadPool pool(3);
+  std::atomic<int> running = 0;
+  std::atomic<int> maxRunning = 0;
+  pool.forEachTile(4, 1, 1, 1, [&](const Tile&) {
+    int now = ++running;
+    int prev = maxRunning;
+    while (now > prev && !maxRunning.compare_exchange_weak(prev, now)) {
+    }
+    // Give the other threads time to pick up their tiles.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    running--;
+  });
+  EXPECT_GT(maxRunning, 1);
+}
+
+TEST(ThreadPoolTest, stealsFromBusyThreads) {
+  ThreadPool pool(1);
+  // The first half of the tiles belongs to the calling thread, which stalls on its first tile;
+  // the worker has to take over the rest of that half.
+  std::atomic<int> workerTiles = 0;
+  const std::thread::id caller = std::this_thread::get_id();
+  pool.forEachTile(16, 1, 1, 1, [&](const Tile& tile) {
+    if (std::this_thread::get_id() == caller) {
+      if (tile.left == 0) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } else {
+      workerTiles++;
+    }
+  });
+  EXPECT_GT(workerTiles, 8);
+}
+
+TEST(ThreadPoolTest, supportsConcurrentCalls) {
+  ThreadPool pool(2);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; i++) {
+    callers.emplace_back([&pool]() {
+      for (int j = 0; j < 20; j++) {
+        expectEachElementVisitedOnce(pool, 64, 32, 8, 4);
+      }
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+}
+
+TEST(ThreadPoolTest, supportsNestedCalls) {
+  ThreadPool pool(2);
+  std::atomic<int> innerTiles = 0;
+  pool.forEachTile(4, 1, 1, 1, [&](const Tile&) {
+    pool.forEachTile(8, 8, 2, 2, [&](const Tile&) { innerTiles++; });
+  });
+  EXPECT_EQ(innerTiles, 4 * 16);
+}
+
+TEST(ThreadPoolTest, sharedInstanceUsesAllCores) {
+  EXPECT_EQ(&ThreadPool::getInstance(), &ThreadPool::getInstance());
+  EXPECT_EQ(ThreadPool::getInstance().getMaxParallelism(),
+            static_cast<size_t>(std::max(GetCPUCoreCount(), 1)));
+}
+
+} // namespace android::ultrahdr
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+
+#include <ultrahdr/threadpool.h>
+
+namespace android::ultrahdr {
+
+#define CONFIG_MULTITHREAD 1
+int GetCPUCoreCount() {
+  int cpuCoreCount = 1;
+#if CONFIG_MULTITHREAD
+#if defined(_SC_NPROCESSORS_ONLN)
+  cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+  // _SC_NPROC_ONLN must be defined...
+  cpuCoreCount = sysconf(_SC_NPROC_ONLN);
+#endif
+#endif
+  return cpuCoreCount;
+}
+
+// One call to forEachTile(). Tiles are numbered row by row and every participant owns a slot
+// holding a range [next, end) of tile indices. Owners take tiles from the front of their range,
+// thieves take them from the back.
+struct ThreadPool::Batch {
+  struct Slot {
+    std::mutex mutex;
+    size_t next = 0;
+    size_t end = 0;
+  };
+
+  Batch(size_t width, size_t height, size_t tileWidth, size_t tileHeight,
+        const std::function<void(const Tile&)>& fn, size_t slotCount)
+        : width(width),
+          height(height),
+          tileWidth(tileWidth),
+          tileHeight(tileHeight),
+          tilesPerRow((width + tileWidth - 1) / tileWidth),
+          tileCount(tilesPerRow * ((height + tileHeight - 1) / tileHeight)),
+          fn(fn),
+          slots(new Slot[slotCount]),
+          slotCount(slotCount),
+          remaining(tileCount) {
+    for (size_t i = 0; i < slotCount; i++) {
+      slots[i].next = i * tileCount / slotCount;
+      slots[i].end = (i + 1) * tileCount / slotCount;
+    }
+  }
+
+  Tile getTile(size_t index) const {
+    const size_t left = (index % tilesPerRow) * tileWidth;
+    const size_t top = (index / tilesPerRow) * tileHeight;
+    return {left, top, std::min(left + tileWidth, width), std::min(top + tileHeight, height)};
+  }
+
+  // Takes the next tile of the given slot, stealing from another slot if it has none left.
+  // Returns false once no slot has any tile left.
+  bool takeTile(size_t slot, size_t& index) {
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(slots[slot].mutex);
+        if (slots[slot].next < slots[slot].end) {
+          index = slots[slot].next++;
+          return true;
+        }
+      }
+
+      size_t victim = slot;
+      size_t victimCount = 0;
+      for (size_t i = 0; i < slotCount; i++) {
+        if (i == slot) continue;
+        std::lock_guard<std::mutex> lock(slots[i].mutex);
+        if (slots[i].end - slots[i].next > victimCount) {
+          victim = i;
+          victimCount = slots[i].end - slots[i].next;
+        }
+      }
+      if (victimCount == 0) {
+        return false;
+      }
+
+      size_t stolenBegin, stolenEnd;
+      {
+        std::lock_guard<std::mutex> lock(slots[victim].mutex);
+        const size_t count = slots[victim].end - slots[victim].next;
+        if (count == 0) {
+          // Drained by its owner or another thief in the meantime; look again.
+          continue;
+        }
+        stolenEnd = slots[victim].end;
+        stolenBegin = stolenEnd - (count + 1) / 2;
+        slots[victim].end = stolenBegin;
+      }
+
+      std::lock_guard<std::mutex> lock(slots[slot].mutex);
+      slots[slot].next = stolenBegin + 1;
+      slots[slot].end = stolenEnd;
+      index = stolenBegin;
+      return true;
+    }
+  }
+
+  const size_t width;
+  const size_t height;
+  const size_t tileWidth;
+  const size_t tileHeight;
+  const size_t tilesPerRow;
+  const size_t tileCount;
+  // Only called while tiles are left, i.e. while the caller of forEachTile() is still waiting.
+  const std::function<void(const Tile&)>& fn;
+  std::unique_ptr<Slot[]> slots;
+  const size_t slotCount;
+  // Number of participants that have claimed a slot; guarded by ThreadPool::mMutex.
+  size_t joined = 1;
+
+  std::mutex doneMutex;
+  std::condition_variable doneCv;
+  size_t remaining;
+};
+
+ThreadPool::ThreadPool(size_t workerCount) {
+  mWorkers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; i++) {
+    mWorkers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mExiting = true;
+  }
+  mCv.notify_all();
+  for (std::thread& worker : mWorkers) {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::getInstance() {
+  // Never destroyed, so that no worker is joined during static destruction.
+  static ThreadPool* sInstance = new ThreadPool(std::max(GetCPUCoreCount(), 1) - 1);
+  return *sInstance;
+}
+
+void ThreadPool::forEachTile(size_t width, size_t height, size_t tileWidth, size_t tileHeight,
+                             const std::function<void(const Tile&)>& fn, size_t maxParallelism) {
+  if (width == 0 || height == 0) {
+    return;
+  }
+  tileWidth = std::clamp(tileWidth, (size_t)1, width);
+  tileHeight = std::clamp(tileHeight, (size_t)1, height);
+  const size_t tileCount =
+          ((width + tileWidth - 1) / tileWidth) * ((height + tileHeight - 1) / tileHeight);
+
+  size_t parallelism = getMaxParallelism();
+  if (maxParallelism > 0) parallelism = std::min(parallelism, maxParallelism);
+  parallelism = std::min(parallelism, tileCount);
+
+  if (parallelism <= 1) {
+    for (size_t top = 0; top < height; top += tileHeight) {
+      for (size_t left = 0; left < width; left += tileWidth) {
+        fn({left, top, std::min(left + tileWidth, width),
+            std::min(top + tileHeight, height)});
+      }
+    }
+    return;
+  }
+
+  auto batch = std::make_shared<Batch>(width, height, tileWidth, tileHeight, fn, parallelism);
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBatches.push_back(batch);
+  }
+  if (parallelism - 1 >= mWorkers.size()) {
+    mCv.notify_all();
+  } else {
+    for (size_t i = 0; i < parallelism - 1; i++) {
+      mCv.notify_one();
+    }
+  }
+
+  runTiles(*batch, 0);
+
+  {
+    // Every tile has been taken, so workers that have not joined yet have nothing left to do.
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = std::find(mBatches.begin(), mBatches.end(), batch);
+    if (it != mBatches.end()) {
+      mBatches.erase(it);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(batch->doneMutex);
+  batch->doneCv.wait(lock, [&batch]() { return batch->remaining == 0; });
+}
+
+void ThreadPool::workerLoop() {
+  while (true) {
+    std::shared_ptr<Batch> batch;
+    size_t slot;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCv.wait(lock, [this]() { return mExiting || !mBatches.empty(); });
+      if (mExiting) {
+        return;
+      }
+      batch = mBatches.front();
+      slot = batch->joined++;
+      if (batch->joined >= batch->slotCount) {
+        mBatches.pop_front();
+      }
+    }
+    runTiles(*batch, slot);
+  }
+}
+
+void ThreadPool::runTiles(Batch& batch, size_t slot) {
+  size_t done = 0;
+  size_t index;
+  while (batch.takeTile(slot, index)) {
+    batch.fn(batch.getTile(index));
+    done++;
+  }
+  if (done == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(batch.doneMutex);
+  batch.remaining -= done;
+  if (batch.remaining == 0) {
+    batch.doneCv.notify_all();
+  }
+}
+
+} // namespace android::ultrahdr
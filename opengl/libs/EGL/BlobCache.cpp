@@ -23,10 +23,9 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <log/log.h>
+#include <string.h>
 #include <utils/Trace.h>
 
-#include <chrono>
-
 namespace android {
 
 // BlobCache::Header::mMagicNumber value
@@ -42,20 +41,21 @@ BlobCache::BlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxTotalSize
       : mMaxTotalSize(maxTotalSize),
         mMaxKeySize(maxKeySize),
         mMaxValueSize(maxValueSize),
-        mTotalSize(0) {
-    int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
-#ifdef _WIN32
-    srand(now);
-#else
-    mRandState[0] = (now >> 0) & 0xFFFF;
-    mRandState[1] = (now >> 16) & 0xFFFF;
-    mRandState[2] = (now >> 32) & 0xFFFF;
-#endif
-    ALOGV("initializing random seed using %lld", (unsigned long long)now);
-}
+        mTotalSize(0) {}
 
 BlobCache::InsertResult BlobCache::set(const void* key, size_t keySize, const void* value,
                                        size_t valueSize) {
+    return insert(key, keySize, value, valueSize, nullptr);
+}
+
+BlobCache::InsertResult BlobCache::setUnverified(const void* key, size_t keySize,
+                                                 const void* value, size_t valueSize,
+                                                 uint32_t checksum) {
+    return insert(key, keySize, value, valueSize, &checksum);
+}
+
+BlobCache::InsertResult BlobCache::insert(const void* key, size_t keySize, const void* value,
+                                          size_t valueSize, const uint32_t* checksum) {
     if (mMaxKeySize < keySize) {
         ALOGV("set: not caching because the key is too large: %zu (limit: %zu)", keySize,
               mMaxKeySize);
@@ -81,21 +81,18 @@ BlobCache::InsertResult BlobCache::set(const void* key, size_t keySize, const vo
         return InsertResult::kInvalidValueSize;
     }
 
-    std::shared_ptr<Blob> cacheKey(new Blob(key, keySize, false));
-    CacheEntry cacheEntry(cacheKey, nullptr);
+    std::string_view keyView(static_cast<const char*>(key), keySize);
 
     bool didClean = false;
     while (true) {
-        auto index = std::lower_bound(mCacheEntries.begin(), mCacheEntries.end(), cacheEntry);
-        if (index == mCacheEntries.end() || cacheEntry < *index) {
+        auto index = mCacheIndex.find(keyView);
+        if (index == mCacheIndex.end()) {
             // Create a new cache entry.
-            std::shared_ptr<Blob> keyBlob(new Blob(key, keySize, true));
-            std::shared_ptr<Blob> valueBlob(new Blob(value, valueSize, true));
             size_t newTotalSize = mTotalSize + keySize + valueSize;
             if (mMaxTotalSize < newTotalSize) {
                 if (isCleanable()) {
                     // Clean the cache and try again.
-                    clean();
+                    clean(keySize + valueSize);
                     didClean = true;
                     continue;
                 } else {
@@ -106,19 +103,29 @@ BlobCache::InsertResult BlobCache::set(const void* key, size_t keySize, const vo
                     return InsertResult::kNotEnoughSpace;
                 }
             }
-            mCacheEntries.insert(index, CacheEntry(keyBlob, valueBlob));
+            std::shared_ptr<Blob> keyBlob(new Blob(key, keySize, checksum == nullptr));
+            std::shared_ptr<Blob> valueBlob(new Blob(value, valueSize, checksum == nullptr));
+            mCacheEntries.emplace_front(keyBlob, valueBlob);
+            if (checksum != nullptr) {
+                mCacheEntries.front().setChecksum(*checksum);
+            }
+            mCacheIndex.emplace(std::string_view(static_cast<const char*>(keyBlob->getData()),
+                                                 keySize),
+                                mCacheEntries.begin());
             mTotalSize = newTotalSize;
             ALOGV("set: created new cache entry with %zu byte key and %zu byte value", keySize,
                   valueSize);
         } else {
-            // Update the existing cache entry.
-            std::shared_ptr<Blob> valueBlob(new Blob(value, valueSize, true));
-            std::shared_ptr<Blob> oldValueBlob(index->getValue());
+            // Update the existing cache entry. Move it to the front first so
+            // that cleaning evicts it last.
+            auto entry = index->second;
+            mCacheEntries.splice(mCacheEntries.begin(), mCacheEntries, entry);
+            std::shared_ptr<Blob> oldValueBlob(entry->getValue());
             size_t newTotalSize = mTotalSize + valueSize - oldValueBlob->getSize();
             if (mMaxTotalSize < newTotalSize) {
                 if (isCleanable()) {
                     // Clean the cache and try again.
-                    clean();
+                    clean(valueSize - oldValueBlob->getSize());
                     didClean = true;
                     continue;
                 } else {
@@ -128,7 +135,11 @@ BlobCache::InsertResult BlobCache::set(const void* key, size_t keySize, const vo
                     return InsertResult::kNotEnoughSpace;
                 }
             }
-            index->setValue(valueBlob);
+            std::shared_ptr<Blob> valueBlob(new Blob(value, valueSize, checksum == nullptr));
+            entry->setValue(valueBlob);
+            if (checksum != nullptr) {
+                entry->setChecksum(*checksum);
+            }
             mTotalSize = newTotalSize;
             ALOGV("set: updated existing cache entry with %zu byte key and %zu byte "
                   "value",
@@ -144,17 +155,28 @@ size_t BlobCache::get(const void* key, size_t keySize, void* value, size_t value
               mMaxKeySize);
         return 0;
     }
-    std::shared_ptr<Blob> cacheKey(new Blob(key, keySize, false));
-    CacheEntry cacheEntry(cacheKey, nullptr);
-    auto index = std::lower_bound(mCacheEntries.begin(), mCacheEntries.end(), cacheEntry);
-    if (index == mCacheEntries.end() || cacheEntry < *index) {
+    auto index = mCacheIndex.find(std::string_view(static_cast<const char*>(key), keySize));
+    if (index == mCacheIndex.end()) {
         ALOGV("get: no cache entry found for key of size %zu", keySize);
         return 0;
     }
 
-    // The key was found. Return the value if the caller's buffer is large
-    // enough.
-    std::shared_ptr<Blob> valueBlob(index->getValue());
+    // The key was found. Mark the entry as the most recently used one and
+    // return the value if the caller's buffer is large enough.
+    auto entry = index->second;
+    if (!entry->isVerified()) {
+        std::shared_ptr<Blob> const& keyBlob = entry->getKey();
+        std::shared_ptr<Blob> const& valueBlob = entry->getValue();
+        if (!verifyEntry(keyBlob->getData(), keyBlob->getSize(), valueBlob->getData(),
+                         valueBlob->getSize(), entry->getChecksum())) {
+            ALOGE("get: dropping cache entry that failed verification");
+            removeEntry(entry);
+            return 0;
+        }
+        entry->setVerified();
+    }
+    mCacheEntries.splice(mCacheEntries.begin(), mCacheEntries, entry);
+    std::shared_ptr<Blob> valueBlob(entry->getValue());
     size_t valueBlobSize = valueBlob->getSize();
     if (valueBlobSize <= valueSize) {
         ALOGV("get: copying %zu bytes to caller's buffer", valueBlobSize);
@@ -196,10 +218,12 @@ int BlobCache::flatten(void* buffer, size_t size) const {
     header->mBuildIdLength = buildId.size();
     memcpy(header->mBuildId, buildId.c_str(), header->mBuildIdLength);
 
-    // Write cache entries
+    // Write cache entries from the least to the most recently used one, so that
+    // unflatten restores the recency order.
     uint8_t* byteBuffer = reinterpret_cast<uint8_t*>(buffer);
     off_t byteOffset = align4(sizeof(Header) + header->mBuildIdLength);
-    for (const CacheEntry& e : mCacheEntries) {
+    for (auto it = mCacheEntries.rbegin(); it != mCacheEntries.rend(); ++it) {
+        const CacheEntry& e = *it;
         std::shared_ptr<Blob> const& keyBlob = e.getKey();
         std::shared_ptr<Blob> const& valueBlob = e.getValue();
         size_t keySize = keyBlob->getSize();
@@ -288,24 +312,58 @@ int BlobCache::unflatten(void const* buffer, size_t size) {
     return 0;
 }
 
-long int BlobCache::blob_random() {
-#ifdef _WIN32
-    return rand();
-#else
-    return nrand48(mRandState);
-#endif
+void BlobCache::clean(size_t spaceNeeded) {
+    ATRACE_NAME("BlobCache::clean");
+
+    // Remove the least recently used cache entry until the total cache size
+    // gets below half the maximum total cache size and there is room for the
+    // pending entry.
+    while (!mCacheEntries.empty() &&
+           (mTotalSize > mMaxTotalSize / 2 || mTotalSize + spaceNeeded > mMaxTotalSize)) {
+        removeEntry(std::prev(mCacheEntries.end()));
+    }
 }
 
-void BlobCache::clean() {
-    ATRACE_NAME("BlobCache::clean");
+void BlobCache::removeEntry(std::list<CacheEntry>::iterator entry) {
+    std::shared_ptr<Blob> const& keyBlob = entry->getKey();
+    mCacheIndex.erase(
+            std::string_view(static_cast<const char*>(keyBlob->getData()), keyBlob->getSize()));
+    mTotalSize -= keyBlob->getSize() + entry->getValue()->getSize();
+    mCacheEntries.erase(entry);
+}
+
+bool BlobCache::verifyEntry(const void* /*key*/, size_t /*keySize*/, const void* /*value*/,
+                            size_t /*valueSize*/, uint32_t /*checksum*/) const {
+    return true;
+}
 
-    // Remove a random cache entry until the total cache size gets below half
-    // the maximum total cache size.
-    while (mTotalSize > mMaxTotalSize / 2) {
-        size_t i = size_t(blob_random() % (mCacheEntries.size()));
-        const CacheEntry& entry(mCacheEntries[i]);
-        mTotalSize -= entry.getKey()->getSize() + entry.getValue()->getSize();
-        mCacheEntries.erase(mCacheEntries.begin() + i);
+void BlobCache::verifyEntries() {
+    ATRACE_NAME("BlobCache::verifyEntries");
+
+    for (auto entry = mCacheEntries.begin(); entry != mCacheEntries.end();) {
+        auto next = std::next(entry);
+        if (!entry->isVerified()) {
+            std::shared_ptr<Blob> const& keyBlob = entry->getKey();
+            std::shared_ptr<Blob> const& valueBlob = entry->getValue();
+            if (verifyEntry(keyBlob->getData(), keyBlob->getSize(), valueBlob->getData(),
+                            valueBlob->getSize(), entry->getChecksum())) {
+                entry->setVerified();
+            } else {
+                ALOGE("verifyEntries: dropping cache entry that failed verification");
+                removeEntry(entry);
+            }
+        }
+        entry = next;
+    }
+}
+
+void BlobCache::forEachEntry(const EntryVisitor& visitor) const {
+    for (auto it = mCacheEntries.rbegin(); it != mCacheEntries.rend(); ++it) {
+        std::shared_ptr<Blob> const& keyBlob = it->getKey();
+        std::shared_ptr<Blob> const& valueBlob = it->getValue();
+        uint32_t checksum = it->getChecksum();
+        visitor(keyBlob->getData(), keyBlob->getSize(), valueBlob->getData(), valueBlob->getSize(),
+                it->hasChecksum() ? &checksum : nullptr);
     }
 }
 
@@ -326,14 +384,6 @@ BlobCache::Blob::~Blob() {
     }
 }
 
-bool BlobCache::Blob::operator<(const Blob& rhs) const {
-    if (mSize == rhs.mSize) {
-        return memcmp(mData, rhs.mData, mSize) < 0;
-    } else {
-        return mSize < rhs.mSize;
-    }
-}
-
 const void* BlobCache::Blob::getData() const {
     return mData;
 }
@@ -348,15 +398,19 @@ BlobCache::CacheEntry::CacheEntry(const std::shared_ptr<Blob>& key,
                                   const std::shared_ptr<Blob>& value)
       : mKey(key), mValue(value) {}
 
-BlobCache::CacheEntry::CacheEntry(const CacheEntry& ce) : mKey(ce.mKey), mValue(ce.mValue) {}
-
-bool BlobCache::CacheEntry::operator<(const CacheEntry& rhs) const {
-    return *mKey < *rhs.mKey;
-}
+BlobCache::CacheEntry::CacheEntry(const CacheEntry& ce)
+      : mKey(ce.mKey),
+        mValue(ce.mValue),
+        mHasChecksum(ce.mHasChecksum),
+        mChecksum(ce.mChecksum),
+        mVerified(ce.mVerified) {}
 
 const BlobCache::CacheEntry& BlobCache::CacheEntry::operator=(const CacheEntry& rhs) {
     mKey = rhs.mKey;
     mValue = rhs.mValue;
+    mHasChecksum = rhs.mHasChecksum;
+    mChecksum = rhs.mChecksum;
+    mVerified = rhs.mVerified;
     return *this;
 }
 
@@ -370,6 +424,31 @@ std::shared_ptr<BlobCache::Blob> BlobCache::CacheEntry::getValue() const {
 
 void BlobCache::CacheEntry::setValue(const std::shared_ptr<Blob>& value) {
     mValue = value;
+    mHasChecksum = false;
+    mChecksum = 0;
+    mVerified = true;
+}
+
+bool BlobCache::CacheEntry::hasChecksum() const {
+    return mHasChecksum;
+}
+
+uint32_t BlobCache::CacheEntry::getChecksum() const {
+    return mChecksum;
+}
+
+bool BlobCache::CacheEntry::isVerified() const {
+    return mVerified;
+}
+
+void BlobCache::CacheEntry::setChecksum(uint32_t checksum) {
+    mHasChecksum = true;
+    mChecksum = checksum;
+    mVerified = false;
+}
+
+void BlobCache::CacheEntry::setVerified() {
+    mVerified = true;
 }
 
 } // namespace android
@@ -19,14 +19,21 @@
 
 #include <stddef.h>
 
+#include <functional>
+#include <list>
 #include <memory>
-#include <vector>
+#include <string_view>
+#include <unordered_map>
 
 namespace android {
 
 // A BlobCache is an in-memory cache for binary key/value pairs.  A BlobCache
 // does NOT provide any thread-safety guarantees.
 //
+// Entries are indexed by a hash of their key, so get and set take constant
+// time regardless of the number of entries.  When the cache is full, the least
+// recently used entries are evicted first.
+//
 // The cache contents can be serialized to an in-memory buffer or mmap'd file
 // and then reloaded in a subsequent execution of the program.  This
 // serialization is non-portable and the data should only be used by the device
@@ -39,6 +46,8 @@ public:
     // (key sizes plus value sizes) will not exceed maxTotalSize.
     BlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxTotalSize);
 
+    virtual ~BlobCache() = default;
+
     // Return value from set(), below.
     enum class InsertResult {
         // The key is larger than maxKeySize specified in the constructor.
@@ -118,11 +127,40 @@ public:
     // clear flushes out all contents of the cache then the BlobCache, leaving
     // it in an empty state.
     void clear() {
+        mCacheIndex.clear();
         mCacheEntries.clear();
         mTotalSize = 0;
     }
 
 protected:
+    // setUnverified inserts a key/value pair like set, but references the key
+    // and value memory instead of copying it, so the memory must remain valid
+    // until the entry is evicted or the cache is cleared.  The entry is checked
+    // against checksum with verifyEntry the first time it is read, and dropped
+    // from the cache if the check fails.
+    InsertResult setUnverified(const void* key, size_t keySize, const void* value,
+                               size_t valueSize, uint32_t checksum);
+
+    // verifyEntry returns whether the key and value of an entry inserted with
+    // setUnverified match the checksum it was inserted with.  The default
+    // implementation accepts every entry.
+    virtual bool verifyEntry(const void* key, size_t keySize, const void* value, size_t valueSize,
+                             uint32_t checksum) const;
+
+    // verifyEntries checks all entries inserted with setUnverified that have
+    // not been read yet, and drops the ones that fail the check.
+    void verifyEntries();
+
+    // An EntryVisitor is called by forEachEntry for a single cache entry.
+    // checksum points to the checksum the entry was inserted with by
+    // setUnverified, or is nullptr if the entry has no known checksum.
+    using EntryVisitor = std::function<void(const void* key, size_t keySize, const void* value,
+                                            size_t valueSize, const uint32_t* checksum)>;
+
+    // forEachEntry calls visitor for every entry in the cache, from the least to
+    // the most recently used one.  It does not verify the entries.
+    void forEachEntry(const EntryVisitor& visitor) const;
+
     // mMaxTotalSize is the maximum size that all cache entries can occupy. This
     // includes space for both keys and values. When a call to BlobCache::set
     // would otherwise cause this limit to be exceeded, either the key/value
@@ -135,12 +173,16 @@ private:
     BlobCache(const BlobCache&);
     void operator=(const BlobCache&);
 
-    // A random function helper to get around MinGW not having nrand48()
-    long int blob_random();
+    // insert implements set and setUnverified.  If checksum is nullptr the key
+    // and value are copied, otherwise they are referenced and the entry is
+    // verified on first access.
+    InsertResult insert(const void* key, size_t keySize, const void* value, size_t valueSize,
+                        const uint32_t* checksum);
 
-    // clean evicts a randomly chosen set of entries from the cache such that
-    // the total size of all remaining entries is less than mMaxTotalSize/2.
-    void clean();
+    // clean evicts the least recently used entries from the cache until the
+    // total size of all remaining entries is less than mMaxTotalSize/2 and an
+    // entry of spaceNeeded bytes fits into the cache.
+    void clean(size_t spaceNeeded);
 
     // isCleanable returns true if the cache is full enough for the clean method
     // to have some effect, and false otherwise.
@@ -152,8 +194,6 @@ private:
         Blob(const void* data, size_t size, bool copyData);
         ~Blob();
 
-        bool operator<(const Blob& rhs) const;
-
         const void* getData() const;
         size_t getSize() const;
 
@@ -180,7 +220,6 @@ private:
         CacheEntry(const std::shared_ptr<Blob>& key, const std::shared_ptr<Blob>& value);
         CacheEntry(const CacheEntry& ce);
 
-        bool operator<(const CacheEntry& rhs) const;
         const CacheEntry& operator=(const CacheEntry&);
 
         std::shared_ptr<Blob> getKey() const;
@@ -188,14 +227,34 @@ private:
 
         void setValue(const std::shared_ptr<Blob>& value);
 
+        bool hasChecksum() const;
+        uint32_t getChecksum() const;
+        bool isVerified() const;
+
+        void setChecksum(uint32_t checksum);
+        void setVerified();
+
     private:
         // mKey is the key that identifies the cache entry.
         std::shared_ptr<Blob> mKey;
 
         // mValue is the cached data associated with the key.
         std::shared_ptr<Blob> mValue;
+
+        // mHasChecksum is true if the entry was inserted by setUnverified and
+        // its value has not been replaced since.  mChecksum is the checksum it
+        // was inserted with.
+        bool mHasChecksum = false;
+        uint32_t mChecksum = 0;
+
+        // mVerified is false until an entry with a checksum has been checked
+        // against it.
+        bool mVerified = true;
     };
 
+    // removeEntry evicts a single entry from the cache.
+    void removeEntry(std::list<CacheEntry>::iterator entry);
+
     // A Header is the header for the entire BlobCache serialization format. No
     // need to make this portable, so we simply write the struct out.
     struct Header {
@@ -256,13 +315,14 @@ private:
     // the cache.
     size_t mTotalSize;
 
-    // mRandState is the pseudo-random number generator state. It is passed to
-    // nrand48 to generate random numbers when needed.
-    unsigned short mRandState[3];
+    // mCacheEntries stores all the cache entries that are resident in memory,
+    // ordered from the most to the least recently used one. Cache entries are
+    // added to it by the 'set' method and moved to the front by 'get' and 'set'.
+    std::list<CacheEntry> mCacheEntries;
 
-    // mCacheEntries stores all the cache entries that are resident in memory.
-    // Cache entries are added to it by the 'set' method.
-    std::vector<CacheEntry> mCacheEntries;
+    // mCacheIndex maps the key data of every entry in mCacheEntries to the
+    // entry. The keys point into the key blobs of the entries.
+    std::unordered_map<std::string_view, std::list<CacheEntry>::iterator> mCacheIndex;
 };
 
 } // namespace android
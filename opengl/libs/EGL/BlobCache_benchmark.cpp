@@ -0,0 +1,111 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "BlobCache.h"
+
+namespace android {
+namespace {
+
+// Sizes in the range of what the shader cache stores: SHA-1 sized keys and
+// program binaries of a few kilobytes.
+constexpr size_t kKeySize = 20;
+constexpr size_t kValueSize = 4 * 1024;
+constexpr size_t kMaxValueSize = 64 * 1024;
+
+std::vector<uint8_t> makeKey(uint32_t i) {
+    std::vector<uint8_t> key(kKeySize, 0);
+    memcpy(key.data(), &i, sizeof(i));
+    return key;
+}
+
+size_t totalSizeFor(size_t numEntries) {
+    return numEntries * (kKeySize + kValueSize);
+}
+
+// Repeatedly looks up entries of a cache that holds state.range(0) entries.
+void BM_BlobCacheGetHit(benchmark::State& state) {
+    const size_t numEntries = state.range(0);
+    BlobCache cache(kKeySize, kMaxValueSize, totalSizeFor(numEntries) + 1);
+    std::vector<uint8_t> value(kValueSize, 0xa5);
+    std::vector<std::vector<uint8_t>> keys;
+    for (size_t i = 0; i < numEntries; i++) {
+        keys.push_back(makeKey(i));
+        cache.set(keys.back().data(), kKeySize, value.data(), kValueSize);
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& key = keys[i++ % numEntries];
+        benchmark::DoNotOptimize(cache.get(key.data(), kKeySize, value.data(), kValueSize));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BlobCacheGetHit)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+// Inserts new entries into a full cache of state.range(0) entries, so that
+// every insertion eventually has to evict older entries.
+void BM_BlobCacheSetWithEviction(benchmark::State& state) {
+    const size_t numEntries = state.range(0);
+    BlobCache cache(kKeySize, kMaxValueSize, totalSizeFor(numEntries));
+    std::vector<uint8_t> value(kValueSize, 0xa5);
+
+    uint32_t i = 0;
+    for (auto _ : state) {
+        auto key = makeKey(i++);
+        benchmark::DoNotOptimize(cache.set(key.data(), kKeySize, value.data(), kValueSize));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BlobCacheSetWithEviction)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+// Mixes lookups of a small hot set with insertions of new entries, as an app
+// does when it compiles a few new shaders while reusing most of its programs.
+void BM_BlobCacheMixedWorkload(benchmark::State& state) {
+    const size_t numEntries = state.range(0);
+    const size_t numHot = numEntries / 4;
+    BlobCache cache(kKeySize, kMaxValueSize, totalSizeFor(numEntries));
+    std::vector<uint8_t> value(kValueSize, 0xa5);
+    for (size_t i = 0; i < numHot; i++) {
+        auto key = makeKey(i);
+        cache.set(key.data(), kKeySize, value.data(), kValueSize);
+    }
+
+    uint32_t next = numHot;
+    uint32_t i = 0;
+    for (auto _ : state) {
+        if (i % 8 == 0) {
+            auto key = makeKey(next++);
+            cache.set(key.data(), kKeySize, value.data(), kValueSize);
+        } else {
+            auto key = makeKey(i % numHot);
+            benchmark::DoNotOptimize(cache.get(key.data(), kKeySize, value.data(), kValueSize));
+        }
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BlobCacheMixedWorkload)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+} // namespace
+} // namespace android
+
+BENCHMARK_MAIN();
@@ -294,6 +294,75 @@ TEST_F(BlobCacheTest, ExceedingTotalLimitHalvesCacheSize) {
     ASSERT_EQ(maxEntries / 2 + 1, numCached);
 }
 
+TEST_F(BlobCacheTest, CleanEvictsLeastRecentlyUsedEntries) {
+    // Fill up the entire cache with 1 char key/value pairs.
+    const int maxEntries = MAX_TOTAL_SIZE / 2;
+    for (int i = 0; i < maxEntries; i++) {
+        uint8_t k = i;
+        ASSERT_EQ(BlobCache::InsertResult::kInserted, mBC->set(&k, 1, "x", 1));
+    }
+    // Touch the oldest entry so that it becomes the most recently used one.
+    {
+        uint8_t k = 0;
+        ASSERT_EQ(size_t(1), mBC->get(&k, 1, nullptr, 0));
+    }
+    // Insert one more entry, causing a cache overflow.
+    {
+        uint8_t k = maxEntries;
+        ASSERT_EQ(BlobCache::InsertResult::kDidClean, mBC->set(&k, 1, "x", 1));
+    }
+    // The new entry, the touched entry and the most recently inserted entries
+    // survive. Everything else was evicted.
+    for (int i = 0; i < maxEntries + 1; i++) {
+        uint8_t k = i;
+        bool expectCached = i == 0 || i == maxEntries || i >= maxEntries - (maxEntries / 2 - 1);
+        ASSERT_EQ(expectCached ? size_t(1) : size_t(0), mBC->get(&k, 1, nullptr, 0)) << "key " << i;
+    }
+}
+
+TEST_F(BlobCacheTest, UpdatingValueMarksEntryRecentlyUsed) {
+    const int maxEntries = MAX_TOTAL_SIZE / 2;
+    for (int i = 0; i < maxEntries; i++) {
+        uint8_t k = i;
+        ASSERT_EQ(BlobCache::InsertResult::kInserted, mBC->set(&k, 1, "x", 1));
+    }
+    // Rewriting the oldest entry keeps it in the cache through the next clean.
+    {
+        uint8_t k = 0;
+        ASSERT_EQ(BlobCache::InsertResult::kInserted, mBC->set(&k, 1, "y", 1));
+    }
+    {
+        uint8_t k = maxEntries;
+        ASSERT_EQ(BlobCache::InsertResult::kDidClean, mBC->set(&k, 1, "x", 1));
+    }
+    uint8_t k = 0;
+    unsigned char buf[1] = {0xee};
+    ASSERT_EQ(size_t(1), mBC->get(&k, 1, buf, 1));
+    ASSERT_EQ('y', buf[0]);
+    k = 1;
+    ASSERT_EQ(size_t(0), mBC->get(&k, 1, nullptr, 0));
+}
+
+TEST_F(BlobCacheTest, CleanMakesRoomForLargeEntry) {
+    // Fill up the cache with 1 char key/value pairs, just above half of the
+    // total size.
+    const int numEntries = MAX_TOTAL_SIZE / 4 + 1;
+    for (int i = 0; i < numEntries; i++) {
+        uint8_t k = i;
+        ASSERT_EQ(BlobCache::InsertResult::kInserted, mBC->set(&k, 1, "x", 1));
+    }
+    // A max size value only fits once more than half of the cache is free.
+    char buf[MAX_VALUE_SIZE] = {};
+    ASSERT_EQ(BlobCache::InsertResult::kDidClean, mBC->set("ab", 2, buf, MAX_VALUE_SIZE));
+    ASSERT_EQ(size_t(MAX_VALUE_SIZE), mBC->get("ab", 2, nullptr, 0));
+    // Only the most recently inserted small entry fits next to it.
+    for (int i = 0; i < numEntries; i++) {
+        uint8_t k = i;
+        ASSERT_EQ(i == numEntries - 1 ? size_t(1) : size_t(0), mBC->get(&k, 1, nullptr, 0))
+                << "key " << i;
+    }
+}
+
 TEST_F(BlobCacheTest, InvalidKeySize) {
     ASSERT_EQ(BlobCache::InsertResult::kInvalidKeySize, mBC->set("", 0, "efgh", 4));
 }
@@ -355,6 +424,33 @@ TEST_F(BlobCacheFlattenTest, FlattenFullCache) {
     }
 }
 
+TEST_F(BlobCacheFlattenTest, FlattenPreservesRecencyOrder) {
+    // Fill up the entire cache with 1 char key/value pairs.
+    const int maxEntries = MAX_TOTAL_SIZE / 2;
+    for (int i = 0; i < maxEntries; i++) {
+        uint8_t k = i;
+        mBC->set(&k, 1, &k, 1);
+    }
+    // Touch the oldest entry so that it becomes the most recently used one.
+    {
+        uint8_t k = 0;
+        ASSERT_EQ(size_t(1), mBC->get(&k, 1, nullptr, 0));
+    }
+
+    roundTrip();
+
+    // Overflowing the deserialized cache evicts the same entries as the
+    // original cache would.
+    {
+        uint8_t k = maxEntries;
+        ASSERT_EQ(BlobCache::InsertResult::kDidClean, mBC2->set(&k, 1, &k, 1));
+    }
+    uint8_t k = 0;
+    ASSERT_EQ(size_t(1), mBC2->get(&k, 1, nullptr, 0));
+    k = 1;
+    ASSERT_EQ(size_t(0), mBC2->get(&k, 1, nullptr, 0));
+}
+
 TEST_F(BlobCacheFlattenTest, FlattenDoesntChangeCache) {
     // Fill up the entire cache with 1 char key/value pairs.
     const int maxEntries = MAX_TOTAL_SIZE / 2;
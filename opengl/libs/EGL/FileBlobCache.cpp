@@ -18,9 +18,12 @@
 
 #include "FileBlobCache.h"
 
+#include <android-base/properties.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -28,26 +31,98 @@
 #include <log/log.h>
 #include <utils/Trace.h>
 
+#include <array>
+#include <vector>
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32C_HW 1
+#elif defined(__x86_64__) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#endif
+
 // Cache file header
 static const char* cacheFileMagic = "EGL$";
-static const size_t cacheFileHeaderSize = 8;
+
+// FileBlobCache::FileHeader::mVersion value
+static const uint32_t cacheFileVersion = 2;
 
 namespace android {
 
-uint32_t crc32c(const uint8_t* buf, size_t len) {
-    const uint32_t polyBits = 0x82F63B78;
-    uint32_t r = 0;
-    for (size_t i = 0; i < len; i++) {
-        r ^= buf[i];
+#ifndef CRC32C_HW
+static const uint32_t crc32cPolyBits = 0x82F63B78;
+
+using Crc32cTables = std::array<std::array<uint32_t, 256>, 8>;
+
+// Entry [k][b] of the tables is the CRC of byte b followed by k zero bytes,
+// which lets crc32c consume 8 bytes per lookup round instead of one bit per
+// shift.
+static constexpr Crc32cTables makeCrc32cTables() {
+    Crc32cTables tables{};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t r = i;
         for (int j = 0; j < 8; j++) {
-            if (r & 1) {
-                r = (r >> 1) ^ polyBits;
-            } else {
-                r >>= 1;
-            }
+            r = (r & 1) ? (r >> 1) ^ crc32cPolyBits : r >> 1;
+        }
+        tables[0][i] = r;
+    }
+    for (size_t k = 1; k < tables.size(); k++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t r = tables[k - 1][i];
+            tables[k][i] = (r >> 8) ^ tables[0][r & 0xFF];
         }
     }
+    return tables;
+}
+
+static constexpr Crc32cTables crc32cTables = makeCrc32cTables();
+
+static inline uint32_t load32le(const uint8_t* buf) {
+    return uint32_t(buf[0]) | uint32_t(buf[1]) << 8 | uint32_t(buf[2]) << 16 |
+            uint32_t(buf[3]) << 24;
+}
+#endif
+
+uint32_t crc32c(const uint8_t* buf, size_t len, uint32_t crc) {
+#ifdef CRC32C_HW
+    uint32_t r = crc;
+    for (; len >= 8; buf += 8, len -= 8) {
+        uint64_t word;
+        memcpy(&word, buf, sizeof(word));
+#if defined(__aarch64__)
+        r = __crc32cd(r, word);
+#else
+        r = static_cast<uint32_t>(_mm_crc32_u64(r, word));
+#endif
+    }
+    for (; len > 0; buf++, len--) {
+#if defined(__aarch64__)
+        r = __crc32cb(r, *buf);
+#else
+        r = _mm_crc32_u8(r, *buf);
+#endif
+    }
+    return r;
+#else
+    const Crc32cTables& t = crc32cTables;
+    uint32_t r = crc;
+    for (; len >= 8; buf += 8, len -= 8) {
+        uint32_t lo = r ^ load32le(buf);
+        uint32_t hi = load32le(buf + 4);
+        r = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^
+                t[0][hi >> 24];
+    }
+    for (; len > 0; buf++, len--) {
+        r = (r >> 8) ^ t[0][(r ^ *buf) & 0xFF];
+    }
     return r;
+#endif
+}
+
+static inline size_t align4(size_t size) {
+    return (size + 3) & ~3;
 }
 
 FileBlobCache::FileBlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxTotalSize,
@@ -57,8 +132,6 @@ FileBlobCache::FileBlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxT
     ATRACE_CALL();
 
     if (mFilename.length() > 0) {
-        size_t headerSize = cacheFileHeaderSize;
-
         int fd = open(mFilename.c_str(), O_RDONLY, 0);
         if (fd == -1) {
             if (errno != ENOENT) {
@@ -83,50 +156,94 @@ FileBlobCache::FileBlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxT
             close(fd);
             return;
         }
+        if (fileSize < sizeof(FileHeader)) {
+            ALOGE("cache file is too small: %zu", fileSize);
+            close(fd);
+            return;
+        }
 
         uint8_t* buf = reinterpret_cast<uint8_t*>(mmap(nullptr, fileSize,
                 PROT_READ, MAP_PRIVATE, fd, 0));
+        close(fd);
         if (buf == MAP_FAILED) {
             ALOGE("error mmaping cache file: %s (%d)", strerror(errno),
                     errno);
-            close(fd);
             return;
         }
 
-        // Check the file magic and CRC
-        size_t cacheSize = fileSize - headerSize;
-        if (memcmp(buf, cacheFileMagic, 4) != 0) {
+        // Check the file magic and version
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(buf);
+        if (memcmp(header->mMagic, cacheFileMagic, 4) != 0) {
             ALOGE("cache file has bad mojo");
-            close(fd);
+            munmap(buf, fileSize);
             return;
         }
-        uint32_t* crc = reinterpret_cast<uint32_t*>(buf + 4);
-        if (crc32c(buf + headerSize, cacheSize) != *crc) {
-            ALOGE("cache file failed CRC check");
-            close(fd);
+        auto buildId = base::GetProperty("ro.build.id", "");
+        if (header->mVersion != cacheFileVersion || header->mBuildIdLength != buildId.size()) {
+            // We treat version mismatches as an empty cache.
+            munmap(buf, fileSize);
             return;
         }
 
-        int err = unflatten(buf + headerSize, cacheSize);
-        if (err < 0) {
-            ALOGE("error reading cache contents: %s (%d)", strerror(-err),
-                    -err);
+        // Check the index CRC.  The entries are checked when they are first read.
+        size_t indexOffset = align4(sizeof(FileHeader) + header->mBuildIdLength);
+        if (indexOffset > fileSize ||
+            header->mNumEntries > (fileSize - indexOffset) / sizeof(FileIndexEntry)) {
+            ALOGE("cache file is too small for its index");
+            munmap(buf, fileSize);
+            return;
+        }
+        size_t dataOffset = indexOffset + header->mNumEntries * sizeof(FileIndexEntry);
+        if (crc32c(buf + offsetof(FileHeader, mVersion),
+                   dataOffset - offsetof(FileHeader, mVersion)) != header->mIndexCrc) {
+            ALOGE("cache file failed CRC check");
+            munmap(buf, fileSize);
+            return;
+        }
+        if (strncmp(buildId.c_str(), header->mBuildId, buildId.size())) {
             munmap(buf, fileSize);
-            close(fd);
             return;
         }
 
-        munmap(buf, fileSize);
-        close(fd);
+        const FileIndexEntry* index = reinterpret_cast<const FileIndexEntry*>(buf + indexOffset);
+        for (size_t i = 0; i < header->mNumEntries; i++) {
+            const FileIndexEntry& entry = index[i];
+            size_t entrySize = size_t(entry.mKeySize) + entry.mValueSize;
+            if (entry.mOffset < dataOffset || entry.mOffset > fileSize ||
+                entrySize > fileSize - entry.mOffset) {
+                ALOGE("cache file entry %zu is out of bounds", i);
+                clear();
+                munmap(buf, fileSize);
+                return;
+            }
+            const uint8_t* key = buf + entry.mOffset;
+            setUnverified(key, entry.mKeySize, key + entry.mKeySize, entry.mValueSize,
+                          entry.mCrc);
+        }
+
+        mMappedFile = buf;
+        mMappedSize = fileSize;
     }
 }
 
+FileBlobCache::~FileBlobCache() {
+    // The entries loaded from the file refer to the mapping, so drop them first.
+    clear();
+    if (mMappedFile != nullptr) {
+        munmap(mMappedFile, mMappedSize);
+    }
+}
+
+bool FileBlobCache::verifyEntry(const void* key, size_t keySize, const void* value,
+                                size_t valueSize, uint32_t checksum) const {
+    uint32_t crc = crc32c(reinterpret_cast<const uint8_t*>(key), keySize);
+    return crc32c(reinterpret_cast<const uint8_t*>(value), valueSize, crc) == checksum;
+}
+
 void FileBlobCache::writeToFile() {
     ATRACE_CALL();
 
     if (mFilename.length() > 0) {
-        size_t cacheSize = getFlattenedSize();
-        size_t headerSize = cacheFileHeaderSize;
         const char* fname = mFilename.c_str();
 
         // Try to create the file with no permissions so we can write it
@@ -151,42 +268,66 @@ void FileBlobCache::writeToFile() {
             }
         }
 
-        size_t fileSize = headerSize + cacheSize;
+        // Entries loaded from the previous file are written with the CRC they
+        // were loaded with, so check them before carrying them over.
+        verifyEntries();
 
-        uint8_t* buf = new uint8_t [fileSize];
-        if (!buf) {
-            ALOGE("error allocating buffer for cache contents: %s (%d)",
-                    strerror(errno), errno);
+        auto buildId = base::GetProperty("ro.build.id", "");
+        size_t indexOffset = align4(sizeof(FileHeader) + buildId.size());
+        size_t numEntries = 0;
+        size_t dataSize = 0;
+        forEachEntry([&](const void*, size_t keySize, const void*, size_t valueSize,
+                         const uint32_t*) {
+            numEntries++;
+            dataSize += align4(keySize + valueSize);
+        });
+        size_t dataOffset = indexOffset + numEntries * sizeof(FileIndexEntry);
+        size_t fileSize = dataOffset + dataSize;
+        if (fileSize > UINT32_MAX) {
+            ALOGE("cache contents are too large for the cache file: %zu", fileSize);
             close(fd);
             unlink(fname);
             return;
         }
 
-        int err = flatten(buf + headerSize, cacheSize);
-        if (err < 0) {
-            ALOGE("error writing cache contents: %s (%d)", strerror(-err),
-                    -err);
-            delete [] buf;
-            close(fd);
-            unlink(fname);
-            return;
-        }
+        // The buffer starts zeroed, so padding bytes are reproducible.
+        std::vector<uint8_t> buf(fileSize);
+
+        FileHeader* header = reinterpret_cast<FileHeader*>(buf.data());
+        memcpy(header->mMagic, cacheFileMagic, 4);
+        header->mVersion = cacheFileVersion;
+        header->mNumEntries = numEntries;
+        header->mBuildIdLength = buildId.size();
+        memcpy(header->mBuildId, buildId.c_str(), header->mBuildIdLength);
+
+        // Write the index and the entries, from the least to the most recently
+        // used one so that loading the file restores the recency order.
+        FileIndexEntry* index = reinterpret_cast<FileIndexEntry*>(buf.data() + indexOffset);
+        size_t offset = dataOffset;
+        forEachEntry([&](const void* key, size_t keySize, const void* value, size_t valueSize,
+                         const uint32_t* checksum) {
+            uint8_t* data = buf.data() + offset;
+            memcpy(data, key, keySize);
+            memcpy(data + keySize, value, valueSize);
+            index->mOffset = offset;
+            index->mKeySize = keySize;
+            index->mValueSize = valueSize;
+            index->mCrc = checksum != nullptr ? *checksum : crc32c(data, keySize + valueSize);
+            index++;
+            offset += align4(keySize + valueSize);
+        });
 
-        // Write the file magic and CRC
-        memcpy(buf, cacheFileMagic, 4);
-        uint32_t* crc = reinterpret_cast<uint32_t*>(buf + 4);
-        *crc = crc32c(buf + headerSize, cacheSize);
+        header->mIndexCrc = crc32c(buf.data() + offsetof(FileHeader, mVersion),
+                                   dataOffset - offsetof(FileHeader, mVersion));
 
-        if (write(fd, buf, fileSize) == -1) {
+        if (write(fd, buf.data(), fileSize) == -1) {
             ALOGE("error writing cache file: %s (%d)", strerror(errno),
                     errno);
-            delete [] buf;
             close(fd);
             unlink(fname);
             return;
         }
 
-        delete [] buf;
         fchmod(fd, S_IRUSR);
         close(fd);
     }
@@ -194,7 +335,12 @@ void FileBlobCache::writeToFile() {
 
 size_t FileBlobCache::getSize() {
     if (mFilename.length() > 0) {
-        return getFlattenedSize() + cacheFileHeaderSize;
+        size_t size = align4(sizeof(FileHeader) + base::GetProperty("ro.build.id", "").size());
+        forEachEntry([&size](const void*, size_t keySize, const void*, size_t valueSize,
+                             const uint32_t*) {
+            size += sizeof(FileIndexEntry) + align4(keySize + valueSize);
+        });
+        return size;
     }
     return 0;
 }
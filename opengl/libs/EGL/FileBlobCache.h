@@ -22,15 +22,22 @@
 
 namespace android {
 
-uint32_t crc32c(const uint8_t* buf, size_t len);
+// crc32c computes the CRC-32C of buf, continuing from crc.  A CRC of a buffer
+// split in two parts is computed by passing the CRC of the first part as crc
+// for the second part.
+uint32_t crc32c(const uint8_t* buf, size_t len, uint32_t crc = 0);
 
 class FileBlobCache : public BlobCache {
 public:
     // FileBlobCache attempts to load the saved cache contents from disk into
-    // BlobCache.
+    // BlobCache.  Only the file header and entry index are read and checked
+    // up front.  The entries keep referencing the mmap'd file and each entry is
+    // checked against its own CRC the first time it is read.
     FileBlobCache(size_t maxKeySize, size_t maxValueSize, size_t maxTotalSize,
             const std::string& filename);
 
+    ~FileBlobCache() override;
+
     // writeToFile attempts to save the current contents of BlobCache to
     // disk.
     void writeToFile();
@@ -38,9 +45,60 @@ public:
     // Return the total size of the cache
     size_t getSize();
 
+protected:
+    bool verifyEntry(const void* key, size_t keySize, const void* value, size_t valueSize,
+                     uint32_t checksum) const override;
+
 private:
+    // A FileHeader is the header of the cache file.  It is followed by the build
+    // id, padded to a multiple of 4 bytes, and an array of mNumEntries
+    // FileIndexEntry structs.  The entry data follows the index.
+    struct FileHeader {
+        // mMagic identifies the file as an EGL cache file.  It must always
+        // contain 'EGL$'.
+        char mMagic[4];
+
+        // mIndexCrc is the CRC-32C of the rest of the header, the build id and
+        // the index.
+        uint32_t mIndexCrc;
+
+        // mVersion is the file format version.
+        uint32_t mVersion;
+
+        // mNumEntries is the number of entries in the index.
+        uint32_t mNumEntries;
+
+        // mBuildIdLength is the length of the build id that generated the file.
+        uint32_t mBuildIdLength;
+
+        // mBuildId is the build id that generated the file.
+        char mBuildId[];
+    };
+
+    // A FileIndexEntry describes a single cache entry in the cache file.
+    struct FileIndexEntry {
+        // mOffset is the file offset of the key.  The value immediately follows
+        // the key.
+        uint32_t mOffset;
+
+        // mKeySize is the size of the key in bytes.
+        uint32_t mKeySize;
+
+        // mValueSize is the size of the value in bytes.
+        uint32_t mValueSize;
+
+        // mCrc is the CRC-32C of the key followed by the value.
+        uint32_t mCrc;
+    };
+
     // mFilename is the name of the file for storing cache contents.
     std::string mFilename;
+
+    // mMappedFile and mMappedSize describe the mapping of the cache file that
+    // entries loaded from disk refer to.  The file stays mapped as long as the
+    // cache exists.
+    void* mMappedFile = nullptr;
+    size_t mMappedSize = 0;
 };
 
 } // namespace android
@@ -0,0 +1,185 @@
+/*
+ ** Copyright 2024, The Android Open Source Project
+ **
+ ** Licensed under the Apache License, Version 2.0 (the "License");
+ ** you may not use this file except in compliance with the License.
+ ** You may obtain a copy of the License at
+ **
+ **     http://www.apache.org/licenses/LICENSE-2.0
+ **
+ ** Unless required by applicable law or agreed to in writing, software
+ ** distributed under the License is distributed on an "AS IS" BASIS,
+ ** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ ** See the License for the specific language governing permissions and
+ ** limitations under the License.
+ */
+
+#include "FileBlobCache.h"
+
+#include <android-base/test_utils.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+namespace android {
+
+constexpr size_t kMaxKeySize = 64;
+constexpr size_t kMaxValueSize = 1024;
+constexpr size_t kMaxTotalSize = 16 * 1024;
+
+// The original bit-at-a-time implementation, used as a reference.
+static uint32_t referenceCrc32c(const uint8_t* buf, size_t len) {
+    const uint32_t polyBits = 0x82F63B78;
+    uint32_t r = 0;
+    for (size_t i = 0; i < len; i++) {
+        r ^= buf[i];
+        for (int j = 0; j < 8; j++) {
+            if (r & 1) {
+                r = (r >> 1) ^ polyBits;
+            } else {
+                r >>= 1;
+            }
+        }
+    }
+    return r;
+}
+
+class FileBlobCacheTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        mTempFile.reset(new TemporaryFile());
+        mFBC.reset(new FileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize,
+                                     &mTempFile->path[0]));
+    }
+
+    virtual void TearDown() { mFBC.reset(); }
+
+    // Writes the cache to disk and creates a new cache from the file.
+    void reload() {
+        mFBC->writeToFile();
+        mFBC.reset(new FileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize,
+                                     &mTempFile->path[0]));
+    }
+
+    // Flips the bits of the byte at offset in the cache file. A negative
+    // offset counts from the end of the file.
+    void corruptFile(off_t offset) {
+        ASSERT_EQ(0, chmod(mTempFile->path, S_IRUSR | S_IWUSR));
+        int fd = open(mTempFile->path, O_RDWR);
+        ASSERT_NE(-1, fd);
+        struct stat statBuf;
+        ASSERT_EQ(0, fstat(fd, &statBuf));
+        if (offset < 0) {
+            offset += statBuf.st_size;
+        }
+        uint8_t byte;
+        ASSERT_EQ(1, pread(fd, &byte, 1, offset));
+        byte = ~byte;
+        ASSERT_EQ(1, pwrite(fd, &byte, 1, offset));
+        close(fd);
+    }
+
+    std::unique_ptr<TemporaryFile> mTempFile;
+    std::unique_ptr<FileBlobCache> mFBC;
+};
+
+TEST_F(FileBlobCacheTest, Crc32cMatchesReference) {
+    std::vector<uint8_t> buf(4099);
+    for (size_t i = 0; i < buf.size(); i++) {
+        buf[i] = uint8_t(i * 7 + (i >> 3));
+    }
+    for (size_t len : {0, 1, 7, 8, 9, 63, 64, 65, 4096, 4099}) {
+        SCOPED_TRACE(len);
+        ASSERT_EQ(referenceCrc32c(buf.data(), len), crc32c(buf.data(), len));
+    }
+    // The CRC of a buffer can be computed in parts.
+    ASSERT_EQ(crc32c(buf.data(), buf.size()),
+              crc32c(buf.data() + 13, buf.size() - 13, crc32c(buf.data(), 13)));
+}
+
+TEST_F(FileBlobCacheTest, Crc32cCheckValue) {
+    // The standard CRC-32C check value uses an all-ones initial value and a
+    // final inversion.
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    ASSERT_EQ(0xE3069283, crc32c(check, sizeof(check), 0xFFFFFFFF) ^ 0xFFFFFFFF);
+}
+
+TEST_F(FileBlobCacheTest, ReloadKeepsEntries) {
+    unsigned char buf[4] = {0xee, 0xee, 0xee, 0xee};
+    mFBC->set("abcd", 4, "efgh", 4);
+    mFBC->set("ijkl", 4, "mnop", 4);
+    size_t size = mFBC->getSize();
+    reload();
+    ASSERT_EQ(size, mFBC->getSize());
+    ASSERT_EQ(size_t(4), mFBC->get("abcd", 4, buf, 4));
+    ASSERT_EQ('e', buf[0]);
+    ASSERT_EQ('f', buf[1]);
+    ASSERT_EQ('g', buf[2]);
+    ASSERT_EQ('h', buf[3]);
+    ASSERT_EQ(size_t(4), mFBC->get("ijkl", 4, buf, 4));
+    ASSERT_EQ('m', buf[0]);
+    ASSERT_EQ('n', buf[1]);
+    ASSERT_EQ('o', buf[2]);
+    ASSERT_EQ('p', buf[3]);
+}
+
+TEST_F(FileBlobCacheTest, ReloadKeepsEntriesAfterSecondWrite) {
+    unsigned char buf[4] = {0xee, 0xee, 0xee, 0xee};
+    mFBC->set("abcd", 4, "efgh", 4);
+    reload();
+    // Rewrite the file while the loaded entry still refers to the old one.
+    mFBC->set("ijkl", 4, "mnop", 4);
+    reload();
+    ASSERT_EQ(size_t(4), mFBC->get("abcd", 4, buf, 4));
+    ASSERT_EQ('e', buf[0]);
+    ASSERT_EQ('h', buf[3]);
+    ASSERT_EQ(size_t(4), mFBC->get("ijkl", 4, buf, 4));
+    ASSERT_EQ('m', buf[0]);
+    ASSERT_EQ('p', buf[3]);
+}
+
+TEST_F(FileBlobCacheTest, CorruptedEntryIsDroppedOnAccess) {
+    mFBC->set("abcd", 4, "efgh", 4);
+    mFBC->set("ijkl", 4, "mnop", 4);
+    mFBC->writeToFile();
+    // The most recently used entry is written last, so this corrupts "mnop".
+    corruptFile(-1);
+    mFBC.reset(new FileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize,
+                                 &mTempFile->path[0]));
+
+    ASSERT_EQ(size_t(4), mFBC->get("abcd", 4, nullptr, 0));
+    ASSERT_EQ(size_t(0), mFBC->get("ijkl", 4, nullptr, 0));
+}
+
+TEST_F(FileBlobCacheTest, CorruptedEntryIsNotWrittenBack) {
+    mFBC->set("abcd", 4, "efgh", 4);
+    mFBC->set("ijkl", 4, "mnop", 4);
+    mFBC->writeToFile();
+    corruptFile(-1);
+    mFBC.reset(new FileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize,
+                                 &mTempFile->path[0]));
+
+    // Write the file again without reading the corrupted entry first.
+    reload();
+    ASSERT_EQ(size_t(4), mFBC->get("abcd", 4, nullptr, 0));
+    ASSERT_EQ(size_t(0), mFBC->get("ijkl", 4, nullptr, 0));
+}
+
+TEST_F(FileBlobCacheTest, CorruptedIndexDiscardsCache) {
+    mFBC->set("abcd", 4, "efgh", 4);
+    mFBC->set("ijkl", 4, "mnop", 4);
+    mFBC->writeToFile();
+    // Corrupt the number of entries.
+    corruptFile(12);
+    mFBC.reset(new FileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize,
+                                 &mTempFile->path[0]));
+
+    ASSERT_EQ(size_t(0), mFBC->get("abcd", 4, nullptr, 0));
+    ASSERT_EQ(size_t(0), mFBC->get("ijkl", 4, nullptr, 0));
+}
+
+} // namespace android
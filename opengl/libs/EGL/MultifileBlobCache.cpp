@@ -41,8 +41,17 @@
 using namespace std::literals;
 
 constexpr uint32_t kMultifileMagic = 'MFB$';
+constexpr uint32_t kMultifileStatsMagic = 'MFS$';
+constexpr uint32_t kMultifilePackMagic = 'MFP$';
 constexpr uint32_t kCrcPlaceholder = 0;
 
+// Standalone entries up to this size are packed together by compaction
+constexpr size_t kCompactionEntrySizeLimit = 16 * 1024;
+// Compaction only runs once there are at least this many small standalone entries
+constexpr size_t kCompactionMinEntries = 16;
+// Maximum size of the entries packed into a single pack file
+constexpr size_t kCompactionPackSizeLimit = 1024 * 1024;
+
 namespace {
 
 // Helper function to close entries or free them
@@ -74,6 +83,8 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
         mTotalCacheEntries(0),
         mHotCacheLimit(0),
         mHotCacheSize(0),
+        mNextPackId(0),
+        mPendingBackgroundTasks(0),
         mWorkerThreadIdle(true) {
     if (baseDir.empty()) {
         ALOGV("INIT: no baseDir provided in MultifileBlobCache constructor, returning early.");
@@ -134,19 +145,41 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
     }
 
     if (statusGood) {
-        // Read all the files and gather details, then preload their contents
+        // Read the headers of all the files and gather details. Contents are
+        // read and checked on first use, or ahead of use by the prefetch task.
         DIR* dir;
         struct dirent* entry;
+        std::vector<uint32_t> packIds;
         if ((dir = opendir(mMultifileDirName.c_str())) != nullptr) {
             while ((entry = readdir(dir)) != nullptr) {
                 if (entry->d_name == "."s || entry->d_name == ".."s ||
-                    strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0) {
+                    strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0 ||
+                    strcmp(entry->d_name, kMultifileBlobCacheStatsFile) == 0) {
                     continue;
                 }
 
                 std::string entryName = entry->d_name;
                 std::string fullPath = mMultifileDirName + "/" + entryName;
 
+                // Pack files are loaded after all standalone entries, which are newer
+                size_t prefixLength = strlen(kMultifileBlobCachePackPrefix);
+                if (entryName.compare(0, prefixLength, kMultifileBlobCachePackPrefix) == 0) {
+                    char* end = nullptr;
+                    uint32_t packId = static_cast<uint32_t>(
+                            strtoul(entry->d_name + prefixLength, &end, 10));
+                    if (end == entry->d_name + prefixLength || *end != '\0') {
+                        // Left behind by an interrupted compaction
+                        ALOGV("INIT: Removing incomplete pack file %s", fullPath.c_str());
+                        if (remove(fullPath.c_str()) != 0) {
+                            ALOGE("INIT: Error removing %s: %s", fullPath.c_str(),
+                                  std::strerror(errno));
+                        }
+                        continue;
+                    }
+                    packIds.push_back(packId);
+                    continue;
+                }
+
                 // The filename is the same as the entryHash
                 uint32_t entryHash = static_cast<uint32_t>(strtoul(entry->d_name, nullptr, 10));
 
@@ -187,6 +220,9 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
                     return;
                 }
 
+                // Only the header is needed for now
+                close(fd);
+
                 // Verify header magic
                 if (header.magic != kMultifileMagic) {
                     ALOGE("INIT: Entry %u has bad magic (%u)! Removing.", entryHash, header.magic);
@@ -194,33 +230,6 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
                         ALOGE("INIT: Error removing %s: %s", fullPath.c_str(),
                               std::strerror(errno));
                     }
-                    close(fd);
-                    continue;
-                }
-
-                // Note: Converting from off_t (signed) to size_t (unsigned)
-                size_t fileSize = static_cast<size_t>(st.st_size);
-
-                // Memory map the file
-                uint8_t* mappedEntry = reinterpret_cast<uint8_t*>(
-                        mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0));
-
-                // We can close the file now and the mmap will remain
-                close(fd);
-
-                if (mappedEntry == MAP_FAILED) {
-                    ALOGE("Failed to mmap cacheEntry, error: %s", std::strerror(errno));
-                    return;
-                }
-
-                // Ensure we have a good CRC
-                if (header.crc !=
-                    crc32c(mappedEntry + sizeof(MultifileHeader),
-                           fileSize - sizeof(MultifileHeader))) {
-                    ALOGV("INIT: Entry %u failed CRC check! Removing.", entryHash);
-                    if (remove(fullPath.c_str()) != 0) {
-                        ALOGE("Error removing %s: %s", fullPath.c_str(), std::strerror(errno));
-                    }
                     continue;
                 }
 
@@ -236,6 +245,10 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
                     continue;
                 }
 
+                // Note: Converting from off_t (signed) to size_t (unsigned)
+                size_t fileSize = static_cast<size_t>(st.st_size);
+
+                // The CRC is checked when the entry is read
                 ALOGV("INIT: Entry %u is good, tracking it now.", entryHash);
 
                 // Track details for rapid lookup later
@@ -243,25 +256,17 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
 
                 // Track the total size
                 increaseTotalCacheSize(fileSize);
-
-                // Preload the entry for fast retrieval
-                if ((mHotCacheSize + fileSize) < mHotCacheLimit) {
-                    ALOGV("INIT: Populating hot cache with fd = %i, cacheEntry = %p for "
-                          "entryHash %u",
-                          fd, mappedEntry, entryHash);
-
-                    // Track the details of the preload so they can be retrieved later
-                    if (!addToHotCache(entryHash, fd, mappedEntry, fileSize)) {
-                        ALOGE("INIT Failed to add %u to hot cache", entryHash);
-                        munmap(mappedEntry, fileSize);
-                        return;
-                    }
-                } else {
-                    // If we're not keeping it in hot cache, unmap it now
-                    munmap(mappedEntry, fileSize);
-                }
             }
             closedir(dir);
+
+            // Load newer packs first, so they take precedence over older ones
+            std::sort(packIds.begin(), packIds.end(), std::greater<uint32_t>());
+            for (uint32_t packId : packIds) {
+                loadPack(packId);
+            }
+
+            // Restore the access stats used to pick the entries to prefetch
+            loadStats(mMultifileDirName);
         } else {
             ALOGE("Unable to open filename: %s", mMultifileDirName.c_str());
         }
@@ -281,6 +286,11 @@ MultifileBlobCache::MultifileBlobCache(size_t maxKeySize, size_t maxValueSize, s
 
     ALOGV("INIT: Multifile BlobCache initialization succeeded");
     mInitialized = true;
+
+    // Read the most used entries ahead of their first use, then pack small
+    // entries together in the background
+    queuePrefetch();
+    queueCompaction();
 }
 
 MultifileBlobCache::~MultifileBlobCache() {
@@ -299,6 +309,9 @@ MultifileBlobCache::~MultifileBlobCache() {
     if (mTaskThread.joinable()) {
         mTaskThread.join();
     }
+
+    // Release anything read ahead but never used
+    freePrefetchedEntries();
 }
 
 // Set will add the entry to hot cache and start a deferred process to write it to disk
@@ -315,9 +328,25 @@ void MultifileBlobCache::set(const void* key, EGLsizeiANDROID keySize, const voi
         return;
     }
 
+    // Pick up the results of background compaction
+    applyCompactionResults();
+
     // Generate a hash of the key and use it to track this entry
     uint32_t entryHash = android::JenkinsHashMixBytes(0, static_cast<const uint8_t*>(key), keySize);
 
+    // Anything read or packed in the background for this entry is stale now
+    invalidateBackgroundWork(entryHash);
+
+    // Keep the hit count of an entry being replaced, and release its old pack slot
+    uint32_t hitCount = 0;
+    if (contains(entryHash)) {
+        MultifileEntryStats oldStats = getEntryStats(entryHash);
+        hitCount = oldStats.hitCount;
+        if (oldStats.packId != kMultifileNoPack) {
+            releasePackEntry(oldStats.packId);
+        }
+    }
+
     size_t fileSize = sizeof(MultifileHeader) + keySize + valueSize;
 
     // If we're going to be over the cache limit, kick off a trim to clear space
@@ -344,6 +373,7 @@ void MultifileBlobCache::set(const void* key, EGLsizeiANDROID keySize, const voi
 
     // Track the size and access time for quick recall
     trackEntry(entryHash, valueSize, fileSize, time(0));
+    mEntryStats[entryHash].hitCount = hitCount;
 
     // Update the overall cache size
     increaseTotalCacheSize(fileSize);
@@ -387,6 +417,9 @@ EGLsizeiANDROID MultifileBlobCache::get(const void* key, EGLsizeiANDROID keySize
         return 0;
     }
 
+    // Pick up the results of background compaction
+    applyCompactionResults();
+
     // Generate a hash of the key and use it to track this entry
     uint32_t entryHash = android::JenkinsHashMixBytes(0, static_cast<const uint8_t*>(key), keySize);
 
@@ -419,7 +452,7 @@ EGLsizeiANDROID MultifileBlobCache::get(const void* key, EGLsizeiANDROID keySize
         return 0;
     }
 
-    std::string fullPath = mMultifileDirName + "/" + std::to_string(entryHash);
+    std::string fullPath = getEntryPath(entryHash, entryStats.packId);
 
     // Open the hashed filename path
     uint8_t* cacheEntry = 0;
@@ -431,42 +464,40 @@ EGLsizeiANDROID MultifileBlobCache::get(const void* key, EGLsizeiANDROID keySize
     } else {
         ALOGV("GET: HotCache MISS for entry: %u", entryHash);
 
-        // Wait for writes to complete if there is an outstanding write for this entry
-        bool wait = false;
-        {
-            // Synchronize access to deferred write status
-            std::lock_guard<std::mutex> lock(mDeferredWriteStatusMutex);
-            wait = mDeferredWrites.find(entryHash) != mDeferredWrites.end();
-        }
-
-        if (wait) {
-            ALOGV("GET: Waiting for write to complete for %u", entryHash);
-            waitForWorkComplete();
-        }
-
-        // Open the entry file
-        int fd = open(fullPath.c_str(), O_RDONLY);
-        if (fd == -1) {
-            ALOGE("Cache error - failed to open fullPath: %s, error: %s", fullPath.c_str(),
-                  std::strerror(errno));
-            return 0;
-        }
-
-        // Memory map the file
-        cacheEntry =
-                reinterpret_cast<uint8_t*>(mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0));
+        // Check whether the prefetch task already read the entry
+        MultifilePrefetchedEntry prefetchedEntry;
+        if (takePrefetchedEntry(entryHash, &prefetchedEntry)) {
+            ALOGV("GET: Prefetch HIT for entry %u", entryHash);
+            cacheEntry = prefetchedEntry.entryBuffer;
+        } else {
+            // Wait for writes to complete if there is an outstanding write for this entry
+            bool wait = false;
+            {
+                // Synchronize access to deferred write status
+                std::lock_guard<std::mutex> lock(mDeferredWriteStatusMutex);
+                wait = mDeferredWrites.find(entryHash) != mDeferredWrites.end();
+            }
 
-        // We can close the file now and the mmap will remain
-        close(fd);
+            if (wait) {
+                ALOGV("GET: Waiting for write to complete for %u", entryHash);
+                waitForDeferredWrites();
+            }
 
-        if (cacheEntry == MAP_FAILED) {
-            ALOGE("Failed to mmap cacheEntry, error: %s", std::strerror(errno));
-            return 0;
+            // Read the entry from its own file or its pack file
+            cacheEntry = readEntry({entryHash, entryStats.packId, entryStats.packOffset, fileSize});
+            if (cacheEntry == nullptr) {
+                ALOGE("GET: Unable to read entry %u from %s, removing it", entryHash,
+                      fullPath.c_str());
+                removeEntry(entryHash);
+                return 0;
+            }
         }
 
+        // Sending -1 as the fd indicates the buffer was allocated rather than mapped
         ALOGV("GET: Adding %u to hot cache", entryHash);
-        if (!addToHotCache(entryHash, fd, cacheEntry, fileSize)) {
+        if (!addToHotCache(entryHash, -1, cacheEntry, fileSize)) {
             ALOGE("GET: Failed to add %u to hot cache", entryHash);
+            delete[] cacheEntry;
             return 0;
         }
 
@@ -496,6 +527,9 @@ EGLsizeiANDROID MultifileBlobCache::get(const void* key, EGLsizeiANDROID keySize
     uint8_t* cachedValue = cacheEntry + (keySize + sizeof(MultifileHeader));
     memcpy(value, cachedValue, cachedValueSize);
 
+    // Count the hit, so the most used entries get prefetched on the next run
+    mEntryStats[entryHash].hitCount++;
+
     return cachedValueSize;
 }
 
@@ -508,6 +542,13 @@ void MultifileBlobCache::finish() {
     ALOGV("FINISH: Waiting for work to complete.");
     waitForWorkComplete();
 
+    // Apply completed background work and release anything read ahead but never used
+    applyCompactionResults();
+    freePrefetchedEntries();
+
+    // Persist the access stats for the next run
+    writeStats(mMultifileDirName);
+
     // Close all entries in the hot cache
     for (auto hotCacheIter = mHotCache.begin(); hotCacheIter != mHotCache.end();) {
         uint32_t entryHash = hotCacheIter->first;
@@ -626,10 +667,162 @@ bool MultifileBlobCache::checkStatus(const std::string& baseDir) {
     return true;
 }
 
+bool MultifileBlobCache::loadStats(const std::string& baseDir) {
+    std::string cacheStats = baseDir + "/" + kMultifileBlobCacheStatsFile;
+
+    int fd = open(cacheStats.c_str(), O_RDONLY);
+    if (fd == -1) {
+        ALOGV("STATS(LOAD): No stats file (%s)", cacheStats.c_str());
+        return false;
+    }
+
+    // Read in the header, then the hit counts it covers
+    MultifileStatsHeader header;
+    std::vector<MultifileHitCount> hitCounts;
+    bool valid = read(fd, static_cast<void*>(&header), sizeof(header)) == sizeof(header) &&
+            header.magic == kMultifileStatsMagic && header.numEntries <= mMaxTotalEntries;
+    if (valid) {
+        hitCounts.resize(header.numEntries);
+        ssize_t size = hitCounts.size() * sizeof(MultifileHitCount);
+        valid = read(fd, static_cast<void*>(hitCounts.data()), size) == size &&
+                header.crc == crc32c(reinterpret_cast<uint8_t*>(hitCounts.data()), size);
+    }
+    close(fd);
+
+    if (!valid) {
+        ALOGE("STATS(LOAD): Stats file (%s) is damaged, ignoring it", cacheStats.c_str());
+        return false;
+    }
+
+    for (const MultifileHitCount& hitCount : hitCounts) {
+        if (contains(hitCount.entryHash)) {
+            mEntryStats[hitCount.entryHash].hitCount = hitCount.hitCount;
+        }
+    }
+
+    ALOGV("STATS(LOAD): Loaded hit counts for %zu entries", hitCounts.size());
+    return true;
+}
+
+bool MultifileBlobCache::writeStats(const std::string& baseDir) {
+    std::vector<MultifileHitCount> hitCounts;
+    hitCounts.reserve(mEntryStats.size());
+    for (const auto& [entryHash, entryStats] : mEntryStats) {
+        if (entryStats.hitCount > 0) {
+            hitCounts.push_back({entryHash, entryStats.hitCount});
+        }
+    }
+
+    std::string cacheStats = baseDir + "/" + kMultifileBlobCacheStatsFile;
+    if (hitCounts.empty()) {
+        // Nothing to record, don't leave a stale stats file behind either
+        if (remove(cacheStats.c_str()) != 0 && errno != ENOENT) {
+            ALOGE("STATS(WRITE): Unable to remove stats file: %s, error: %s", cacheStats.c_str(),
+                  std::strerror(errno));
+            return false;
+        }
+        ALOGV("STATS(WRITE): No hit counts to write");
+        return true;
+    }
+
+    size_t size = hitCounts.size() * sizeof(MultifileHitCount);
+    MultifileStatsHeader header = {kMultifileStatsMagic,
+                                   crc32c(reinterpret_cast<uint8_t*>(hitCounts.data()), size),
+                                   static_cast<uint32_t>(hitCounts.size())};
+
+    int fd = open(cacheStats.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        ALOGE("STATS(WRITE): Unable to create stats file: %s, error: %s", cacheStats.c_str(),
+              std::strerror(errno));
+        return false;
+    }
+
+    bool success = write(fd, &header, sizeof(header)) == sizeof(header) &&
+            write(fd, hitCounts.data(), size) == static_cast<ssize_t>(size);
+    close(fd);
+    if (!success) {
+        ALOGE("STATS(WRITE): Error writing stats file: %s, error %s", cacheStats.c_str(),
+              std::strerror(errno));
+        remove(cacheStats.c_str());
+        return false;
+    }
+
+    ALOGV("STATS(WRITE): Wrote hit counts for %zu entries", hitCounts.size());
+    return true;
+}
+
+bool MultifileBlobCache::loadPack(uint32_t packId) {
+    std::string packPath = getEntryPath(0, packId);
+    mNextPackId = std::max(mNextPackId, packId + 1);
+
+    int fd = open(packPath.c_str(), O_RDONLY);
+    if (fd == -1) {
+        ALOGE("INIT: Failed to open pack %s, error: %s", packPath.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    // Read in the header and index, and make sure they are intact
+    struct stat st;
+    MultifilePackHeader header;
+    std::vector<MultifilePackEntry> packEntries;
+    bool valid = fstat(fd, &st) == 0 &&
+            read(fd, static_cast<void*>(&header), sizeof(header)) == sizeof(header) &&
+            header.magic == kMultifilePackMagic &&
+            header.numEntries <= (st.st_size - sizeof(header)) / sizeof(MultifilePackEntry);
+    if (valid) {
+        packEntries.resize(header.numEntries);
+        ssize_t size = packEntries.size() * sizeof(MultifilePackEntry);
+        valid = read(fd, static_cast<void*>(packEntries.data()), size) == size &&
+                header.crc == crc32c(reinterpret_cast<uint8_t*>(packEntries.data()), size);
+    }
+    close(fd);
+
+    if (!valid) {
+        ALOGE("INIT: Pack %u is damaged! Removing.", packId);
+        if (remove(packPath.c_str()) != 0) {
+            ALOGE("INIT: Error removing %s: %s", packPath.c_str(), std::strerror(errno));
+        }
+        return false;
+    }
+
+    // Track the entries that have not been replaced since they were packed
+    size_t packSize = static_cast<size_t>(st.st_size);
+    size_t liveEntries = 0;
+    for (const MultifilePackEntry& packEntry : packEntries) {
+        if (packEntry.fileSize <= sizeof(MultifileHeader) || packEntry.valueSize <= 0 ||
+            packEntry.offset > packSize || packEntry.fileSize > packSize - packEntry.offset) {
+            ALOGE("INIT: Pack %u has a bad entry for %u, skipping it", packId,
+                  packEntry.entryHash);
+            continue;
+        }
+        if (contains(packEntry.entryHash)) {
+            continue;
+        }
+
+        trackEntry(packEntry.entryHash, packEntry.valueSize, packEntry.fileSize, st.st_atime);
+        mEntryStats[packEntry.entryHash].packId = packId;
+        mEntryStats[packEntry.entryHash].packOffset = packEntry.offset;
+        increaseTotalCacheSize(packEntry.fileSize);
+        liveEntries++;
+    }
+
+    if (liveEntries == 0) {
+        ALOGV("INIT: Pack %u has no live entries, removing it", packId);
+        if (remove(packPath.c_str()) != 0) {
+            ALOGE("INIT: Error removing %s: %s", packPath.c_str(), std::strerror(errno));
+        }
+        return true;
+    }
+
+    ALOGV("INIT: Pack %u is good, tracking %zu entries", packId, liveEntries);
+    mPackEntries[packId] = liveEntries;
+    return true;
+}
+
 void MultifileBlobCache::trackEntry(uint32_t entryHash, EGLsizeiANDROID valueSize, size_t fileSize,
                                     time_t accessTime) {
     mEntries.insert(entryHash);
-    mEntryStats[entryHash] = {valueSize, fileSize, accessTime};
+    mEntryStats[entryHash] = {valueSize, fileSize, accessTime, 0, kMultifileNoPack, 0};
 }
 
 bool MultifileBlobCache::contains(uint32_t hashEntry) const {
@@ -650,6 +843,93 @@ void MultifileBlobCache::decreaseTotalCacheSize(size_t fileSize) {
     mTotalCacheEntries--;
 }
 
+std::string MultifileBlobCache::getEntryPath(uint32_t entryHash, uint32_t packId) const {
+    if (packId == kMultifileNoPack) {
+        return mMultifileDirName + "/" + std::to_string(entryHash);
+    }
+    return mMultifileDirName + "/" + kMultifileBlobCachePackPrefix + std::to_string(packId);
+}
+
+// Read an entry into a new buffer and check its CRC. This only depends on the
+// location, so it is safe to call from the worker thread.
+uint8_t* MultifileBlobCache::readEntry(const MultifileEntryLocation& location) const {
+    std::string fullPath = getEntryPath(location.entryHash, location.packId);
+    int fd = open(fullPath.c_str(), O_RDONLY);
+    if (fd == -1) {
+        ALOGE("Cache error - failed to open fullPath: %s, error: %s", fullPath.c_str(),
+              std::strerror(errno));
+        return nullptr;
+    }
+
+    uint8_t* buffer = new uint8_t[location.fileSize];
+    ssize_t result = pread(fd, buffer, location.fileSize, location.offset);
+    close(fd);
+    if (result != static_cast<ssize_t>(location.fileSize)) {
+        ALOGE("Error reading entry %u from %s: %s", location.entryHash, fullPath.c_str(),
+              std::strerror(errno));
+        delete[] buffer;
+        return nullptr;
+    }
+
+    // Ensure we have a good magic and CRC
+    MultifileHeader* header = reinterpret_cast<MultifileHeader*>(buffer);
+    if (header->magic != kMultifileMagic ||
+        header->crc !=
+                crc32c(buffer + sizeof(MultifileHeader),
+                       location.fileSize - sizeof(MultifileHeader))) {
+        ALOGV("Entry %u failed CRC check!", location.entryHash);
+        delete[] buffer;
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+// Remove the storage of an entry, which is either its own file or a slot in a pack file
+bool MultifileBlobCache::removeEntryFile(uint32_t entryHash) {
+    MultifileEntryStats entryStats = getEntryStats(entryHash);
+    if (entryStats.packId != kMultifileNoPack) {
+        releasePackEntry(entryStats.packId);
+        return true;
+    }
+
+    std::string entryPath = getEntryPath(entryHash, kMultifileNoPack);
+    if (remove(entryPath.c_str()) != 0) {
+        ALOGE("Error removing %s: %s", entryPath.c_str(), std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+// Pack files are immutable, so they are deleted once none of their entries are live
+void MultifileBlobCache::releasePackEntry(uint32_t packId) {
+    auto packIter = mPackEntries.find(packId);
+    if (packIter == mPackEntries.end()) {
+        return;
+    }
+
+    if (--packIter->second == 0) {
+        ALOGV("PACK: Pack %u has no live entries, removing it", packId);
+        std::string packPath = getEntryPath(0, packId);
+        if (remove(packPath.c_str()) != 0) {
+            ALOGE("PACK: Error removing %s: %s", packPath.c_str(), std::strerror(errno));
+        }
+        mPackEntries.erase(packIter);
+    }
+}
+
+bool MultifileBlobCache::removeEntry(uint32_t entryHash) {
+    MultifileEntryStats entryStats = getEntryStats(entryHash);
+    decreaseTotalCacheSize(entryStats.fileSize);
+    removeFromHotCache(entryHash);
+    invalidateBackgroundWork(entryHash);
+
+    bool removed = removeEntryFile(entryHash);
+    mEntries.erase(entryHash);
+    mEntryStats.erase(entryHash);
+    return removed;
+}
+
 bool MultifileBlobCache::addToHotCache(uint32_t newEntryHash, int newFd, uint8_t* newEntryBuffer,
                                        size_t newEntrySize) {
     ALOGV("HOTCACHE(ADD): Adding %u to hot cache", newEntryHash);
@@ -663,7 +943,7 @@ bool MultifileBlobCache::addToHotCache(uint32_t newEntryHash, int newFd, uint8_t
 
         // Wait for all the files to complete writing so our hot cache is accurate
         ALOGV("HOTCACHE(ADD): Waiting for work to complete for %u", newEntryHash);
-        waitForWorkComplete();
+        waitForDeferredWrites();
 
         // Free up old entries until under the limit
         for (auto hotCacheIter = mHotCache.begin(); hotCacheIter != mHotCache.end();) {
@@ -700,7 +980,7 @@ bool MultifileBlobCache::removeFromHotCache(uint32_t entryHash) {
 
         // Wait for all the files to complete writing so our hot cache is accurate
         ALOGV("HOTCACHE(REMOVE): Waiting for work to complete for %u", entryHash);
-        waitForWorkComplete();
+        waitForDeferredWrites();
 
         ALOGV("HOTCACHE(REMOVE): Closing hot cache entry for %u", entryHash);
         MultifileHotCache entry = mHotCache[entryHash];
@@ -730,10 +1010,12 @@ bool MultifileBlobCache::applyLRU(size_t cacheSizeLimit, size_t cacheEntryLimit)
         // Remove it from hot cache if present
         removeFromHotCache(entryHash);
 
+        // Drop anything read or packed for it in the background
+        invalidateBackgroundWork(entryHash);
+
         // Remove it from the system
-        std::string entryPath = mMultifileDirName + "/" + std::to_string(entryHash);
-        if (remove(entryPath.c_str()) != 0) {
-            ALOGE("LRU: Error removing %s: %s", entryPath.c_str(), std::strerror(errno));
+        if (!removeEntryFile(entryHash)) {
+            ALOGE("LRU: Error removing entry %u", entryHash);
             return false;
         }
 
@@ -741,6 +1023,7 @@ bool MultifileBlobCache::applyLRU(size_t cacheSizeLimit, size_t cacheEntryLimit)
         cacheEntryIter++;
 
         // Delete the entry from our tracking
+        mEntries.erase(entryHash);
         size_t count = mEntryStats.erase(entryHash);
         if (count != 1) {
             ALOGE("LRU: Failed to remove entryHash (%u) from mEntryStats", entryHash);
@@ -814,8 +1097,259 @@ void MultifileBlobCache::trimCache() {
     }
 }
 
-// This function performs a task.  It only knows how to write files to disk,
-// but it could be expanded if needed.
+// Queue a task to read the most used entries, up to the size of the hot cache
+void MultifileBlobCache::queuePrefetch() {
+    std::vector<std::pair<uint32_t, MultifileEntryStats>> candidates(mEntryStats.begin(),
+                                                                     mEntryStats.end());
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.second.hitCount != rhs.second.hitCount) {
+            return lhs.second.hitCount > rhs.second.hitCount;
+        }
+        return lhs.second.accessTime > rhs.second.accessTime;
+    });
+
+    std::vector<MultifileEntryLocation> entries;
+    size_t prefetchSize = 0;
+    for (const auto& [entryHash, entryStats] : candidates) {
+        if (prefetchSize + entryStats.fileSize > mHotCacheLimit) {
+            continue;
+        }
+        entries.push_back({entryHash, entryStats.packId, entryStats.packOffset,
+                           entryStats.fileSize});
+        prefetchSize += entryStats.fileSize;
+    }
+
+    if (entries.empty()) {
+        return;
+    }
+
+    ALOGV("PREFETCH: Queueing prefetch of %zu entries, %zu bytes", entries.size(), prefetchSize);
+    {
+        std::lock_guard<std::mutex> lock(mBackgroundMutex);
+        mPendingBackgroundTasks++;
+    }
+    DeferredTask task(TaskCommand::Prefetch);
+    task.initPrefetch(std::move(entries));
+    queueTask(std::move(task));
+}
+
+// Queue a task to pack small standalone entries into a single file, once there are enough
+void MultifileBlobCache::queueCompaction() {
+    std::vector<MultifileEntryLocation> entries;
+    size_t packSize = 0;
+    for (const auto& [entryHash, entryStats] : mEntryStats) {
+        if (entryStats.packId != kMultifileNoPack ||
+            entryStats.fileSize > kCompactionEntrySizeLimit) {
+            continue;
+        }
+        if (packSize + entryStats.fileSize > kCompactionPackSizeLimit) {
+            break;
+        }
+        entries.push_back({entryHash, kMultifileNoPack, 0, entryStats.fileSize});
+        packSize += entryStats.fileSize;
+    }
+
+    if (entries.size() < kCompactionMinEntries) {
+        return;
+    }
+
+    ALOGV("COMPACT: Queueing compaction of %zu entries into pack %u", entries.size(),
+          mNextPackId);
+    {
+        std::lock_guard<std::mutex> lock(mBackgroundMutex);
+        mPendingBackgroundTasks++;
+    }
+    DeferredTask task(TaskCommand::Compact);
+    task.initCompact(mNextPackId++, std::move(entries));
+    queueTask(std::move(task));
+}
+
+// Drop prefetched contents of an entry and keep queued work from publishing stale results
+void MultifileBlobCache::invalidateBackgroundWork(uint32_t entryHash) {
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    auto prefetchedIter = mPrefetchedEntries.find(entryHash);
+    if (prefetchedIter != mPrefetchedEntries.end()) {
+        delete[] prefetchedIter->second.entryBuffer;
+        mPrefetchedEntries.erase(prefetchedIter);
+    }
+    mInvalidatedEntries.insert(entryHash);
+}
+
+bool MultifileBlobCache::takePrefetchedEntry(uint32_t entryHash,
+                                             MultifilePrefetchedEntry* entry) {
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    auto prefetchedIter = mPrefetchedEntries.find(entryHash);
+    if (prefetchedIter == mPrefetchedEntries.end()) {
+        return false;
+    }
+    *entry = prefetchedIter->second;
+    mPrefetchedEntries.erase(prefetchedIter);
+    return true;
+}
+
+// Switch entries over to the pack files written by the worker and remove their own files
+void MultifileBlobCache::applyCompactionResults() {
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    for (const auto& [packId, entries] : mCompactionResults) {
+        size_t liveEntries = 0;
+        for (const MultifileEntryLocation& location : entries) {
+            uint32_t entryHash = location.entryHash;
+            if (mInvalidatedEntries.count(entryHash) != 0 || !contains(entryHash)) {
+                continue;
+            }
+            MultifileEntryStats& entryStats = mEntryStats[entryHash];
+            if (entryStats.packId != kMultifileNoPack || entryStats.fileSize != location.fileSize) {
+                continue;
+            }
+
+            std::string entryPath = getEntryPath(entryHash, kMultifileNoPack);
+            if (remove(entryPath.c_str()) != 0) {
+                ALOGE("COMPACT: Error removing %s: %s", entryPath.c_str(), std::strerror(errno));
+                continue;
+            }
+            entryStats.packId = packId;
+            entryStats.packOffset = location.offset;
+            liveEntries++;
+        }
+
+        ALOGV("COMPACT: Pack %u holds %zu live entries", packId, liveEntries);
+        if (liveEntries == 0) {
+            std::string packPath = getEntryPath(0, packId);
+            if (remove(packPath.c_str()) != 0) {
+                ALOGE("COMPACT: Error removing %s: %s", packPath.c_str(), std::strerror(errno));
+            }
+        } else {
+            mPackEntries[packId] = liveEntries;
+        }
+    }
+    mCompactionResults.clear();
+
+    // Once nothing is in flight, no result can be stale anymore
+    if (mPendingBackgroundTasks == 0) {
+        mInvalidatedEntries.clear();
+    }
+}
+
+void MultifileBlobCache::freePrefetchedEntries() {
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    for (auto& [entryHash, entry] : mPrefetchedEntries) {
+        delete[] entry.entryBuffer;
+    }
+    mPrefetchedEntries.clear();
+}
+
+// Runs on the worker thread. Reads entries and publishes them for get to pick up.
+void MultifileBlobCache::processPrefetch(DeferredTask& task) {
+    for (const MultifileEntryLocation& location : task.getEntries()) {
+        {
+            std::lock_guard<std::mutex> lock(mBackgroundMutex);
+            if (mInvalidatedEntries.count(location.entryHash) != 0) {
+                continue;
+            }
+        }
+
+        uint8_t* buffer = readEntry(location);
+        if (buffer == nullptr) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mBackgroundMutex);
+        if (mInvalidatedEntries.count(location.entryHash) != 0 ||
+            mPrefetchedEntries.count(location.entryHash) != 0) {
+            delete[] buffer;
+            continue;
+        }
+        ALOGV("PREFETCH: Read entry %u", location.entryHash);
+        mPrefetchedEntries[location.entryHash] = {buffer, location.fileSize};
+    }
+
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    mPendingBackgroundTasks--;
+}
+
+// Runs on the worker thread. Writes a new pack file and publishes its contents; the
+// main thread removes the standalone files once it switches the entries over.
+void MultifileBlobCache::processCompact(DeferredTask& task) {
+    uint32_t packId = task.getPackId();
+    std::vector<MultifileEntryLocation>& entries = task.getEntries();
+
+    // Read the entries, skipping ones that changed or fail their CRC check
+    std::vector<uint8_t*> buffers;
+    std::vector<MultifileEntryLocation> packed;
+    for (const MultifileEntryLocation& location : entries) {
+        {
+            std::lock_guard<std::mutex> lock(mBackgroundMutex);
+            if (mInvalidatedEntries.count(location.entryHash) != 0) {
+                continue;
+            }
+        }
+        uint8_t* buffer = readEntry(location);
+        if (buffer != nullptr) {
+            buffers.push_back(buffer);
+            packed.push_back(location);
+        }
+    }
+
+    // Lay out the index, then the entries
+    std::vector<MultifilePackEntry> packEntries;
+    size_t offset = sizeof(MultifilePackHeader) + packed.size() * sizeof(MultifilePackEntry);
+    for (size_t i = 0; i < packed.size(); i++) {
+        MultifileHeader* header = reinterpret_cast<MultifileHeader*>(buffers[i]);
+        packed[i].packId = packId;
+        packed[i].offset = offset;
+        packEntries.push_back({packed[i].entryHash, static_cast<uint32_t>(offset),
+                               static_cast<uint32_t>(packed[i].fileSize), header->valueSize});
+        offset += packed[i].fileSize;
+    }
+    size_t indexSize = packEntries.size() * sizeof(MultifilePackEntry);
+    MultifilePackHeader header = {kMultifilePackMagic,
+                                  crc32c(reinterpret_cast<uint8_t*>(packEntries.data()),
+                                         indexSize),
+                                  static_cast<uint32_t>(packEntries.size())};
+
+    // Write to a temporary file and rename it, so a pack file is always complete
+    std::string packPath = getEntryPath(0, packId);
+    std::string tempPath = packPath + ".tmp";
+    bool success = false;
+    if (!packed.empty()) {
+        int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (fd == -1) {
+            ALOGE("COMPACT: Unable to create %s, error: %s", tempPath.c_str(),
+                  std::strerror(errno));
+        } else {
+            success = write(fd, &header, sizeof(header)) == sizeof(header) &&
+                    write(fd, packEntries.data(), indexSize) == static_cast<ssize_t>(indexSize);
+            for (size_t i = 0; success && i < packed.size(); i++) {
+                success = write(fd, buffers[i], packed[i].fileSize) ==
+                        static_cast<ssize_t>(packed[i].fileSize);
+            }
+            close(fd);
+            if (!success) {
+                ALOGE("COMPACT: Error writing %s: %s", tempPath.c_str(), std::strerror(errno));
+            } else if (rename(tempPath.c_str(), packPath.c_str()) != 0) {
+                ALOGE("COMPACT: Error renaming %s: %s", tempPath.c_str(), std::strerror(errno));
+                success = false;
+            }
+            if (!success) {
+                remove(tempPath.c_str());
+            }
+        }
+    }
+
+    for (uint8_t* buffer : buffers) {
+        delete[] buffer;
+    }
+
+    ALOGV("COMPACT: Packed %zu entries into %s", success ? packed.size() : 0, packPath.c_str());
+    std::lock_guard<std::mutex> lock(mBackgroundMutex);
+    if (success) {
+        mCompactionResults.emplace_back(packId, std::move(packed));
+    }
+    mPendingBackgroundTasks--;
+}
+
+// This function performs a task.  It writes files to disk, and prefetches and
+// compacts entries in the background.
 void MultifileBlobCache::processTask(DeferredTask& task) {
     switch (task.getTaskCommand()) {
         case TaskCommand::Exit: {
@@ -833,27 +1367,25 @@ void MultifileBlobCache::processTask(DeferredTask& task) {
             if (fd == -1) {
                 ALOGE("Cache error in SET - failed to open fullPath: %s, error: %s",
                       fullPath.c_str(), std::strerror(errno));
-                return;
-            }
-
-            ALOGV("DEFERRED: Opened fd %i from %s", fd, fullPath.c_str());
+            } else {
+                ALOGV("DEFERRED: Opened fd %i from %s", fd, fullPath.c_str());
 
-            // Add CRC check to the header (always do this last!)
-            MultifileHeader* header = reinterpret_cast<MultifileHeader*>(buffer);
-            header->crc =
-                    crc32c(buffer + sizeof(MultifileHeader), bufferSize - sizeof(MultifileHeader));
+                // Add CRC check to the header (always do this last!)
+                MultifileHeader* header = reinterpret_cast<MultifileHeader*>(buffer);
+                header->crc = crc32c(buffer + sizeof(MultifileHeader),
+                                     bufferSize - sizeof(MultifileHeader));
 
-            ssize_t result = write(fd, buffer, bufferSize);
-            if (result != bufferSize) {
-                ALOGE("Error writing fileSize to cache entry (%s): %s", fullPath.c_str(),
-                      std::strerror(errno));
-                return;
+                ssize_t result = write(fd, buffer, bufferSize);
+                if (result != bufferSize) {
+                    ALOGE("Error writing fileSize to cache entry (%s): %s", fullPath.c_str(),
+                          std::strerror(errno));
+                } else {
+                    ALOGV("DEFERRED: Completed write for: %s", fullPath.c_str());
+                }
+                close(fd);
             }
 
-            ALOGV("DEFERRED: Completed write for: %s", fullPath.c_str());
-            close(fd);
-
-            // Erase the entry from mDeferredWrites
+            // Erase the entry from mDeferredWrites, even if the write failed
             // Since there could be multiple outstanding writes for an entry, find the matching one
             {
                 // Synchronize access to deferred write status
@@ -868,10 +1400,21 @@ void MultifileBlobCache::processTask(DeferredTask& task) {
                         break;
                     }
                 }
+                if (mDeferredWrites.empty()) {
+                    mDeferredWritesCondition.notify_all();
+                }
             }
 
             return;
         }
+        case TaskCommand::Prefetch: {
+            processPrefetch(task);
+            return;
+        }
+        case TaskCommand::Compact: {
+            processCompact(task);
+            return;
+        }
         default: {
             ALOGE("DEFERRED: Unhandled task type");
             return;
@@ -934,4 +1477,11 @@ void MultifileBlobCache::waitForWorkComplete() {
     mWorkerIdleCondition.wait(lock, [this] { return (mTasks.empty() && mWorkerThreadIdle); });
 }
 
+// Wait until all deferred writes have been completed, without waiting for
+// background prefetch or compaction
+void MultifileBlobCache::waitForDeferredWrites() {
+    std::unique_lock<std::mutex> lock(mDeferredWriteStatusMutex);
+    mDeferredWritesCondition.wait(lock, [this] { return mDeferredWrites.empty(); });
+}
+
 }; // namespace android
@@ -23,12 +23,14 @@
 #include <android-base/thread_annotations.h>
 #include <cutils/properties.h>
 #include <future>
+#include <limits>
 #include <map>
 #include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "FileBlobCache.h"
 
@@ -36,6 +38,11 @@ namespace android {
 
 constexpr uint32_t kMultifileBlobCacheVersion = 1;
 constexpr char kMultifileBlobCacheStatusFile[] = "cache.status";
+constexpr char kMultifileBlobCacheStatsFile[] = "cache.stats";
+constexpr char kMultifileBlobCachePackPrefix[] = "pack.";
+
+// Entries that do not live in a pack file use this as their packId
+constexpr uint32_t kMultifileNoPack = std::numeric_limits<uint32_t>::max();
 
 struct MultifileHeader {
     uint32_t magic;
@@ -48,6 +55,52 @@ struct MultifileEntryStats {
     EGLsizeiANDROID valueSize;
     size_t fileSize;
     time_t accessTime;
+    // Number of cache hits, persisted across runs in the stats file
+    uint32_t hitCount;
+    // Pack file containing the entry and its offset there, or kMultifileNoPack
+    // if the entry lives in its own file
+    uint32_t packId;
+    size_t packOffset;
+};
+
+// Header of the stats file, followed by numEntries MultifileHitCount records
+struct MultifileStatsHeader {
+    uint32_t magic;
+    uint32_t crc;
+    uint32_t numEntries;
+};
+
+struct MultifileHitCount {
+    uint32_t entryHash;
+    uint32_t hitCount;
+};
+
+// Header of a pack file, followed by numEntries MultifilePackEntry records and
+// then the entries. Each entry has the same layout as a standalone entry file.
+struct MultifilePackHeader {
+    uint32_t magic;
+    uint32_t crc;
+    uint32_t numEntries;
+};
+
+struct MultifilePackEntry {
+    uint32_t entryHash;
+    uint32_t offset;
+    uint32_t fileSize;
+    EGLsizeiANDROID valueSize;
+};
+
+// Where an entry can be read from, handed to the worker thread
+struct MultifileEntryLocation {
+    uint32_t entryHash;
+    uint32_t packId;
+    size_t offset;
+    size_t fileSize;
+};
+
+struct MultifilePrefetchedEntry {
+    uint8_t* entryBuffer;
+    size_t entrySize;
 };
 
 struct MultifileStatus {
@@ -66,6 +119,8 @@ struct MultifileHotCache {
 enum class TaskCommand {
     Invalid = 0,
     WriteToDisk,
+    Prefetch,
+    Compact,
     Exit,
 };
 
@@ -85,11 +140,25 @@ public:
         mBufferSize = bufferSize;
     }
 
+    void initPrefetch(std::vector<MultifileEntryLocation> entries) {
+        mCommand = TaskCommand::Prefetch;
+        mEntries = std::move(entries);
+    }
+
+    void initCompact(uint32_t packId, std::vector<MultifileEntryLocation> entries) {
+        mCommand = TaskCommand::Compact;
+        mPackId = packId;
+        mEntries = std::move(entries);
+    }
+
     uint32_t getEntryHash() { return mEntryHash; }
     std::string& getFullPath() { return mFullPath; }
     uint8_t* getBuffer() { return mBuffer; }
     size_t getBufferSize() { return mBufferSize; };
 
+    uint32_t getPackId() { return mPackId; }
+    std::vector<MultifileEntryLocation>& getEntries() { return mEntries; }
+
 private:
     TaskCommand mCommand;
 
@@ -98,6 +167,10 @@ private:
     std::string mFullPath;
     uint8_t* mBuffer;
     size_t mBufferSize;
+
+    // Parameters for Prefetch and Compact
+    uint32_t mPackId = kMultifileNoPack;
+    std::vector<MultifileEntryLocation> mEntries;
 };
 
 class MultifileBlobCache {
@@ -132,9 +205,18 @@ private:
     bool createStatus(const std::string& baseDir);
     bool checkStatus(const std::string& baseDir);
 
+    bool loadStats(const std::string& baseDir);
+    bool writeStats(const std::string& baseDir);
+    bool loadPack(uint32_t packId);
+
     size_t getFileSize(uint32_t entryHash);
     size_t getValueSize(uint32_t entryHash);
 
+    std::string getEntryPath(uint32_t entryHash, uint32_t packId) const;
+    uint8_t* readEntry(const MultifileEntryLocation& location) const;
+    bool removeEntryFile(uint32_t entryHash);
+    void releasePackEntry(uint32_t packId);
+
     void increaseTotalCacheSize(size_t fileSize);
     void decreaseTotalCacheSize(size_t fileSize);
 
@@ -145,6 +227,13 @@ private:
     void trimCache();
     bool applyLRU(size_t cacheSizeLimit, size_t cacheEntryLimit);
 
+    void queuePrefetch();
+    void queueCompaction();
+    void invalidateBackgroundWork(uint32_t entryHash);
+    bool takePrefetchedEntry(uint32_t entryHash, MultifilePrefetchedEntry* entry);
+    void applyCompactionResults();
+    void freePrefetchedEntries();
+
     bool mInitialized;
     std::string mMultifileDirName;
 
@@ -165,12 +254,38 @@ private:
     size_t mHotCacheEntryLimit;
     size_t mHotCacheSize;
 
+    // Number of live entries in each pack file, and the id for the next one
+    std::unordered_map<uint32_t, size_t> mPackEntries;
+    uint32_t mNextPackId;
+
     // Below are the components used for deferred writes
 
     // Track whether we have pending writes for an entry
     std::mutex mDeferredWriteStatusMutex;
     std::multimap<uint32_t, uint8_t*> mDeferredWrites GUARDED_BY(mDeferredWriteStatusMutex);
 
+    // This condition will block the main thread while deferred writes are outstanding
+    std::condition_variable mDeferredWritesCondition;
+
+    // Below are the results of background prefetch and compaction. The worker
+    // thread only reads files and publishes results here; the main thread
+    // applies them to the cache state.
+    std::mutex mBackgroundMutex;
+    // Entries read ahead of use, moved into the hot cache on first get
+    std::unordered_map<uint32_t, MultifilePrefetchedEntry> mPrefetchedEntries
+            GUARDED_BY(mBackgroundMutex);
+    // Pack files written by the worker, with the entries they contain
+    std::vector<std::pair<uint32_t, std::vector<MultifileEntryLocation>>> mCompactionResults
+            GUARDED_BY(mBackgroundMutex);
+    // Entries changed or removed since background work was queued, whose
+    // background results are stale
+    std::unordered_set<uint32_t> mInvalidatedEntries GUARDED_BY(mBackgroundMutex);
+    // Number of queued prefetch and compaction tasks that have not completed
+    size_t mPendingBackgroundTasks GUARDED_BY(mBackgroundMutex);
+
+    void processPrefetch(DeferredTask& task);
+    void processCompact(DeferredTask& task);
+
     // Functions to work through tasks in the queue
     void processTasks();
     void processTasksImpl(bool* exitThread);
@@ -182,6 +297,9 @@ private:
     // Used by main thread to wait for worker thread to complete all outstanding work.
     void waitForWorkComplete();
 
+    // Used by main thread to wait for worker thread to complete all deferred writes.
+    void waitForDeferredWrites();
+
     std::thread mTaskThread;
     std::queue<DeferredTask> mTasks;
     std::mutex mWorkerMutex;
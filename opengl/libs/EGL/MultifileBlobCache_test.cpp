@@ -53,6 +53,8 @@ protected:
 
     int getFileDescriptorCount();
     std::vector<std::string> getCacheEntries();
+    size_t getPackFileCount();
+    void reopenCache();
 
     void clearProperties();
 
@@ -322,11 +324,13 @@ std::vector<std::string> MultifileBlobCacheTest::getCacheEntries() {
                 if (entry->d_name == "."s || entry->d_name == ".."s) {
                     continue;
                 }
-                if (strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0) {
+                if (strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0 ||
+                    strcmp(entry->d_name, kMultifileBlobCacheStatsFile) == 0) {
                     continue;
                 }
                 cacheEntries.push_back(multifileDirName + "/" + entry->d_name);
             }
+            closedir(dir);
         } else {
             printf("Unable to open %s, error: %s\n", multifileDirName.c_str(),
                    std::strerror(errno));
@@ -503,4 +507,146 @@ TEST_F(MultifileBlobCacheTest, MismatchedBuildIdClears) {
     ASSERT_EQ(getCacheEntries().size(), 0);
 }
 
+size_t MultifileBlobCacheTest::getPackFileCount() {
+    size_t packFiles = 0;
+    for (const std::string& cacheEntry : getCacheEntries()) {
+        std::string name = cacheEntry.substr(cacheEntry.rfind('/') + 1);
+        if (name.rfind(kMultifileBlobCachePackPrefix, 0) == 0) {
+            packFiles++;
+        }
+    }
+    return packFiles;
+}
+
+// Close the cache so everything writes out, then open it again
+void MultifileBlobCacheTest::reopenCache() {
+    mMBC->finish();
+    mMBC.reset();
+    mMBC.reset(new MultifileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize, kMaxTotalEntries,
+                                      &mTempFile->path[0]));
+}
+
+// Verify the cache status and stats files are not counted as entries
+TEST_F(MultifileBlobCacheTest, CacheContainsStats) {
+    struct stat info;
+    std::stringstream statsFile;
+    statsFile << &mTempFile->path[0] << ".multifile/" << kMultifileBlobCacheStatsFile;
+
+    mMBC->set("abcd", 4, "efgh", 4);
+    char buf[4];
+    ASSERT_EQ(4, mMBC->get("abcd", 4, buf, 4));
+    reopenCache();
+
+    // Ensure stats were written out next to the single entry
+    ASSERT_TRUE(stat(statsFile.str().c_str(), &info) == 0);
+    ASSERT_EQ(getCacheEntries().size(), 1);
+}
+
+// Verify no stats file is written when no entry has been hit
+TEST_F(MultifileBlobCacheTest, NoStatsWithoutHits) {
+    struct stat info;
+    std::stringstream statsFile;
+    statsFile << &mTempFile->path[0] << ".multifile/" << kMultifileBlobCacheStatsFile;
+
+    mMBC->set("abcd", 4, "efgh", 4);
+    reopenCache();
+
+    ASSERT_NE(stat(statsFile.str().c_str(), &info), 0);
+    ASSERT_EQ(getCacheEntries().size(), 1);
+}
+
+// Verify entries survive a restart, including the ones read ahead by prefetch
+TEST_F(MultifileBlobCacheTest, PrefetchedEntriesMatch) {
+    for (int i = 0; i < 8; i++) {
+        mMBC->set(&i, sizeof(i), &i, sizeof(i));
+    }
+    // Use some entries more than others, so they are picked for prefetch
+    for (int i = 0; i < 4; i++) {
+        int result = 0;
+        ASSERT_EQ(sizeof(i), mMBC->get(&i, sizeof(i), &result, sizeof(result)));
+    }
+
+    reopenCache();
+
+    for (int i = 0; i < 8; i++) {
+        int result = 0;
+        ASSERT_EQ(sizeof(i), mMBC->get(&i, sizeof(i), &result, sizeof(result)));
+        ASSERT_EQ(i, result);
+    }
+}
+
+// Verify small entries are packed together after a restart, and still readable
+TEST_F(MultifileBlobCacheTest, SmallEntriesArePacked) {
+    const int numEntries = kMaxTotalEntries / 2;
+    for (int i = 0; i < numEntries; i++) {
+        mMBC->set(&i, sizeof(i), &i, sizeof(i));
+    }
+    reopenCache();
+
+    // Compaction runs in the background, and is applied by the next call
+    mMBC->finish();
+    ASSERT_EQ(getPackFileCount(), 1);
+    ASSERT_LT(getCacheEntries().size(), numEntries);
+
+    for (int i = 0; i < numEntries; i++) {
+        int result = 0;
+        ASSERT_EQ(sizeof(i), mMBC->get(&i, sizeof(i), &result, sizeof(result)));
+        ASSERT_EQ(i, result);
+    }
+
+    // Packed entries are found again after another restart
+    reopenCache();
+    ASSERT_EQ(mMBC->getTotalEntries(), numEntries);
+    for (int i = 0; i < numEntries; i++) {
+        int result = 0;
+        ASSERT_EQ(sizeof(i), mMBC->get(&i, sizeof(i), &result, sizeof(result)));
+        ASSERT_EQ(i, result);
+    }
+}
+
+// Verify a value set after its entry was packed replaces the packed one
+TEST_F(MultifileBlobCacheTest, SetReplacesPackedEntry) {
+    const int numEntries = kMaxTotalEntries / 2;
+    for (int i = 0; i < numEntries; i++) {
+        mMBC->set(&i, sizeof(i), &i, sizeof(i));
+    }
+    reopenCache();
+    mMBC->finish();
+    ASSERT_EQ(getPackFileCount(), 1);
+
+    int key = 0;
+    int newValue = 1234;
+    mMBC->set(&key, sizeof(key), &newValue, sizeof(newValue));
+    reopenCache();
+
+    int result = 0;
+    ASSERT_EQ(sizeof(result), mMBC->get(&key, sizeof(key), &result, sizeof(result)));
+    ASSERT_EQ(newValue, result);
+}
+
+// Verify a damaged entry is dropped when it is read
+TEST_F(MultifileBlobCacheTest, CorruptedEntryIsRemoved) {
+    mMBC->set("abcd", 4, "efgh", 4);
+    mMBC->finish();
+    mMBC.reset();
+
+    // Stomp on the end of the entry, which holds the value
+    std::vector<std::string> cacheEntries = getCacheEntries();
+    ASSERT_EQ(cacheEntries.size(), 1);
+    const char* stomp = "BADF";
+    std::fstream fs(cacheEntries[0]);
+    fs.seekp(-strlen(stomp), std::ios_base::end);
+    fs.write(stomp, strlen(stomp));
+    fs.flush();
+    fs.close();
+
+    mMBC.reset(new MultifileBlobCache(kMaxKeySize, kMaxValueSize, kMaxTotalSize, kMaxTotalEntries,
+                                      &mTempFile->path[0]));
+    unsigned char buf[4] = {0xee, 0xee, 0xee, 0xee};
+    mMBC->finish();
+    ASSERT_EQ(size_t(0), mMBC->get("abcd", 4, buf, 4));
+    ASSERT_EQ(0xee, buf[0]);
+    ASSERT_EQ(getCacheEntries().size(), 0);
+}
+
 } // namespace android
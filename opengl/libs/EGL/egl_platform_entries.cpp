@@ -45,6 +45,7 @@
 #include "egl_display.h"
 #include "egl_layers.h"
 #include "egl_object.h"
+#include "egl_proc_hash.h"
 #include "egl_tls.h"
 #include "egl_trace.h"
 
@@ -224,13 +225,11 @@ static std::unordered_map<std::string, int> sGLExtensionSlotMap;
 static int sGLExtensionSlot = 0;
 static pthread_mutex_t sExtensionMapMutex = PTHREAD_MUTEX_INITIALIZER;
 
-static void (*findProcAddress(const char* name, const extension_map_t* map, size_t n))() {
-    for (uint32_t i = 0; i < n; i++) {
-        if (!strcmp(name, map[i].name)) {
-            return map[i].address;
-        }
-    }
-    return nullptr;
+static void (*findProcAddress(const char* name))() {
+    // Index the table the first time an extension is looked up
+    static const ProcHashIndex sExtensionIndex(sExtensionMap);
+    const extension_map_t* entry = sExtensionIndex.find(name);
+    return entry ? entry->address : nullptr;
 }
 
 // ----------------------------------------------------------------------------
@@ -1162,7 +1161,7 @@ __eglMustCastToProperFunctionPointerType eglGetProcAddressImpl(const char* procn
     }
 
     __eglMustCastToProperFunctionPointerType addr;
-    addr = findProcAddress(procname, sExtensionMap, NELEM(sExtensionMap));
+    addr = findProcAddress(procname);
     if (addr) return addr;
 
     addr = findBuiltinWrapper(procname);
@@ -2611,16 +2610,13 @@ EGLFuncPointer FindPlatformImplAddr(const char* name) {
         return nullptr;
     }
 
-    for (int i = 0; i < NELEM(sPlatformImplMap); i++) {
-        if (sPlatformImplMap[i].name == nullptr) {
-            ALOGV("FindPlatformImplAddr found nullptr for sPlatformImplMap[%i].name (%s)", i, name);
-            return nullptr;
-        }
-        if (!strcmp(name, sPlatformImplMap[i].name)) {
-            ALOGV("FindPlatformImplAddr found %llu for sPlatformImplMap[%i].address (%s)",
-                  (unsigned long long)sPlatformImplMap[i].address, i, name);
-            return sPlatformImplMap[i].address;
-        }
+    // Index the table the first time it is searched
+    static const ProcHashIndex sPlatformImplIndex(sPlatformImplMap);
+    const implementation_map_t* entry = sPlatformImplIndex.find(name);
+    if (entry) {
+        ALOGV("FindPlatformImplAddr found %llu for sPlatformImplMap[%td].address (%s)",
+              (unsigned long long)entry->address, entry - sPlatformImplMap, name);
+        return entry->address;
     }
 
     ALOGV("FindPlatformImplAddr did not find an entry for %s", name);
@@ -0,0 +1,173 @@
+/*
+ ** Copyright 2024, The Android Open Source Project
+ **
+ ** Licensed under the Apache License, Version 2.0 (the "License");
+ ** you may not use this file except in compliance with the License.
+ ** You may obtain a copy of the License at
+ **
+ **     http://www.apache.org/licenses/LICENSE-2.0
+ **
+ ** Unless required by applicable law or agreed to in writing, software
+ ** distributed under the License is distributed on an "AS IS" BASIS,
+ ** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ ** See the License for the specific language governing permissions and
+ ** limitations under the License.
+ */
+
+#ifndef ANDROID_EGL_PROC_HASH_H
+#define ANDROID_EGL_PROC_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace android {
+
+// procHash returns the 32-bit FNV-1a hash of an entry point name.
+inline uint32_t procHash(const char* name) {
+    uint32_t hash = 0x811c9dc5u;
+    for (; *name; name++) {
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 0x01000193u;
+    }
+    return hash;
+}
+
+// procHashMix rehashes a name hash with a seed.
+inline uint32_t procHashMix(uint32_t hash, uint32_t seed) {
+    hash ^= seed * 0x9e3779b9u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// A ProcHashIndex is a minimal perfect hash over the names of a table of entry
+// points, where each Entry has a 'name' member.  A lookup costs two hashes and
+// a single string compare, regardless of the size of the table.
+//
+// It uses the same hash and displace scheme as the tables the Vulkan loader
+// generates, see perfect_hash() in vulkan/scripts/generator_common.py.  The
+// EGL tables hold function pointer casts, which can not be evaluated at
+// compile time, so the index is built when it is constructed instead.
+//
+// If no perfect hash is found, for example because the table has duplicate
+// names, lookups fall back to a linear search of the table.
+template <typename Entry, size_t N>
+class ProcHashIndex {
+public:
+    explicit ProcHashIndex(const Entry (&entries)[N]) : mEntries(entries) {
+        mValid = build();
+    }
+
+    // find returns the entry with the given name, or nullptr if there is none.
+    const Entry* find(const char* name) const {
+        if (!mValid) {
+            for (size_t i = 0; i < N; i++) {
+                if (!strcmp(name, mEntries[i].name)) {
+                    return &mEntries[i];
+                }
+            }
+            return nullptr;
+        }
+        uint32_t hash = procHash(name);
+        uint32_t seed = mSeeds[procHashMix(hash, 0) % kBucketCount];
+        const Entry& entry = mEntries[mSlots[procHashMix(hash, seed) % N]];
+        return !strcmp(name, entry.name) ? &entry : nullptr;
+    }
+
+private:
+    static_assert(N > 0, "ProcHashIndex needs at least one entry");
+    static_assert(N <= UINT16_MAX, "ProcHashIndex slots hold 16-bit entry indices");
+
+    static constexpr size_t kBucketCount = (N + 3) / 4;
+    static constexpr uint32_t kMaxSeed = 1 << 16;
+
+    // build finds a seed for each bucket that places all of its entries into
+    // free slots, starting with the largest buckets while most slots are free.
+    bool build() {
+        uint32_t hashes[N];
+        size_t bucketOf[N];
+        size_t bucketStart[kBucketCount + 1] = {};
+        for (size_t i = 0; i < N; i++) {
+            hashes[i] = procHash(mEntries[i].name);
+            bucketOf[i] = procHashMix(hashes[i], 0) % kBucketCount;
+            bucketStart[bucketOf[i] + 1]++;
+        }
+        for (size_t b = 0; b < kBucketCount; b++) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        // Group the entries by bucket
+        size_t members[N];
+        size_t bucketFill[kBucketCount] = {};
+        for (size_t i = 0; i < N; i++) {
+            members[bucketStart[bucketOf[i]] + bucketFill[bucketOf[i]]++] = i;
+        }
+
+        bool bucketDone[kBucketCount] = {};
+        bool slotUsed[N] = {};
+        for (size_t b = 0; b < kBucketCount; b++) {
+            mSeeds[b] = 0;
+        }
+
+        for (size_t pass = 0; pass < kBucketCount; pass++) {
+            size_t bucket = kBucketCount;
+            for (size_t b = 0; b < kBucketCount; b++) {
+                if (!bucketDone[b] &&
+                    (bucket == kBucketCount || bucketFill[b] > bucketFill[bucket])) {
+                    bucket = b;
+                }
+            }
+            bucketDone[bucket] = true;
+            if (bucketFill[bucket] == 0) {
+                break;
+            }
+
+            const size_t* first = &members[bucketStart[bucket]];
+            const size_t* last = first + bucketFill[bucket];
+            uint32_t seed = 1;
+            while (!tryPlace(first, last, seed, hashes, slotUsed)) {
+                if (++seed > kMaxSeed) {
+                    return false;
+                }
+            }
+            mSeeds[bucket] = seed;
+        }
+        return true;
+    }
+
+    // tryPlace stores the entries of a bucket into their slots for the given
+    // seed, unless two of them collide or one lands on a slot already used.
+    bool tryPlace(const size_t* first, const size_t* last, uint32_t seed,
+                  const uint32_t* hashes, bool* slotUsed) {
+        for (const size_t* member = first; member != last; member++) {
+            size_t slot = procHashMix(hashes[*member], seed) % N;
+            if (slotUsed[slot]) {
+                for (const size_t* placed = first; placed != member; placed++) {
+                    slotUsed[procHashMix(hashes[*placed], seed) % N] = false;
+                }
+                return false;
+            }
+            slotUsed[slot] = true;
+            mSlots[slot] = static_cast<uint16_t>(*member);
+        }
+        return true;
+    }
+
+    const Entry (&mEntries)[N];
+
+    // mValid is false if no perfect hash was found for the table.
+    bool mValid;
+
+    // mSeeds holds the seed of each bucket.
+    uint32_t mSeeds[kBucketCount];
+
+    // mSlots maps each hash slot to the index of its entry in mEntries.
+    uint16_t mSlots[N];
+};
+
+} // namespace android
+
+#endif // ANDROID_EGL_PROC_HASH_H
@@ -0,0 +1,109 @@
+/*
+ ** Copyright 2024, The Android Open Source Project
+ **
+ ** Licensed under the Apache License, Version 2.0 (the "License");
+ ** you may not use this file except in compliance with the License.
+ ** You may obtain a copy of the License at
+ **
+ **     http://www.apache.org/licenses/LICENSE-2.0
+ **
+ ** Unless required by applicable law or agreed to in writing, software
+ ** distributed under the License is distributed on an "AS IS" BASIS,
+ ** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ ** See the License for the specific language governing permissions and
+ ** limitations under the License.
+ */
+
+#include "egl_proc_hash.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace android {
+
+struct TestEntry {
+    const char* name;
+    int value;
+};
+
+static const TestEntry sTestEntries[] = {
+        {"eglGetDisplay", 0},
+        {"eglInitialize", 1},
+        {"eglTerminate", 2},
+        {"eglGetConfigs", 3},
+        {"eglChooseConfig", 4},
+        {"eglCreateWindowSurface", 5},
+        {"eglDestroySurface", 6},
+        {"eglCreateContext", 7},
+        {"eglMakeCurrent", 8},
+        {"eglSwapBuffers", 9},
+        {"eglGetProcAddress", 10},
+        {"eglCreateImageKHR", 11},
+        {"eglDestroyImageKHR", 12},
+        {"eglCreateSyncKHR", 13},
+        {"eglPresentationTimeANDROID", 14},
+        {"glGetString", 15},
+        {"glGetStringi", 16},
+};
+
+TEST(ProcHashIndexTest, FindsEveryEntry) {
+    ProcHashIndex index(sTestEntries);
+    for (const TestEntry& entry : sTestEntries) {
+        const TestEntry* found = index.find(entry.name);
+        ASSERT_NE(nullptr, found) << entry.name;
+        ASSERT_EQ(entry.value, found->value);
+    }
+}
+
+TEST(ProcHashIndexTest, MissingNamesAreNotFound) {
+    ProcHashIndex index(sTestEntries);
+    ASSERT_EQ(nullptr, index.find(""));
+    ASSERT_EQ(nullptr, index.find("eglGetDisplayX"));
+    ASSERT_EQ(nullptr, index.find("eglGetDispla"));
+    ASSERT_EQ(nullptr, index.find("glGetStringj"));
+    ASSERT_EQ(nullptr, index.find("eglSetBlobCacheFuncsANDROID"));
+}
+
+TEST(ProcHashIndexTest, SingleEntry) {
+    static const TestEntry entries[] = {{"eglGetError", 42}};
+    ProcHashIndex index(entries);
+    ASSERT_NE(nullptr, index.find("eglGetError"));
+    ASSERT_EQ(42, index.find("eglGetError")->value);
+    ASSERT_EQ(nullptr, index.find("eglGetErrors"));
+}
+
+TEST(ProcHashIndexTest, DuplicateNamesFindFirstEntry) {
+    static const TestEntry entries[] = {
+            {"eglWaitGL", 0},
+            {"eglWaitNative", 1},
+            {"eglWaitGL", 2},
+    };
+    ProcHashIndex index(entries);
+    ASSERT_EQ(0, index.find("eglWaitGL")->value);
+    ASSERT_EQ(1, index.find("eglWaitNative")->value);
+    ASSERT_EQ(nullptr, index.find("eglWaitClient"));
+}
+
+TEST(ProcHashIndexTest, LargeTable) {
+    constexpr size_t kNumEntries = 2048;
+    static std::vector<std::string> names;
+    static TestEntry entries[kNumEntries];
+    for (size_t i = 0; i < kNumEntries; i++) {
+        names.push_back("glExtensionFunction" + std::to_string(i) + "EXT");
+    }
+    for (size_t i = 0; i < kNumEntries; i++) {
+        entries[i] = {names[i].c_str(), static_cast<int>(i)};
+    }
+
+    ProcHashIndex index(entries);
+    for (size_t i = 0; i < kNumEntries; i++) {
+        const TestEntry* found = index.find(names[i].c_str());
+        ASSERT_NE(nullptr, found) << names[i];
+        ASSERT_EQ(static_cast<int>(i), found->value);
+    }
+    ASSERT_EQ(nullptr, index.find("glExtensionFunction2048EXT"));
+}
+
+} // namespace android
@@ -122,7 +122,8 @@ std::string EGLCacheTest::getCachefileName() {
         if ((dir = opendir(multifileDirName.c_str())) != nullptr) {
             while ((entry = readdir(dir)) != nullptr) {
                 if (entry->d_name == "."s || entry->d_name == ".."s ||
-                    strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0) {
+                    strcmp(entry->d_name, kMultifileBlobCacheStatusFile) == 0 ||
+                    strcmp(entry->d_name, kMultifileBlobCacheStatsFile) == 0) {
                     continue;
                 }
                 cachefileName = multifileDirName + "/" + entry->d_name;
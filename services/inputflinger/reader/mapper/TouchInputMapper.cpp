@@ -39,6 +39,11 @@ static constexpr nsecs_t STYLUS_DATA_LATENCY = ms2ns(10);
 
 // Minimum width between two pointers to determine a gesture as freeform gesture in mm
 static const float MIN_FREEFORM_GESTURE_WIDTH_IN_MILLIMETER = 30;
+
+// Maximum number of raw values for which the tilt trigonometry is tabulated per axis. Devices with
+// larger tilt ranges fall back to computing the values for every sample.
+static constexpr size_t MAX_TILT_TABLE_SIZE = 1024;
+
 // --- Static Definitions ---
 
 static const DisplayViewport kUninitializedViewport;
@@ -210,6 +215,7 @@ void TouchInputMapper::dump(std::string& dump) {
     dump += StringPrintf(INDENT3 "Translation and Scaling Factors:\n");
     mRawToDisplay.dump(dump, "RawToDisplay Transform:", INDENT4);
     mRawRotation.dump(dump, "RawRotation Transform:", INDENT4);
+    mRawToCookedDisplay.dump(dump, "RawToCookedDisplay Transform:", INDENT4);
     dump += StringPrintf(INDENT4 "OrientedXPrecision: %0.3f\n", mOrientedXPrecision);
     dump += StringPrintf(INDENT4 "OrientedYPrecision: %0.3f\n", mOrientedYPrecision);
     dump += StringPrintf(INDENT4 "GeometricScale: %0.3f\n", mGeometricScale);
@@ -222,6 +228,8 @@ void TouchInputMapper::dump(std::string& dump) {
     dump += StringPrintf(INDENT4 "TiltXScale: %0.3f\n", mTiltXScale);
     dump += StringPrintf(INDENT4 "TiltYCenter: %0.3f\n", mTiltYCenter);
     dump += StringPrintf(INDENT4 "TiltYScale: %0.3f\n", mTiltYScale);
+    dump += StringPrintf(INDENT4 "TiltTableSizes: x=%zu, y=%zu\n", mTiltXTable.size(),
+                         mTiltYTable.size());
 
     dump += StringPrintf(INDENT3 "Last Raw Button State: 0x%08x\n", mLastRawState.buttonState);
     dump += StringPrintf(INDENT3 "Last Raw Touch: pointerCount=%d\n",
@@ -1024,6 +1032,7 @@ void TouchInputMapper::configureInputDevice(nsecs_t when, bool* outResetNeeded)
             mRawToDisplay.set(-mRawPointerAxes.x.minValue, -mRawPointerAxes.y.minValue);
             mRawToRotatedDisplay = mRawToDisplay;
         }
+        updateCookingTables();
     }
 
     // If moving between pointer modes, need to reset some state.
@@ -1389,6 +1398,7 @@ void TouchInputMapper::dumpAffineTransformation(std::string& dump) {
 void TouchInputMapper::updateAffineTransformation() {
     mAffineTransform = getPolicy()->getTouchAffineTransformation(getDeviceContext().getDescriptor(),
                                                                  mInputDeviceOrientation);
+    updateCookingTables();
 }
 
 std::list<NotifyArgs> TouchInputMapper::reset(nsecs_t when) {
@@ -2288,6 +2298,67 @@ const BitSet32& TouchInputMapper::findActiveIdBits(const CookedPointerData& cook
     return cookedPointerData.hoveringIdBits;
 }
 
+void TouchInputMapper::updateCookingTables() {
+    // Fold the location calibration into the raw-to-display transform.
+    ui::Transform affine;
+    affine.set({mAffineTransform.x_scale, mAffineTransform.x_ymix, mAffineTransform.x_offset,
+                mAffineTransform.y_xmix, mAffineTransform.y_scale, mAffineTransform.y_offset, 0, 0,
+                1});
+    mRawToCookedDisplay = mRawToDisplay * affine;
+
+    // Tilt
+    mTiltXTable.clear();
+    mTiltYTable.clear();
+    if (mHaveTilt) {
+        mTiltXTable = buildTiltTable(mRawPointerAxes.tiltX, mTiltXCenter, mTiltXScale);
+        mTiltYTable = buildTiltTable(mRawPointerAxes.tiltY, mTiltYCenter, mTiltYScale);
+    }
+
+    // Vector orientation. Only the low byte of the raw value is significant: the high nybble and
+    // low nybble are the signed components of the orientation vector.
+    for (size_t i = 0; i < mVectorOrientationTable.size(); i++) {
+        const int32_t c1 = signExtendNybble((i & 0xf0) >> 4);
+        const int32_t c2 = signExtendNybble(i & 0x0f);
+        VectorOrientationEntry& entry = mVectorOrientationTable[i];
+        if (c1 != 0 || c2 != 0) {
+            entry.orientation = transformAngle(mRawRotation, atan2f(c1, c2) * 0.5f);
+            entry.scale = 1.0f + hypotf(c1, c2) / 16.0f;
+        } else {
+            entry.orientation = 0;
+            entry.scale = 1.0f;
+        }
+    }
+}
+
+std::vector<TouchInputMapper::TiltEntry> TouchInputMapper::buildTiltTable(
+        const RawAbsoluteAxisInfo& axis, float center, float scale) {
+    std::vector<TiltEntry> table;
+    if (!axis.valid || axis.maxValue < axis.minValue ||
+        static_cast<int64_t>(axis.maxValue) - axis.minValue >=
+                static_cast<int64_t>(MAX_TILT_TABLE_SIZE)) {
+        return table;
+    }
+    table.reserve(axis.maxValue - axis.minValue + 1);
+    for (int32_t value = axis.minValue; value <= axis.maxValue; value++) {
+        const float angle = (value - center) * scale;
+        table.push_back({sinf(angle), cosf(angle)});
+    }
+    return table;
+}
+
+TouchInputMapper::TiltEntry TouchInputMapper::lookupTilt(const std::vector<TiltEntry>& table,
+                                                         const RawAbsoluteAxisInfo& axis,
+                                                         int32_t value, float center,
+                                                         float scale) {
+    const int64_t index = static_cast<int64_t>(value) - axis.minValue;
+    if (index >= 0 && index < static_cast<int64_t>(table.size())) {
+        return table[index];
+    }
+    // Out of range or untabulated values are computed directly.
+    const float angle = (value - center) * scale;
+    return {sinf(angle), cosf(angle)};
+}
+
 void TouchInputMapper::cookPointerData() {
     uint32_t currentPointerCount = mCurrentRawState.rawPointerData.pointerCount;
 
@@ -2408,10 +2479,12 @@ void TouchInputMapper::cookPointerData() {
         float tilt;
         float orientation;
         if (mHaveTilt) {
-            float tiltXAngle = (in.tiltX - mTiltXCenter) * mTiltXScale;
-            float tiltYAngle = (in.tiltY - mTiltYCenter) * mTiltYScale;
-            orientation = transformAngle(mRawRotation, atan2f(-sinf(tiltXAngle), sinf(tiltYAngle)));
-            tilt = acosf(cosf(tiltXAngle) * cosf(tiltYAngle));
+            const TiltEntry tiltX = lookupTilt(mTiltXTable, mRawPointerAxes.tiltX, in.tiltX,
+                                               mTiltXCenter, mTiltXScale);
+            const TiltEntry tiltY = lookupTilt(mTiltYTable, mRawPointerAxes.tiltY, in.tiltY,
+                                               mTiltYCenter, mTiltYScale);
+            orientation = transformAngle(mRawRotation, atan2f(-tiltX.sin, tiltY.sin));
+            tilt = acosf(tiltX.cos * tiltY.cos);
         } else {
             tilt = 0;
 
@@ -2420,19 +2493,13 @@ void TouchInputMapper::cookPointerData() {
                     orientation = transformAngle(mRawRotation, in.orientation * mOrientationScale);
                     break;
                 case Calibration::OrientationCalibration::VECTOR: {
-                    int32_t c1 = signExtendNybble((in.orientation & 0xf0) >> 4);
-                    int32_t c2 = signExtendNybble(in.orientation & 0x0f);
-                    if (c1 != 0 || c2 != 0) {
-                        orientation = transformAngle(mRawRotation, atan2f(c1, c2) * 0.5f);
-                        float confidence = hypotf(c1, c2);
-                        float scale = 1.0f + confidence / 16.0f;
-                        touchMajor *= scale;
-                        touchMinor /= scale;
-                        toolMajor *= scale;
-                        toolMinor /= scale;
-                    } else {
-                        orientation = 0;
-                    }
+                    const VectorOrientationEntry& entry =
+                            mVectorOrientationTable[in.orientation & 0xff];
+                    orientation = entry.orientation;
+                    touchMajor *= entry.scale;
+                    touchMinor /= entry.scale;
+                    toolMajor *= entry.scale;
+                    toolMinor /= entry.scale;
                     break;
                 }
                 default:
@@ -2451,9 +2518,7 @@ void TouchInputMapper::cookPointerData() {
         }
 
         // Adjust X,Y coords for device calibration and convert to the natural display coordinates.
-        vec2 transformed = {in.x, in.y};
-        mAffineTransform.applyTo(transformed.x /*byRef*/, transformed.y /*byRef*/);
-        transformed = mRawToDisplay.transform(transformed);
+        const vec2 transformed = mRawToCookedDisplay.transform(vec2{in.x, in.y});
 
         // Write output coords.
         PointerCoords& out = mCurrentCookedState.cookedPointerData.pointerCoords[i];
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <stdint.h>
 #include <ui/Rotation.h>
@@ -446,6 +448,30 @@ private:
     float mTiltYCenter;
     float mTiltYScale;
 
+    // The following are derived from the calibration and the transforms above whenever the device
+    // is reconfigured, so that cookPointerData() can avoid redundant per-sample computations.
+    // See updateCookingTables().
+
+    // The composition of mAffineTransform followed by mRawToDisplay.
+    ui::Transform mRawToCookedDisplay;
+
+    // Sine and cosine of the tilt angle for every raw tilt value in the axis range. Empty if the
+    // device does not report tilt or if the raw range is too large to tabulate.
+    struct TiltEntry {
+        float sin;
+        float cos;
+    };
+    std::vector<TiltEntry> mTiltXTable;
+    std::vector<TiltEntry> mTiltYTable;
+
+    // Cooked orientation and size scale for every value of the low byte of the raw orientation
+    // axis, used when the orientation calibration is VECTOR.
+    struct VectorOrientationEntry {
+        float orientation;
+        float scale;
+    };
+    std::array<VectorOrientationEntry, 256> mVectorOrientationTable;
+
     bool mExternalStylusConnected;
 
     // Oriented motion ranges for input device info.
@@ -751,6 +777,12 @@ private:
                                                                      BitSet32 idBits,
                                                                      nsecs_t readTime);
     const BitSet32& findActiveIdBits(const CookedPointerData& cookedPointerData);
+    void updateCookingTables();
+    static std::vector<TiltEntry> buildTiltTable(const RawAbsoluteAxisInfo& axis, float center,
+                                                 float scale);
+    static TiltEntry lookupTilt(const std::vector<TiltEntry>& table,
+                                const RawAbsoluteAxisInfo& axis, int32_t value, float center,
+                                float scale);
     void cookPointerData();
     [[nodiscard]] std::list<NotifyArgs> abortTouches(nsecs_t when, nsecs_t readTime,
                                                      uint32_t policyFlags);
@@ -24,6 +24,7 @@
 #include <android-base/stringprintf.h>
 #include <gui/TraceUtils.h>
 #include <renderengine/impl/ExternalTexture.h>
+#include <ui/PixelFormat.h>
 
 #include "ClientCache.h"
 
@@ -33,15 +34,19 @@ ANDROID_SINGLETON_STATIC_INSTANCE(ClientCache);
 
 ClientCache::ClientCache() : mDeathRecipient(sp<CacheDeathRecipient>::make()) {}
 
-bool ClientCache::getBuffer(const client_cache_t& cacheId,
+ClientCache::Shard& ClientCache::getShard(const wp<IBinder>& processToken) {
+    return mShards[std::hash<IBinder*>{}(processToken.unsafe_get()) % kShardCount];
+}
+
+bool ClientCache::getBuffer(Shard& shard, const client_cache_t& cacheId,
                             ClientCacheBuffer** outClientCacheBuffer) {
     auto& [processToken, id] = cacheId;
     if (processToken == nullptr) {
         ALOGE_AND_TRACE("ClientCache::getBuffer - invalid (nullptr) process token");
         return false;
     }
-    auto it = mBuffers.find(processToken);
-    if (it == mBuffers.end()) {
+    auto it = shard.buffers.find(processToken);
+    if (it == shard.buffers.end()) {
         ALOGE_AND_TRACE("ClientCache::getBuffer - invalid process token");
         return false;
     }
@@ -72,13 +77,14 @@ ClientCache::add(const client_cache_t& cacheId, const sp<GraphicBuffer>& buffer)
         return base::unexpected(AddError::Unspecified);
     }
 
-    std::lock_guard lock(mMutex);
+    Shard& shard = getShard(processToken);
+    std::lock_guard lock(shard.mutex);
     sp<IBinder> token;
 
     // If this is a new process token, set a death recipient. If the client process dies, we will
     // get a callback through binderDied.
-    auto it = mBuffers.find(processToken);
-    if (it == mBuffers.end()) {
+    auto it = shard.buffers.find(processToken);
+    if (it == shard.buffers.end()) {
         token = processToken.promote();
         if (!token) {
             ALOGE_AND_TRACE("ClientCache::add - invalid token");
@@ -94,9 +100,7 @@ ClientCache::add(const client_cache_t& cacheId, const sp<GraphicBuffer>& buffer)
             }
         }
         auto [itr, success] =
-                mBuffers.emplace(processToken,
-                                 std::make_pair(token,
-                                                std::unordered_map<uint64_t, ClientCacheBuffer>()));
+                shard.buffers.emplace(processToken, std::make_pair(token, ProcessBuffers()));
         LOG_ALWAYS_FATAL_IF(!success, "failed to insert new process into client cache");
         it = itr;
     }
@@ -122,10 +126,12 @@ sp<GraphicBuffer> ClientCache::erase(const client_cache_t& cacheId) {
     sp<GraphicBuffer> buffer;
     auto& [processToken, id] = cacheId;
     std::vector<sp<ErasedRecipient>> pendingErase;
+    std::shared_ptr<renderengine::ExternalTexture> erasedTexture;
     {
-        std::lock_guard lock(mMutex);
+        Shard& shard = getShard(processToken);
+        std::lock_guard lock(shard.mutex);
         ClientCacheBuffer* buf = nullptr;
-        if (!getBuffer(cacheId, &buf)) {
+        if (!getBuffer(shard, cacheId, &buf)) {
             ALOGE("failed to erase buffer, could not retrieve buffer");
             return nullptr;
         }
@@ -139,9 +145,14 @@ sp<GraphicBuffer> ClientCache::erase(const client_cache_t& cacheId) {
             }
         }
 
-        mBuffers[processToken].second.erase(id);
+        erasedTexture = std::move(buf->buffer);
+        shard.buffers.find(processToken)->second.second.erase(id);
     }
 
+    // The texture is released outside of the shard lock, but still before the recipients are
+    // notified, so that they never observe an erased buffer that is still mapped.
+    erasedTexture.reset();
+
     for (auto& recipient : pendingErase) {
         recipient->bufferErased(cacheId);
     }
@@ -149,23 +160,31 @@ sp<GraphicBuffer> ClientCache::erase(const client_cache_t& cacheId) {
 }
 
 std::shared_ptr<renderengine::ExternalTexture> ClientCache::get(const client_cache_t& cacheId) {
-    std::lock_guard lock(mMutex);
-
+    Shard& shard = getShard(cacheId.token);
+    shard.mutex.lock_shared();
     ClientCacheBuffer* buf = nullptr;
-    if (!getBuffer(cacheId, &buf)) {
+    std::shared_ptr<renderengine::ExternalTexture> buffer;
+    if (getBuffer(shard, cacheId, &buf)) {
+        buffer = buf->buffer;
+    }
+    shard.mutex.unlock_shared();
+
+    if (!buffer) {
         ALOGE("failed to get buffer, could not retrieve buffer");
+        mMisses++;
         return nullptr;
     }
-
-    return buf->buffer;
+    mHits++;
+    return buffer;
 }
 
 bool ClientCache::registerErasedRecipient(const client_cache_t& cacheId,
                                           const wp<ErasedRecipient>& recipient) {
-    std::lock_guard lock(mMutex);
+    Shard& shard = getShard(cacheId.token);
+    std::lock_guard lock(shard.mutex);
 
     ClientCacheBuffer* buf = nullptr;
-    if (!getBuffer(cacheId, &buf)) {
+    if (!getBuffer(shard, cacheId, &buf)) {
         ALOGV("failed to register erased recipient, could not retrieve buffer");
         return false;
     }
@@ -175,10 +194,11 @@ bool ClientCache::registerErasedRecipient(const client_cache_t& cacheId,
 
 void ClientCache::unregisterErasedRecipient(const client_cache_t& cacheId,
                                             const wp<ErasedRecipient>& recipient) {
-    std::lock_guard lock(mMutex);
+    Shard& shard = getShard(cacheId.token);
+    std::lock_guard lock(shard.mutex);
 
     ClientCacheBuffer* buf = nullptr;
-    if (!getBuffer(cacheId, &buf)) {
+    if (!getBuffer(shard, cacheId, &buf)) {
         ALOGE("failed to unregister erased recipient");
         return;
     }
@@ -187,31 +207,39 @@ void ClientCache::unregisterErasedRecipient(const client_cache_t& cacheId,
 }
 
 void ClientCache::removeProcess(const wp<IBinder>& processToken) {
-    std::vector<std::pair<sp<ErasedRecipient>, client_cache_t>> pendingErase;
+    if (processToken == nullptr) {
+        ALOGE("failed to remove process, invalid (nullptr) process token");
+        return;
+    }
+
+    // Detach all of the process's buffers in one step, so that they are released once the shard
+    // lock is no longer held.
+    decltype(Shard::buffers)::node_type process;
     {
-        if (processToken == nullptr) {
-            ALOGE("failed to remove process, invalid (nullptr) process token");
-            return;
-        }
-        std::lock_guard lock(mMutex);
-        auto itr = mBuffers.find(processToken);
-        if (itr == mBuffers.end()) {
+        Shard& shard = getShard(processToken);
+        std::lock_guard lock(shard.mutex);
+        auto itr = shard.buffers.find(processToken);
+        if (itr == shard.buffers.end()) {
             ALOGE("failed to remove process, could not find process");
             return;
         }
+        process = shard.buffers.extract(itr);
+    }
 
-        for (auto& [id, clientCacheBuffer] : itr->second.second) {
-            client_cache_t cacheId = {processToken, id};
-            for (auto& recipient : clientCacheBuffer.recipients) {
-                sp<ErasedRecipient> erasedRecipient = recipient.promote();
-                if (erasedRecipient) {
-                    pendingErase.emplace_back(erasedRecipient, cacheId);
-                }
+    std::vector<std::pair<sp<ErasedRecipient>, client_cache_t>> pendingErase;
+    for (auto& [id, clientCacheBuffer] : process.mapped().second) {
+        client_cache_t cacheId = {processToken, id};
+        for (auto& recipient : clientCacheBuffer.recipients) {
+            sp<ErasedRecipient> erasedRecipient = recipient.promote();
+            if (erasedRecipient) {
+                pendingErase.emplace_back(erasedRecipient, cacheId);
             }
         }
-        mBuffers.erase(itr);
     }
 
+    // As in erase(), release the buffers before notifying the recipients.
+    process = {};
+
     for (auto& [recipient, cacheId] : pendingErase) {
         recipient->bufferErased(cacheId);
     }
@@ -222,16 +250,41 @@ void ClientCache::CacheDeathRecipient::binderDied(const wp<IBinder>& who) {
 }
 
 void ClientCache::dump(std::string& result) {
-    std::lock_guard lock(mMutex);
-    for (const auto& [_, cache] : mBuffers) {
-        base::StringAppendF(&result, " Cache owner: %p\n", cache.first.get());
-
-        for (const auto& [id, entry] : cache.second) {
-            const auto& buffer = entry.buffer->getBuffer();
-            base::StringAppendF(&result, "\tID: %" PRIu64 ", size: %ux%u\n", id, buffer->getWidth(),
-                                buffer->getHeight());
+    size_t processCount = 0;
+    size_t bufferCount = 0;
+    uint64_t bytesHeld = 0;
+    for (auto& shard : mShards) {
+        shard.mutex.lock_shared();
+        for (const auto& [_, cache] : shard.buffers) {
+            uint64_t processBytes = 0;
+            std::string entries;
+            for (const auto& [id, entry] : cache.second) {
+                const auto& buffer = entry.buffer->getBuffer();
+                processBytes += static_cast<uint64_t>(buffer->getStride()) * buffer->getHeight() *
+                        bytesPerPixel(buffer->getPixelFormat());
+                base::StringAppendF(&entries, "\tID: %" PRIu64 ", size: %ux%u\n", id,
+                                    buffer->getWidth(), buffer->getHeight());
+            }
+            base::StringAppendF(&result, " Cache owner: %p, buffers: %zu, memory: %.2f MiB\n",
+                                cache.first.get(), cache.second.size(),
+                                static_cast<double>(processBytes) / (1024 * 1024));
+            result.append(entries);
+
+            processCount++;
+            bufferCount += cache.second.size();
+            bytesHeld += processBytes;
         }
+        shard.mutex.unlock_shared();
     }
+
+    const uint64_t hits = mHits;
+    const uint64_t lookups = hits + mMisses;
+    base::StringAppendF(&result,
+                        " Processes: %zu, buffers: %zu, memory held: %.2f MiB, lookups: %" PRIu64
+                        ", hit rate: %.2f%%\n",
+                        processCount, bufferCount, static_cast<double>(bytesHeld) / (1024 * 1024),
+                        lookups,
+                        lookups == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / lookups);
 }
 
 } // namespace android
@@ -18,14 +18,16 @@
 
 #include <android-base/thread_annotations.h>
 #include <binder/IBinder.h>
+#include <ftl/shared_mutex.h>
 #include <gui/LayerState.h>
 #include <renderengine/RenderEngine.h>
 #include <ui/GraphicBuffer.h>
 #include <utils/RefBase.h>
 #include <utils/Singleton.h>
 
+#include <array>
+#include <atomic>
 #include <map>
-#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -78,16 +80,31 @@ public:
     void dump(std::string& result);
 
 private:
-    std::mutex mMutex;
+    // Processes are spread over a fixed number of shards by their token, so that binder threads
+    // adding and fetching buffers for unrelated processes do not contend on a single lock. Lookups
+    // only take the shard lock shared.
+    static constexpr size_t kShardCount = 16;
 
     struct ClientCacheBuffer {
         std::shared_ptr<renderengine::ExternalTexture> buffer;
         std::set<wp<ErasedRecipient>> recipients;
     };
-    std::map<wp<IBinder> /*caching process*/,
-             std::pair<sp<IBinder> /*strong ref to caching process*/,
-                       std::unordered_map<uint64_t /*cache id*/, ClientCacheBuffer>>>
-            mBuffers GUARDED_BY(mMutex);
+    using ProcessBuffers = std::unordered_map<uint64_t /*cache id*/, ClientCacheBuffer>;
+
+    struct Shard {
+        // TODO (b/257958323): Use std::shared_mutex and RAII once they support
+        // threading annotations.
+        ftl::SharedMutex mutex;
+        std::map<wp<IBinder> /*caching process*/,
+                 std::pair<sp<IBinder> /*strong ref to caching process*/, ProcessBuffers>>
+                buffers GUARDED_BY(mutex);
+    };
+    std::array<Shard, kShardCount> mShards;
+
+    Shard& getShard(const wp<IBinder>& processToken);
+
+    std::atomic<uint64_t> mHits = 0;
+    std::atomic<uint64_t> mMisses = 0;
 
     class CacheDeathRecipient : public IBinder::DeathRecipient {
     public:
@@ -97,8 +114,8 @@ private:
     sp<CacheDeathRecipient> mDeathRecipient;
     renderengine::RenderEngine* mRenderEngine = nullptr;
 
-    bool getBuffer(const client_cache_t& cacheId, ClientCacheBuffer** outClientCacheBuffer)
-            REQUIRES(mMutex);
+    bool getBuffer(Shard& shard, const client_cache_t& cacheId,
+                   ClientCacheBuffer** outClientCacheBuffer) REQUIRES_SHARED(shard.mutex);
 };
 
 }; // namespace android
@@ -225,6 +225,10 @@ private:
 
     std::vector<Run> findCandidateRuns(std::chrono::steady_clock::time_point now) const;
 
+    // Estimates the composition work, in pixels, that flattening the run would save over its
+    // expected lifetime, net of the one-off cost of rendering the new cached set.
+    int64_t estimateRunBenefit(const Run& run) const;
+
     std::optional<Run> findBestRun(std::vector<Run>& runs) const;
 
     void buildCachedSets(std::chrono::steady_clock::time_point now);
@@ -254,6 +258,11 @@ private:
     size_t mCachedSetCreationCount = 0;
     size_t mCachedSetCreationCost = 0;
     std::unordered_map<size_t, size_t> mInvalidatedCachedSetAges;
+    size_t mCandidateRunCount = 0;
+    size_t mNonFirstRunSelectionCount = 0;
+    size_t mCachedSetRenderCount = 0;
+    size_t mCachedSetRenderCost = 0;
+    std::chrono::nanoseconds mCachedSetRenderDuration = 0ns;
 };
 
 } // namespace compositionengine::impl::planner
@@ -75,6 +75,9 @@ public:
 private:
     void dumpUsage(std::string&) const;
 
+    void restorePredictions();
+    void persistPredictionsIfNeeded();
+
     std::unordered_map<LayerId, LayerState> mPreviousLayers;
 
     std::vector<const LayerState*> mCurrentLayers;
@@ -86,6 +89,11 @@ private:
     NonBufferHash mFlattenedHash = 0;
 
     bool mPredictorEnabled = false;
+
+    // File that predictions are persisted to, so that they survive SurfaceFlinger restarts and
+    // reboots. Empty if predictions are not persisted.
+    std::string mPredictionsPath;
+    std::chrono::steady_clock::time_point mLastPredictionsPersistTime;
 };
 
 } // namespace compositionengine::impl::planner
@@ -20,6 +20,8 @@
 
 #include <compositionengine/impl/planner/LayerState.h>
 
+#include <unordered_set>
+
 namespace android::compositionengine::impl::planner {
 
 class LayerStack {
@@ -249,6 +251,37 @@ public:
     void recordResult(std::optional<PredictedPlan> predictedPlan, NonBufferHash flattenedHash,
                       const std::vector<const LayerState*>&, bool hasSkippedLayers, Plan result);
 
+    // Serializes the most frequently hit predictions into a compact, versioned format, so that they
+    // can be restored after SurfaceFlinger restarts. Predictions restored from a previous call
+    // which have not been confirmed yet are written back out as well.
+    std::string serializePredictions();
+
+    // Restores predictions written by serializePredictions. Since the example layer stacks are not
+    // persisted, restored predictions only supply exact matches, and are promoted to full
+    // predictions the first time that the composition result confirms them. Predictions which are
+    // already known are left untouched. Returns false if the data is malformed or was written by
+    // an incompatible version.
+    bool restorePredictions(const std::string& data);
+
+    // Merges predictions written by serializePredictions with ones persisted earlier, e.g. by the
+    // Predictors of other displays sharing the file, and returns the result to write back out. The
+    // given predictions are kept over persisted ones when there are too many, and persisted
+    // predictions in refutedHashes are dropped, so that they are not restored again. persisted is
+    // empty if nothing was persisted yet.
+    static std::string mergeSerializedPredictions(
+            const std::string& data, const std::string& persisted,
+            const std::unordered_set<NonBufferHash>& refutedHashes);
+
+    // Restored predictions which were refuted by a composition result, see
+    // mergeSerializedPredictions.
+    const std::unordered_set<NonBufferHash>& getRefutedRestoredPredictions() const {
+        return mRefutedRestoredPredictions;
+    }
+
+    // True if the set of predictions which would be serialized has changed since the last call to
+    // serializePredictions.
+    bool hasUnserializedPredictions() const { return mHasUnserializedPredictions; }
+
     void dump(std::string&) const;
 
     void compareLayerStacks(NonBufferHash leftHash, NonBufferHash rightHash, std::string&) const;
@@ -267,6 +300,8 @@ private:
     void promoteIfCandidate(NonBufferHash);
     void recordPredictedResult(PredictedPlan, const std::vector<const LayerState*>& layers,
                                Plan result);
+    void recordRestoredResult(PredictedPlan, const std::vector<const LayerState*>& layers,
+                              Plan result);
     bool findSimilarPrediction(const std::vector<const LayerState*>& layers, Plan result);
 
     void dumpPredictionsByFrequency(std::string&) const;
@@ -306,9 +341,27 @@ private:
 
     std::vector<ApproximateStack> mApproximateStacks;
 
+    // Bumped whenever the serialized format, or the way that NonBufferHash is computed, changes.
+    static constexpr const uint32_t kSerializedVersion = 1;
+    static constexpr const size_t kMaxSerializedPredictions = 128;
+    static constexpr const size_t kMaxSerializedPlanLength = 256;
+
+    struct RestoredPrediction {
+        Plan plan;
+        uint32_t hitCount;
+    };
+
+    // Predictions restored from a previous run of SurfaceFlinger, which have not been confirmed
+    // or refuted by a composition result yet.
+    std::unordered_map<NonBufferHash, RestoredPrediction> mRestoredPredictions;
+    // Restored predictions which turned out to be wrong, so that they are not restored again.
+    std::unordered_set<NonBufferHash> mRefutedRestoredPredictions;
+    bool mHasUnserializedPredictions = false;
+
     mutable size_t mExactHitCount = 0;
     mutable size_t mApproximateHitCount = 0;
     mutable size_t mMissCount = 0;
+    mutable size_t mRestoredHitCount = 0;
 };
 
 // Defining PrintTo helps with Google Tests.
@@ -26,6 +26,9 @@
 
 #include <gui/TraceUtils.h>
 
+#include <cinttypes>
+#include <limits>
+
 using time_point = std::chrono::steady_clock::time_point;
 using namespace std::chrono_literals;
 
@@ -150,6 +153,10 @@ void Flattener::renderCachedSets(
     }
 
     mNewCachedSet->render(mRenderEngine, mTexturePool, outputState, deviceHandlesColorTransform);
+
+    ++mCachedSetRenderCount;
+    mCachedSetRenderCost += mNewCachedSet->getCreationCost();
+    mCachedSetRenderDuration += std::chrono::steady_clock::now() - now;
 }
 
 void Flattener::dumpLayers(std::string& result) const {
@@ -200,6 +207,22 @@ void Flattener::dump(std::string& result) const {
     base::StringAppendF(&result, "\n    Cached sets created: %zd\n", mCachedSetCreationCount);
     base::StringAppendF(&result, "    Cost: %.2f\n",
                         static_cast<float>(mCachedSetCreationCost) / displayArea);
+    base::StringAppendF(&result, "    Candidate runs: %zd (best run was not the first: %zd)\n",
+                        mCandidateRunCount, mNonFirstRunSelectionCount);
+
+    base::StringAppendF(&result, "\n    Cached sets rendered: %zd\n", mCachedSetRenderCount);
+    if (mCachedSetRenderCount > 0) {
+        const auto renderDurationUs =
+                std::chrono::duration_cast<std::chrono::microseconds>(mCachedSetRenderDuration)
+                        .count();
+        base::StringAppendF(&result, "    Average render time: %.1f us\n",
+                            static_cast<float>(renderDurationUs) / mCachedSetRenderCount);
+        if (mCachedSetRenderCost > 0) {
+            base::StringAppendF(&result, "    Render time per screen-size buffer: %.1f us\n",
+                                static_cast<float>(renderDurationUs) * displayArea /
+                                        mCachedSetRenderCost);
+        }
+    }
 
     const auto lastUpdate =
             std::chrono::duration_cast<std::chrono::milliseconds>(now - mLastGeometryUpdate);
@@ -484,13 +507,64 @@ std::vector<Flattener::Run> Flattener::findCandidateRuns(time_point now) const {
     return runs;
 }
 
+int64_t Flattener::estimateRunBenefit(const Run& run) const {
+    Region coveredRegion;
+    int64_t componentCost = 0;
+    int64_t clientCompositionCost = 0;
+    size_t idleFrames = std::numeric_limits<size_t>::max();
+
+    size_t layerCount = 0;
+    for (auto currentSet = run.getStart(); layerCount < run.getLayerLength(); ++currentSet) {
+        layerCount += currentSet->getLayerCount();
+        componentCost += static_cast<int64_t>(currentSet->getDisplayCost());
+        coveredRegion.orSelf(currentSet->getBounds());
+        idleFrames = std::min(idleFrames, currentSet->getAge());
+
+        // Layers that the HWC did not assign a plane to are redrawn by the GPU every frame. Once
+        // flattened, the cached set is handed to the HWC as a single layer instead.
+        for (const CachedSet::Layer& layer : currentSet->getConstituentLayers()) {
+            if (layer.getState()->getCompositionType() ==
+                aidl::android::hardware::graphics::composer3::Composition::CLIENT) {
+                const Rect displayFrame = layer.getDisplayFrame();
+                clientCompositionCost +=
+                        static_cast<int64_t>(displayFrame.width()) * displayFrame.height();
+            }
+        }
+    }
+
+    const Rect bounds = coveredRegion.getBounds();
+    const int64_t flattenedCost = static_cast<int64_t>(bounds.width()) * bounds.height();
+    const int64_t savedCostPerFrame = componentCost + clientCompositionCost - flattenedCost;
+
+    // A run that has gone without updates for longer is expected to stay idle for longer, so weigh
+    // the per-frame savings by how many frames the most recently updated set has been idle for.
+    const int64_t expectedFrames = static_cast<int64_t>(std::max<size_t>(idleFrames, 1));
+
+    // Rendering the cached set reads every layer in the run and writes the flattened buffer once.
+    const int64_t creationCost = componentCost + flattenedCost;
+
+    return savedCostPerFrame * expectedFrames - creationCost;
+}
+
 std::optional<Flattener::Run> Flattener::findBestRun(std::vector<Flattener::Run>& runs) const {
     if (runs.empty()) {
         return std::nullopt;
     }
 
-    // TODO (b/181192467): Choose the best run, instead of just the first.
-    return runs[0];
+    // Only one cached set is built at a time, so pick the run which is expected to save the most
+    // composition work. Ties go to the earlier run, which sits lower in the layer stack.
+    auto bestRun = runs.cbegin();
+    int64_t bestBenefit = estimateRunBenefit(*bestRun);
+    for (auto run = std::next(runs.cbegin()); run != runs.cend(); ++run) {
+        if (const int64_t benefit = estimateRunBenefit(*run); benefit > bestBenefit) {
+            bestRun = run;
+            bestBenefit = benefit;
+        }
+    }
+
+    ALOGV("[%s] Selected run %td of %zu with an estimated benefit of %" PRId64, __func__,
+          std::distance(runs.cbegin(), bestRun), runs.size(), bestBenefit);
+    return *bestRun;
 }
 
 void Flattener::buildCachedSets(time_point now) {
@@ -521,6 +595,11 @@ void Flattener::buildCachedSets(time_point now) {
         return;
     }
 
+    mCandidateRunCount += runs.size();
+    if (bestRun->getStart() != runs.front().getStart()) {
+        ++mNonFirstRunSelectionCount;
+    }
+
     mNewCachedSet.emplace(*bestRun->getStart());
     mNewCachedSet->setLastUpdate(now);
     auto currentSet = bestRun->getStart();
@@ -20,18 +20,31 @@
 #define LOG_TAG "Planner"
 #define ATRACE_TAG ATRACE_TAG_GRAPHICS
 
+#include <android-base/file.h>
 #include <android-base/properties.h>
+#include <android-base/thread_annotations.h>
 #include <compositionengine/LayerFECompositionState.h>
 #include <compositionengine/impl/OutputLayerCompositionState.h>
 #include <compositionengine/impl/planner/Planner.h>
 
+#include <pthread.h>
+#include <unistd.h>
 #include <utils/Trace.h>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace android::compositionengine::impl::planner {
 
 namespace {
 
+// Minimum time between writes of the persisted predictions, which only happen when the set of
+// predictions has changed.
+constexpr std::chrono::seconds kPredictionsPersistInterval = 30s;
+
 std::optional<Flattener::Tunables::RenderScheduling> buildRenderSchedulingTunables() {
     if (!base::GetBoolProperty(std::string("debug.sf.enable_cached_set_render_scheduling"), true)) {
         return std::nullopt;
@@ -68,6 +81,99 @@ Flattener::Tunables buildFlattenerTuneables() {
     };
 }
 
+// Writes persisted predictions from a background thread, so that the file I/O never runs on the
+// composition thread. It is shared by the Planners of all displays, which also keeps their writes
+// to the shared file from racing with each other.
+class PredictionsWriter {
+public:
+    static PredictionsWriter& getInstance() {
+        static PredictionsWriter sInstance;
+        return sInstance;
+    }
+
+    // Queues predictions serialized by the owner's Predictor to be merged into the file at path,
+    // dropping the persisted predictions that the owner refuted. Replaces the owner's previous
+    // write if that has not started yet.
+    void write(const void* owner, std::string path, std::string data,
+               std::unordered_set<NonBufferHash> refutedHashes) {
+        std::scoped_lock lock(mMutex);
+        mPendingWrites.insert_or_assign(owner,
+                                        PendingWrite{std::move(path), std::move(data),
+                                                     std::move(refutedHashes)});
+        mCv.notify_one();
+    }
+
+private:
+    struct PendingWrite {
+        std::string path;
+        std::string data;
+        std::unordered_set<NonBufferHash> refutedHashes;
+    };
+
+    PredictionsWriter() {
+        mThread = std::thread(&PredictionsWriter::run, this);
+        pthread_setname_np(mThread.native_handle(), "PlannerPersist");
+    }
+
+    ~PredictionsWriter() {
+        {
+            std::scoped_lock lock(mMutex);
+            mDone = true;
+            mCv.notify_all();
+        }
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+    void run() {
+        std::unique_lock lock(mMutex);
+        base::ScopedLockAssertion assumeLock(mMutex);
+        while (!mDone) {
+            if (mPendingWrites.empty()) {
+                mCv.wait(lock);
+                continue;
+            }
+            auto pendingWrites = std::move(mPendingWrites);
+            mPendingWrites.clear();
+
+            lock.unlock();
+            for (const auto& [_, pendingWrite] : pendingWrites) {
+                persist(pendingWrite);
+            }
+            lock.lock();
+        }
+    }
+
+    static void persist(const PendingWrite& pendingWrite) {
+        ATRACE_NAME("PredictionsWriter::persist");
+        const std::string& path = pendingWrite.path;
+
+        // Every display has its own Planner, but they share a file, so merge in whatever the other
+        // displays persisted before writing it back out.
+        std::string persisted;
+        if (!base::ReadFileToString(path, &persisted)) {
+            persisted.clear();
+        }
+        const std::string merged =
+                Predictor::mergeSerializedPredictions(pendingWrite.data, persisted,
+                                                      pendingWrite.refutedHashes);
+
+        const std::string tempPath = path + ".tmp";
+        if (!base::WriteStringToFile(merged, tempPath) ||
+            rename(tempPath.c_str(), path.c_str()) != 0) {
+            ALOGW("[%s] Failed to persist predictions to %s", __func__, path.c_str());
+            unlink(tempPath.c_str());
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    bool mDone GUARDED_BY(mMutex) = false;
+    std::map<const void*, PendingWrite> mPendingWrites GUARDED_BY(mMutex);
+    std::thread mThread;
+};
+
 } // namespace
 
 Planner::Planner(renderengine::RenderEngine& renderEngine)
@@ -75,6 +181,11 @@ Planner::Planner(renderengine::RenderEngine& renderEngine)
                    buildFlattenerTuneables()) {
     mPredictorEnabled =
             base::GetBoolProperty(std::string("debug.sf.enable_planner_prediction"), false);
+    if (mPredictorEnabled) {
+        mPredictionsPath =
+                base::GetProperty(std::string("debug.sf.planner_prediction_cache_path"), "");
+        restorePredictions();
+    }
 }
 
 void Planner::setDisplaySize(ui::Size size) {
@@ -199,6 +310,8 @@ void Planner::reportFinalPlan(
 
     mPredictor.recordResult(mPredictedPlan, mFlattenedHash, mCurrentLayers, hasSkippedLayers,
                             finalPlan);
+
+    persistPredictionsIfNeeded();
 }
 
 void Planner::renderCachedSets(const OutputCompositionState& outputState,
@@ -318,6 +431,39 @@ void Planner::dump(const Vector<String16>& args, std::string& result) {
     }
 }
 
+void Planner::restorePredictions() {
+    if (mPredictionsPath.empty()) {
+        return;
+    }
+
+    std::string data;
+    if (!base::ReadFileToString(mPredictionsPath, &data)) {
+        ALOGV("[%s] No persisted predictions found at %s", __func__, mPredictionsPath.c_str());
+        return;
+    }
+    mPredictor.restorePredictions(data);
+}
+
+void Planner::persistPredictionsIfNeeded() {
+    if (mPredictionsPath.empty() || !mPredictor.hasUnserializedPredictions()) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - mLastPredictionsPersistTime < kPredictionsPersistInterval) {
+        return;
+    }
+    mLastPredictionsPersistTime = now;
+
+    ATRACE_CALL();
+
+    // Only the serialization runs here. Merging with the file and writing it happen on a
+    // background thread, so that disk I/O never delays a frame.
+    PredictionsWriter::getInstance().write(this, mPredictionsPath,
+                                           mPredictor.serializePredictions(),
+                                           mPredictor.getRefutedRestoredPredictions());
+}
+
 void Planner::dumpUsage(std::string& result) const {
     result.append("Planner command line interface usage\n");
     result.append("  dumpsys SurfaceFlinger --planner <command> [arguments]\n\n");
@@ -21,8 +21,55 @@
 
 #include <compositionengine/impl/planner/Predictor.h>
 
+#include <cinttypes>
+#include <cstring>
+#include <limits>
+
 namespace android::compositionengine::impl::planner {
 
+namespace {
+
+// "PRED", identifies data written by Predictor::serializePredictions
+constexpr uint32_t kSerializedMagic = 0x44455250;
+
+template <typename T>
+void appendValue(std::string& data, T value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads values appended with appendValue, failing rather than reading past the end of the data.
+class SerializedReader {
+public:
+    explicit SerializedReader(const std::string& data) : mData(data) {}
+
+    template <typename T>
+    bool read(T* value) {
+        if (mData.size() - mOffset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(value, mData.data() + mOffset, sizeof(T));
+        mOffset += sizeof(T);
+        return true;
+    }
+
+    bool readString(size_t length, std::string* value) {
+        if (mData.size() - mOffset < length) {
+            return false;
+        }
+        value->assign(mData, mOffset, length);
+        mOffset += length;
+        return true;
+    }
+
+    bool atEnd() const { return mOffset == mData.size(); }
+
+private:
+    const std::string& mData;
+    size_t mOffset = 0;
+};
+
+} // namespace
+
 std::optional<LayerStack::ApproximateMatch> LayerStack::getApproximateMatch(
         const std::vector<const LayerState*>& other) const {
     // Differing numbers of layers are never an approximate match
@@ -202,8 +249,19 @@ void Predictor::recordResult(std::optional<PredictedPlan> predictedPlan,
                              const std::vector<const LayerState*>& layers, bool hasSkippedLayers,
                              Plan result) {
     if (predictedPlan) {
-        recordPredictedResult(*predictedPlan, layers, std::move(result));
-        return;
+        const bool isRestoredPrediction = mPredictions.count(predictedPlan->hash) == 0 &&
+                getCandidateEntryByHash(predictedPlan->hash) == mCandidates.cend();
+        if (!isRestoredPrediction) {
+            recordPredictedResult(*predictedPlan, layers, std::move(result));
+            return;
+        }
+
+        // A restored prediction which missed is handled like any other miss below, so that the
+        // layer stack becomes a candidate for a new prediction.
+        recordRestoredResult(*predictedPlan, layers, result);
+        if (mPredictions.count(predictedPlan->hash) != 0) {
+            return;
+        }
     }
 
     ++mMissCount;
@@ -219,6 +277,138 @@ void Predictor::recordResult(std::optional<PredictedPlan> predictedPlan,
     }
 }
 
+std::string Predictor::serializePredictions() {
+    struct SerializedPrediction {
+        NonBufferHash hash;
+        std::string plan;
+        uint32_t hitCount;
+    };
+
+    std::vector<SerializedPrediction> predictions;
+    predictions.reserve(mPredictions.size() + mRestoredPredictions.size());
+    const auto addPrediction = [&](NonBufferHash hash, const Plan& plan, size_t hitCount) {
+        std::string planString = to_string(plan);
+        if (planString.size() > kMaxSerializedPlanLength) {
+            return;
+        }
+        predictions.push_back({hash, std::move(planString),
+                               static_cast<uint32_t>(
+                                       std::min<size_t>(hitCount,
+                                                        std::numeric_limits<uint32_t>::max()))});
+    };
+
+    for (const auto& [hash, prediction] : mPredictions) {
+        // Only exact matches are restored, and a prediction which missed an exact match is never
+        // used for one again.
+        if (prediction.getMissCount(Prediction::Type::Exact) != 0) {
+            continue;
+        }
+        addPrediction(hash, prediction.getPlan(), prediction.getHitCount(Prediction::Type::Total));
+    }
+    for (const auto& [hash, restoredPrediction] : mRestoredPredictions) {
+        addPrediction(hash, restoredPrediction.plan, restoredPrediction.hitCount);
+    }
+
+    if (predictions.size() > kMaxSerializedPredictions) {
+        std::partial_sort(predictions.begin(), predictions.begin() + kMaxSerializedPredictions,
+                          predictions.end(),
+                          [](const SerializedPrediction& lhs, const SerializedPrediction& rhs) {
+                              return lhs.hitCount > rhs.hitCount;
+                          });
+        predictions.resize(kMaxSerializedPredictions);
+    }
+
+    std::string data;
+    appendValue(data, kSerializedMagic);
+    appendValue(data, kSerializedVersion);
+    appendValue(data, static_cast<uint32_t>(predictions.size()));
+    for (const auto& [hash, plan, hitCount] : predictions) {
+        appendValue(data, static_cast<uint64_t>(hash));
+        appendValue(data, hitCount);
+        appendValue(data, static_cast<uint16_t>(plan.size()));
+        data.append(plan);
+    }
+
+    mHasUnserializedPredictions = false;
+    return data;
+}
+
+bool Predictor::restorePredictions(const std::string& data) {
+    SerializedReader reader(data);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!reader.read(&magic) || magic != kSerializedMagic) {
+        ALOGW("[%s] Ignoring predictions with an unknown format", __func__);
+        return false;
+    }
+    if (!reader.read(&version) || version != kSerializedVersion) {
+        ALOGW("[%s] Ignoring predictions with version %" PRIu32 ", expected %" PRIu32, __func__,
+              version, kSerializedVersion);
+        return false;
+    }
+    if (!reader.read(&count) || count > kMaxSerializedPredictions) {
+        ALOGW("[%s] Ignoring malformed predictions", __func__);
+        return false;
+    }
+
+    // Parse everything before restoring anything, so that malformed data is rejected as a whole.
+    std::vector<std::pair<NonBufferHash, RestoredPrediction>> restoredPredictions;
+    restoredPredictions.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t hash = 0;
+        uint32_t hitCount = 0;
+        uint16_t planLength = 0;
+        std::string planString;
+        if (!reader.read(&hash) || !reader.read(&hitCount) || !reader.read(&planLength) ||
+            planLength > kMaxSerializedPlanLength || !reader.readString(planLength, &planString)) {
+            ALOGW("[%s] Ignoring truncated predictions", __func__);
+            return false;
+        }
+
+        std::optional<Plan> plan = Plan::fromString(planString);
+        if (!plan) {
+            ALOGW("[%s] Ignoring predictions with invalid plan %s", __func__, planString.c_str());
+            return false;
+        }
+        restoredPredictions.emplace_back(static_cast<NonBufferHash>(hash),
+                                         RestoredPrediction{std::move(*plan), hitCount});
+    }
+    if (!reader.atEnd()) {
+        ALOGW("[%s] Ignoring predictions with trailing data", __func__);
+        return false;
+    }
+
+    for (auto& [hash, restoredPrediction] : restoredPredictions) {
+        if (mRestoredPredictions.size() >= kMaxSerializedPredictions) {
+            break;
+        }
+        if (mPredictions.count(hash) != 0 ||
+            getCandidateEntryByHash(hash) != mCandidates.cend() ||
+            mRefutedRestoredPredictions.count(hash) != 0) {
+            continue;
+        }
+        mRestoredPredictions.emplace(hash, std::move(restoredPrediction));
+    }
+
+    ALOGV("[%s] Restored %zu predictions", __func__, mRestoredPredictions.size());
+    return true;
+}
+
+std::string Predictor::mergeSerializedPredictions(
+        const std::string& data, const std::string& persisted,
+        const std::unordered_set<NonBufferHash>& refutedHashes) {
+    Predictor merged;
+    merged.restorePredictions(data);
+    // Only the persisted predictions are filtered, since data may hold a refuted prediction which
+    // has been learned again since.
+    merged.mRefutedRestoredPredictions = refutedHashes;
+    if (!persisted.empty()) {
+        merged.restorePredictions(persisted);
+    }
+    return merged.serializePredictions();
+}
+
 void Predictor::dump(std::string& result) const {
     result.append("Predictor state:\n");
 
@@ -226,9 +416,12 @@ void Predictor::dump(std::string& result) const {
     const size_t totalAttempts = hitCount + mMissCount;
     base::StringAppendF(&result, "Global non-skipped hit rate: %.2f%% (%zd/%zd)\n",
                         100.0f * hitCount / totalAttempts, hitCount, totalAttempts);
-    base::StringAppendF(&result, "  Exact hits: %zd\n", mExactHitCount);
+    base::StringAppendF(&result, "  Exact hits: %zd (from restored predictions: %zd)\n",
+                        mExactHitCount, mRestoredHitCount);
     base::StringAppendF(&result, "  Approximate hits: %zd\n", mApproximateHitCount);
-    base::StringAppendF(&result, "  Misses: %zd\n\n", mMissCount);
+    base::StringAppendF(&result, "  Misses: %zd\n", mMissCount);
+    base::StringAppendF(&result, "  Unconfirmed restored predictions: %zd\n\n",
+                        mRestoredPredictions.size());
 
     dumpPredictionsByFrequency(result);
 }
@@ -320,6 +513,11 @@ std::optional<Plan> Predictor::getExactMatch(NonBufferHash hash) const {
     }
 
     if (match == nullptr) {
+        if (const auto restoredEntry = mRestoredPredictions.find(hash);
+            restoredEntry != mRestoredPredictions.cend()) {
+            ALOGV("[%s] Found a restored prediction for %zx", __func__, hash);
+            return restoredEntry->second.plan;
+        }
         return std::nullopt;
     }
 
@@ -389,6 +587,7 @@ void Predictor::promoteIfCandidate(NonBufferHash predictionHash) {
     mSimilarStacks[candidateEntry->prediction.getPlan()].push_back(predictionHash);
     mPredictions.emplace(predictionHash, std::move(candidateEntry->prediction));
     mCandidates.erase(candidateEntry);
+    mHasUnserializedPredictions = true;
 }
 
 void Predictor::recordPredictedResult(PredictedPlan predictedPlan,
@@ -400,6 +599,10 @@ void Predictor::recordPredictedResult(PredictedPlan predictedPlan,
               to_string(result).c_str());
         prediction.recordMiss(predictedPlan.type);
         ++mMissCount;
+        if (predictedPlan.type == Prediction::Type::Exact) {
+            // The prediction can no longer be used for exact matches, so it is no longer persisted.
+            mHasUnserializedPredictions |= mPredictions.count(predictedPlan.hash) != 0;
+        }
         return;
     }
 
@@ -437,6 +640,37 @@ void Predictor::recordPredictedResult(PredictedPlan predictedPlan,
     promoteIfCandidate(predictedPlan.hash);
 }
 
+void Predictor::recordRestoredResult(PredictedPlan predictedPlan,
+                                     const std::vector<const LayerState*>& layers, Plan result) {
+    const auto restoredEntry = mRestoredPredictions.find(predictedPlan.hash);
+    if (restoredEntry == mRestoredPredictions.end()) {
+        ALOGE("[%s] Expected to find restored prediction %zx", __func__, predictedPlan.hash);
+        return;
+    }
+
+    const bool hit = restoredEntry->second.plan == result;
+    mRestoredPredictions.erase(restoredEntry);
+
+    if (!hit) {
+        ALOGV("[%s] Restored prediction missed, expected %s, found %s", __func__,
+              to_string(predictedPlan.plan).c_str(), to_string(result).c_str());
+        mRefutedRestoredPredictions.insert(predictedPlan.hash);
+        mHasUnserializedPredictions = true;
+        return;
+    }
+
+    ALOGV("[%s] Restored prediction hit, promoting %zx", __func__, predictedPlan.hash);
+    ++mExactHitCount;
+    ++mRestoredHitCount;
+
+    // The restored prediction has now been confirmed by this boot as well, so it skips the
+    // candidate list and becomes a full prediction with this layer stack as its example.
+    Prediction prediction(layers, result);
+    prediction.recordHit(Prediction::Type::Exact);
+    mSimilarStacks[result].push_back(predictedPlan.hash);
+    mPredictions.emplace(predictedPlan.hash, std::move(prediction));
+}
+
 bool Predictor::findSimilarPrediction(const std::vector<const LayerState*>& layers, Plan result) {
     const auto stacksEntry = mSimilarStacks.find(result);
     if (stacksEntry == mSimilarStacks.end()) {
@@ -550,5 +550,177 @@ TEST_F(PredictorTest, recordMissedPlan_skipsApproximateMatch) {
     EXPECT_FALSE(predictedPlanTwo);
 }
 
+TEST_F(PredictorTest, restorePredictions_restoresExactMatch) {
+    mock::OutputLayer outputLayerOne;
+    sp<mock::LayerFE> layerFEOne = sp<mock::LayerFE>::make();
+    OutputLayerCompositionState outputLayerCompositionStateOne;
+    LayerFECompositionState layerFECompositionStateOne;
+    layerFECompositionStateOne.compositionType = Composition::DEVICE;
+    setupMocksForLayer(outputLayerOne, *layerFEOne, outputLayerCompositionStateOne,
+                       layerFECompositionStateOne);
+    LayerState layerStateOne(&outputLayerOne);
+
+    Plan plan;
+    plan.addLayerType(Composition::DEVICE);
+
+    NonBufferHash hash = getNonBufferHash({&layerStateOne});
+
+    // Only promoted predictions are persisted, so hit the candidate once.
+    Predictor predictor;
+    predictor.recordResult(std::nullopt, hash, {&layerStateOne}, false, plan);
+    predictor.recordResult(predictor.getPredictedPlan({}, hash), hash, {&layerStateOne}, false,
+                           plan);
+    EXPECT_TRUE(predictor.hasUnserializedPredictions());
+    const std::string data = predictor.serializePredictions();
+    EXPECT_FALSE(predictor.hasUnserializedPredictions());
+
+    Predictor restoredPredictor;
+    ASSERT_TRUE(restoredPredictor.restorePredictions(data));
+
+    auto predictedPlan = restoredPredictor.getPredictedPlan({}, hash);
+    Predictor::PredictedPlan expectedPlan{hash, plan, Prediction::Type::Exact};
+    EXPECT_EQ(expectedPlan, predictedPlan);
+
+    // Confirming the restored prediction keeps it around as a regular prediction.
+    restoredPredictor.recordResult(predictedPlan, hash, {&layerStateOne}, false, plan);
+    EXPECT_EQ(expectedPlan, restoredPredictor.getPredictedPlan({}, hash));
+    EXPECT_EQ(data, restoredPredictor.serializePredictions());
+}
+
+TEST_F(PredictorTest, restorePredictions_missedPredictionIsNotRestoredAgain) {
+    mock::OutputLayer outputLayerOne;
+    sp<mock::LayerFE> layerFEOne = sp<mock::LayerFE>::make();
+    OutputLayerCompositionState outputLayerCompositionStateOne;
+    LayerFECompositionState layerFECompositionStateOne;
+    layerFECompositionStateOne.compositionType = Composition::DEVICE;
+    setupMocksForLayer(outputLayerOne, *layerFEOne, outputLayerCompositionStateOne,
+                       layerFECompositionStateOne);
+    LayerState layerStateOne(&outputLayerOne);
+
+    Plan plan;
+    plan.addLayerType(Composition::DEVICE);
+    Plan planTwo;
+    planTwo.addLayerType(Composition::CLIENT);
+
+    NonBufferHash hash = getNonBufferHash({&layerStateOne});
+
+    Predictor predictor;
+    predictor.recordResult(std::nullopt, hash, {&layerStateOne}, false, plan);
+    predictor.recordResult(predictor.getPredictedPlan({}, hash), hash, {&layerStateOne}, false,
+                           plan);
+    const std::string data = predictor.serializePredictions();
+
+    Predictor restoredPredictor;
+    ASSERT_TRUE(restoredPredictor.restorePredictions(data));
+    auto predictedPlan = restoredPredictor.getPredictedPlan({}, hash);
+    ASSERT_TRUE(predictedPlan);
+    restoredPredictor.recordResult(predictedPlan, hash, {&layerStateOne}, false, planTwo);
+    EXPECT_TRUE(restoredPredictor.hasUnserializedPredictions());
+
+    // The missed layer stack is learned again from scratch, and restoring the stale prediction a
+    // second time does not override it.
+    ASSERT_TRUE(restoredPredictor.restorePredictions(data));
+    Predictor::PredictedPlan expectedPlan{hash, planTwo, Prediction::Type::Exact};
+    EXPECT_EQ(expectedPlan, restoredPredictor.getPredictedPlan({}, hash));
+}
+
+TEST_F(PredictorTest, mergeSerializedPredictions_dropsRefutedPredictions) {
+    mock::OutputLayer outputLayerOne;
+    sp<mock::LayerFE> layerFEOne = sp<mock::LayerFE>::make();
+    OutputLayerCompositionState outputLayerCompositionStateOne;
+    LayerFECompositionState layerFECompositionStateOne;
+    layerFECompositionStateOne.compositionType = Composition::DEVICE;
+    setupMocksForLayer(outputLayerOne, *layerFEOne, outputLayerCompositionStateOne,
+                       layerFECompositionStateOne);
+    LayerState layerStateOne(&outputLayerOne);
+
+    Plan plan;
+    plan.addLayerType(Composition::DEVICE);
+    Plan planTwo;
+    planTwo.addLayerType(Composition::CLIENT);
+
+    NonBufferHash hash = getNonBufferHash({&layerStateOne});
+
+    // The file persisted before the restart.
+    Predictor predictor;
+    predictor.recordResult(std::nullopt, hash, {&layerStateOne}, false, plan);
+    predictor.recordResult(predictor.getPredictedPlan({}, hash), hash, {&layerStateOne}, false,
+                           plan);
+    const std::string persisted = predictor.serializePredictions();
+
+    // After the restart the restored prediction misses, and is persisted again.
+    Predictor restoredPredictor;
+    ASSERT_TRUE(restoredPredictor.restorePredictions(persisted));
+    auto predictedPlan = restoredPredictor.getPredictedPlan({}, hash);
+    ASSERT_TRUE(predictedPlan);
+    restoredPredictor.recordResult(predictedPlan, hash, {&layerStateOne}, false, planTwo);
+    EXPECT_EQ(1u, restoredPredictor.getRefutedRestoredPredictions().count(hash));
+    const std::string merged =
+            Predictor::mergeSerializedPredictions(restoredPredictor.serializePredictions(),
+                                                  persisted,
+                                                  restoredPredictor.getRefutedRestoredPredictions());
+
+    // The refuted prediction does not come back after the next restart.
+    Predictor nextPredictor;
+    ASSERT_TRUE(nextPredictor.restorePredictions(merged));
+    EXPECT_FALSE(nextPredictor.getPredictedPlan({}, hash));
+}
+
+TEST_F(PredictorTest, mergeSerializedPredictions_keepsRelearnedPredictions) {
+    mock::OutputLayer outputLayerOne;
+    sp<mock::LayerFE> layerFEOne = sp<mock::LayerFE>::make();
+    OutputLayerCompositionState outputLayerCompositionStateOne;
+    LayerFECompositionState layerFECompositionStateOne;
+    layerFECompositionStateOne.compositionType = Composition::DEVICE;
+    setupMocksForLayer(outputLayerOne, *layerFEOne, outputLayerCompositionStateOne,
+                       layerFECompositionStateOne);
+    LayerState layerStateOne(&outputLayerOne);
+
+    Plan plan;
+    plan.addLayerType(Composition::DEVICE);
+    Plan planTwo;
+    planTwo.addLayerType(Composition::CLIENT);
+
+    NonBufferHash hash = getNonBufferHash({&layerStateOne});
+
+    Predictor predictor;
+    predictor.recordResult(std::nullopt, hash, {&layerStateOne}, false, plan);
+    predictor.recordResult(predictor.getPredictedPlan({}, hash), hash, {&layerStateOne}, false,
+                           plan);
+    const std::string persisted = predictor.serializePredictions();
+
+    // The restored prediction misses, and the new plan is then confirmed and promoted.
+    Predictor restoredPredictor;
+    ASSERT_TRUE(restoredPredictor.restorePredictions(persisted));
+    restoredPredictor.recordResult(restoredPredictor.getPredictedPlan({}, hash), hash,
+                                   {&layerStateOne}, false, planTwo);
+    restoredPredictor.recordResult(restoredPredictor.getPredictedPlan({}, hash), hash,
+                                   {&layerStateOne}, false, planTwo);
+    const std::string merged =
+            Predictor::mergeSerializedPredictions(restoredPredictor.serializePredictions(),
+                                                  persisted,
+                                                  restoredPredictor.getRefutedRestoredPredictions());
+
+    Predictor nextPredictor;
+    ASSERT_TRUE(nextPredictor.restorePredictions(merged));
+    Predictor::PredictedPlan expectedPlan{hash, planTwo, Prediction::Type::Exact};
+    EXPECT_EQ(expectedPlan, nextPredictor.getPredictedPlan({}, hash));
+}
+
+TEST_F(PredictorTest, restorePredictions_rejectsMalformedData) {
+    Predictor predictor;
+    const std::string data = predictor.serializePredictions();
+
+    EXPECT_TRUE(Predictor().restorePredictions(data));
+    EXPECT_FALSE(Predictor().restorePredictions(""));
+    EXPECT_FALSE(Predictor().restorePredictions(data.substr(0, data.size() - 1)));
+    EXPECT_FALSE(Predictor().restorePredictions(data + "D"));
+
+    // The version follows the magic number.
+    std::string wrongVersion = data;
+    wrongVersion[sizeof(uint32_t)]++;
+    EXPECT_FALSE(Predictor().restorePredictions(wrongVersion));
+}
+
 } // namespace
 } // namespace android::compositionengine::impl::planner
@@ -36,6 +36,8 @@
 #include <ui/DisplayStatInfo.h>
 #include <utils/Trace.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 
 #include "DisplayDevice.h"
@@ -196,11 +198,30 @@ void RegionSamplingThread::binderDied(const wp<IBinder>& who) {
     mDescriptors.erase(who);
 }
 
-float sampleArea(const uint32_t* data, int32_t width, int32_t height, int32_t stride,
-                 uint32_t orientation, const Rect& sample_area) {
+namespace {
+
+bool isValidSampleArea(int32_t width, int32_t height, const Rect& sample_area) {
     if (!sample_area.isValid() || (sample_area.getWidth() > width) ||
         (sample_area.getHeight() > height)) {
         ALOGE("invalid sampling region requested");
+        return false;
+    }
+    return true;
+}
+
+// Calculates luma with approximation of Rec. 709 primaries
+inline uint32_t pixelLuma(uint32_t pixel) {
+    const uint32_t r = pixel & 0xFF;
+    const uint32_t g = (pixel >> 8) & 0xFF;
+    const uint32_t b = (pixel >> 16) & 0xFF;
+    return (r * 7 + b * 2 + g * 23) >> 5;
+}
+
+} // namespace
+
+float sampleArea(const uint32_t* data, int32_t width, int32_t height, int32_t stride,
+                 uint32_t orientation, const Rect& sample_area) {
+    if (!isValidSampleArea(width, height, sample_area)) {
         return 0.0f;
     }
 
@@ -208,22 +229,101 @@ float sampleArea(const uint32_t* data, int32_t width, int32_t height, int32_t st
             (sample_area.bottom - sample_area.top) * (sample_area.right - sample_area.left);
     uint32_t accumulatedLuma = 0;
 
-    // Calculates luma with approximation of Rec. 709 primaries
     for (int32_t row = sample_area.top; row < sample_area.bottom; ++row) {
         const uint32_t* rowBase = data + row * stride;
         for (int32_t column = sample_area.left; column < sample_area.right; ++column) {
-            uint32_t pixel = rowBase[column];
-            const uint32_t r = pixel & 0xFF;
-            const uint32_t g = (pixel >> 8) & 0xFF;
-            const uint32_t b = (pixel >> 16) & 0xFF;
-            const uint32_t luma = (r * 7 + b * 2 + g * 23) >> 5;
-            accumulatedLuma += luma;
+            accumulatedLuma += pixelLuma(rowBase[column]);
         }
     }
 
     return accumulatedLuma / (255.0f * pixelCount);
 }
 
+std::vector<float> sampleAreas(const uint32_t* data, int32_t width, int32_t height, int32_t stride,
+                               uint32_t orientation, const std::vector<Rect>& sample_areas) {
+    std::vector<float> lumas(sample_areas.size(), 0.0f);
+
+    std::vector<size_t> validAreas;
+    std::vector<int32_t> bandEdges;
+    int32_t minLeft = std::numeric_limits<int32_t>::max();
+    int32_t maxRight = std::numeric_limits<int32_t>::min();
+    for (size_t i = 0; i < sample_areas.size(); ++i) {
+        const Rect& area = sample_areas[i];
+        if (!isValidSampleArea(width, height, area)) {
+            continue;
+        }
+        validAreas.push_back(i);
+        bandEdges.push_back(area.top);
+        bandEdges.push_back(area.bottom);
+        minLeft = std::min(minLeft, area.left);
+        maxRight = std::max(maxRight, area.right);
+    }
+    if (validAreas.empty()) {
+        return lumas;
+    }
+
+    // The rows are split into bands in which the same set of areas is sampled. Within a band,
+    // the column spans of those areas are merged so that every pixel is converted to luma once,
+    // and each area sums its columns out of a per-row prefix sum.
+    std::sort(bandEdges.begin(), bandEdges.end());
+    bandEdges.erase(std::unique(bandEdges.begin(), bandEdges.end()), bandEdges.end());
+
+    std::vector<uint64_t> accumulatedLumas(sample_areas.size(), 0);
+    std::vector<uint32_t> prefix(maxRight - minLeft + 1, 0);
+    std::vector<size_t> bandAreas;
+    std::vector<std::pair<int32_t, int32_t>> spans;
+    for (size_t edge = 0; edge + 1 < bandEdges.size(); ++edge) {
+        const int32_t bandTop = bandEdges[edge];
+        const int32_t bandBottom = bandEdges[edge + 1];
+
+        bandAreas.clear();
+        spans.clear();
+        for (size_t i : validAreas) {
+            const Rect& area = sample_areas[i];
+            if (area.top <= bandTop && area.bottom >= bandBottom) {
+                bandAreas.push_back(i);
+                spans.emplace_back(area.left, area.right);
+            }
+        }
+        if (bandAreas.empty()) {
+            continue;
+        }
+
+        std::sort(spans.begin(), spans.end());
+        size_t mergedCount = 0;
+        for (const auto& span : spans) {
+            if (mergedCount > 0 && span.first <= spans[mergedCount - 1].second) {
+                spans[mergedCount - 1].second = std::max(spans[mergedCount - 1].second, span.second);
+            } else {
+                spans[mergedCount++] = span;
+            }
+        }
+        spans.resize(mergedCount);
+
+        for (int32_t row = bandTop; row < bandBottom; ++row) {
+            const uint32_t* rowBase = data + row * stride;
+            for (const auto& [left, right] : spans) {
+                uint32_t* rowPrefix = prefix.data() - minLeft;
+                rowPrefix[left] = 0;
+                for (int32_t column = left; column < right; ++column) {
+                    rowPrefix[column + 1] = rowPrefix[column] + pixelLuma(rowBase[column]);
+                }
+            }
+            for (size_t i : bandAreas) {
+                const Rect& area = sample_areas[i];
+                accumulatedLumas[i] += prefix[area.right - minLeft] - prefix[area.left - minLeft];
+            }
+        }
+    }
+
+    for (size_t i : validAreas) {
+        const Rect& area = sample_areas[i];
+        const uint32_t pixelCount = (area.bottom - area.top) * (area.right - area.left);
+        lumas[i] = accumulatedLumas[i] / (255.0f * pixelCount);
+    }
+    return lumas;
+}
+
 std::vector<float> RegionSamplingThread::sampleBuffer(
         const sp<GraphicBuffer>& buffer, const Point& leftTop,
         const std::vector<RegionSamplingThread::Descriptor>& descriptors, uint32_t orientation) {
@@ -236,13 +336,10 @@ std::vector<float> RegionSamplingThread::sampleBuffer(
     const int32_t width = buffer->getWidth();
     const int32_t height = buffer->getHeight();
     const int32_t stride = buffer->getStride();
-    std::vector<float> lumas(descriptors.size());
-    std::transform(descriptors.begin(), descriptors.end(), lumas.begin(),
-                   [&](auto const& descriptor) {
-                       return sampleArea(data.get(), width, height, stride, orientation,
-                                         descriptor.area - leftTop);
-                   });
-    return lumas;
+    std::vector<Rect> areas(descriptors.size());
+    std::transform(descriptors.begin(), descriptors.end(), areas.begin(),
+                   [&](auto const& descriptor) { return descriptor.area - leftTop; });
+    return sampleAreas(data.get(), width, height, stride, orientation, areas);
 }
 
 void RegionSamplingThread::captureSample() {
@@ -45,6 +45,11 @@ using gui::IRegionSamplingListener;
 float sampleArea(const uint32_t* data, int32_t width, int32_t height, int32_t stride,
                  uint32_t orientation, const Rect& area);
 
+// Equivalent to calling sampleArea for each of the areas, but converts each pixel covered by
+// several overlapping areas to luma only once.
+std::vector<float> sampleAreas(const uint32_t* data, int32_t width, int32_t height, int32_t stride,
+                               uint32_t orientation, const std::vector<Rect>& areas);
+
 class RegionSamplingThread : public IBinder::DeathRecipient {
 public:
     struct TimingTunables {
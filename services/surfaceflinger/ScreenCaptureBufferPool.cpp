@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#undef LOG_TAG
+#define LOG_TAG "ScreenCaptureBufferPool"
+#define ATRACE_TAG ATRACE_TAG_GRAPHICS
+
+#include <android-base/stringprintf.h>
+#include <inttypes.h>
+#include <utils/Trace.h>
+
+#include <algorithm>
+
+#include "ScreenCaptureBufferPool.h"
+
+namespace android {
+
+using base::StringAppendF;
+
+ScreenCaptureBufferPool::ScreenCaptureBufferPool()
+      : mDeathRecipient(sp<ClientDeathRecipient>::make(*this)) {}
+
+ScreenCaptureBufferPool::~ScreenCaptureBufferPool() {
+    std::scoped_lock lock(mMutex);
+    for (const auto& [_, recyclingClient] : mRecyclingClients) {
+        if (recyclingClient.token) {
+            recyclingClient.token->unlinkToDeath(mDeathRecipient);
+        }
+    }
+}
+
+sp<GraphicBuffer> ScreenCaptureBufferPool::acquire(Client client, uint32_t width, uint32_t height,
+                                                   PixelFormat format, uint64_t usage) {
+    Entry entry;
+    {
+        std::scoped_lock lock(mMutex);
+        auto it = std::find_if(mFreeBuffers.begin(), mFreeBuffers.end(), [&](const Entry& free) {
+            const auto& buffer = free.buffer;
+            return free.client == client && buffer->getWidth() == width &&
+                    buffer->getHeight() == height && buffer->getPixelFormat() == format &&
+                    buffer->getUsage() == usage;
+        });
+        if (it == mFreeBuffers.end()) {
+            mAllocatedCount++;
+            return nullptr;
+        }
+        entry = std::move(*it);
+        mFreeBuffers.erase(it);
+    }
+
+    ATRACE_NAME("ScreenCaptureBufferPool::reuse");
+    // The caller may still be reading the buffer on its GPU, so only render into it once it is
+    // done. A caller that never signals its fence must not stall captures, so give up on the
+    // buffer after a bounded wait.
+    if (entry.releaseFence && entry.releaseFence->wait(kReleaseFenceTimeoutMs) != NO_ERROR) {
+        ALOGW("%s: release fence of buffer %" PRIu64 " did not signal in %d ms", __func__,
+              entry.buffer->getId(), kReleaseFenceTimeoutMs);
+        std::scoped_lock lock(mMutex);
+        mFenceTimeoutCount++;
+        mAllocatedCount++;
+        return nullptr;
+    }
+
+    std::scoped_lock lock(mMutex);
+    mReusedCount++;
+    return std::move(entry.buffer);
+}
+
+void ScreenCaptureBufferPool::onBufferSent(Client client, const sp<GraphicBuffer>& buffer,
+                                           const sp<IBinder>& clientToken) {
+    std::scoped_lock lock(mMutex);
+    auto it = mRecyclingClients.find(client);
+    if (it == mRecyclingClients.end()) {
+        return;
+    }
+    auto& recyclingClient = it->second;
+    recyclingClient.lastActive = ++mActivityCount;
+
+    // Keep only the latest token of the client linked, so that no more than one binder is held
+    // on its behalf.
+    if (clientToken && clientToken != recyclingClient.token) {
+        if (recyclingClient.token) {
+            recyclingClient.token->unlinkToDeath(mDeathRecipient);
+        }
+        // Linking fails for local binders, which are only passed by SurfaceFlinger itself.
+        clientToken->linkToDeath(mDeathRecipient);
+        recyclingClient.token = clientToken;
+    }
+
+    mSentBuffers.push_back({client, buffer, nullptr});
+    if (mSentBuffers.size() > kMaxSentBuffers) {
+        mSentBuffers.pop_front();
+    }
+}
+
+bool ScreenCaptureBufferPool::release(Client client, uint64_t bufferId,
+                                      const sp<Fence>& releaseFence) {
+    std::scoped_lock lock(mMutex);
+    registerClientLocked(client);
+
+    auto it = std::find_if(mSentBuffers.begin(), mSentBuffers.end(), [&](const Entry& entry) {
+        return entry.client == client && entry.buffer->getId() == bufferId;
+    });
+    if (it == mSentBuffers.end()) {
+        return false;
+    }
+
+    it->releaseFence = releaseFence;
+    mFreeBuffers.push_back(std::move(*it));
+    mSentBuffers.erase(it);
+    if (mFreeBuffers.size() > kMaxFreeBuffers) {
+        mFreeBuffers.pop_front();
+    }
+    return true;
+}
+
+void ScreenCaptureBufferPool::onClientDied(const wp<IBinder>& clientToken) {
+    std::scoped_lock lock(mMutex);
+    auto it = std::find_if(mRecyclingClients.begin(), mRecyclingClients.end(),
+                           [&](const auto& recyclingClient) {
+                               return recyclingClient.second.token != nullptr &&
+                                       recyclingClient.second.token == clientToken.unsafe_get();
+                           });
+    if (it != mRecyclingClients.end()) {
+        removeClientLocked(it->first);
+    }
+}
+
+void ScreenCaptureBufferPool::registerClientLocked(Client client) {
+    auto it = mRecyclingClients.find(client);
+    if (it == mRecyclingClients.end()) {
+        if (mRecyclingClients.size() >= kMaxRecyclingClients) {
+            const auto leastActive =
+                    std::min_element(mRecyclingClients.begin(), mRecyclingClients.end(),
+                                     [](const auto& lhs, const auto& rhs) {
+                                         return lhs.second.lastActive < rhs.second.lastActive;
+                                     });
+            if (leastActive->second.token) {
+                leastActive->second.token->unlinkToDeath(mDeathRecipient);
+            }
+            removeClientLocked(leastActive->first);
+        }
+        it = mRecyclingClients.try_emplace(client).first;
+    }
+    it->second.lastActive = ++mActivityCount;
+}
+
+void ScreenCaptureBufferPool::removeClientLocked(Client client) {
+    const auto isClient = [&](const Entry& entry) { return entry.client == client; };
+    std::erase_if(mSentBuffers, isClient);
+    std::erase_if(mFreeBuffers, isClient);
+    mRecyclingClients.erase(client);
+}
+
+void ScreenCaptureBufferPool::dump(std::string& result) const {
+    std::scoped_lock lock(mMutex);
+    StringAppendF(&result,
+                  "  recycling clients: %zu, sent buffers: %zu, free buffers: %zu, reused: %" PRIu64
+                  ", allocated: %" PRIu64 ", release fence timeouts: %" PRIu64 "\n",
+                  mRecyclingClients.size(), mSentBuffers.size(), mFreeBuffers.size(), mReusedCount,
+                  mAllocatedCount, mFenceTimeoutCount);
+}
+
+} // namespace android
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <android-base/thread_annotations.h>
+#include <binder/IBinder.h>
+#include <ui/Fence.h>
+#include <ui/GraphicBuffer.h>
+#include <ui/PixelFormat.h>
+#include <utils/StrongPointer.h>
+
+#include <sys/types.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace android {
+
+// Recycles the output buffers of screen captures for callers that capture continuously.
+//
+// A capture buffer belongs to the caller once the capture is sent, so it can only be rendered
+// into again after the caller hands it back through releaseScreenCaptureBuffer, together with a
+// fence that signals once the caller has stopped reading it. Buffers are only tracked for callers
+// that have released a capture buffer before; other callers keep the allocate-per-capture
+// behavior, and SurfaceFlinger holds no references to their buffers. Only a bounded number of
+// callers are tracked, so the least recently active one is forgotten to make room for a new one.
+// Callers are identified by pid and uid, so that processes sharing a uid never see each other's
+// buffers. A released buffer is only reused for a capture of the same size, format and usage
+// requested by the same caller, and all buffers of a caller are dropped when its process dies.
+class ScreenCaptureBufferPool {
+public:
+    using Client = std::pair<pid_t, uid_t>;
+
+    ScreenCaptureBufferPool();
+    ~ScreenCaptureBufferPool();
+
+    // Returns a released buffer matching the request, or nullptr if a new one must be allocated.
+    // Waits for the release fence of the buffer before returning it.
+    sp<GraphicBuffer> acquire(Client client, uint32_t width, uint32_t height, PixelFormat format,
+                              uint64_t usage);
+
+    // Called with each buffer that a capture was successfully rendered into and sent to a client.
+    // The token must be a binder hosted by the client process, and is used to drop the buffers of
+    // the client once that process dies. It may be null, for example in tests.
+    void onBufferSent(Client client, const sp<GraphicBuffer>& buffer,
+                      const sp<IBinder>& clientToken);
+
+    // Returns whether the buffer was sent to the client and is now available for reuse once the
+    // release fence signals.
+    bool release(Client client, uint64_t bufferId, const sp<Fence>& releaseFence);
+
+    // Drops all buffers of the client whose token died.
+    void onClientDied(const wp<IBinder>& clientToken);
+
+    void dump(std::string& result) const;
+
+private:
+    // Bounds on the buffers kept alive on behalf of callers. The oldest entries are dropped
+    // first, so a caller that stops releasing its buffers does not pin memory for long.
+    static constexpr size_t kMaxSentBuffers = 8;
+    static constexpr size_t kMaxFreeBuffers = 4;
+
+    // Bound on the clients that recycle their buffers. A client without a linked token is never
+    // notified of death, so it is only forgotten once it is the least recently active one.
+    static constexpr size_t kMaxRecyclingClients = 16;
+
+    // How long a capture waits for a caller to finish reading a released buffer before it
+    // allocates a new one instead.
+    static constexpr int kReleaseFenceTimeoutMs = 100;
+
+    struct Entry {
+        Client client;
+        sp<GraphicBuffer> buffer;
+        sp<Fence> releaseFence;
+    };
+
+    struct RecyclingClient {
+        // The token linked to the death of the client, if any.
+        sp<IBinder> token;
+        // The value of mActivityCount when the client last sent or released a buffer.
+        uint64_t lastActive = 0;
+    };
+
+    class ClientDeathRecipient : public IBinder::DeathRecipient {
+    public:
+        explicit ClientDeathRecipient(ScreenCaptureBufferPool& pool) : mPool(pool) {}
+        void binderDied(const wp<IBinder>& who) override { mPool.onClientDied(who); }
+
+    private:
+        ScreenCaptureBufferPool& mPool;
+    };
+
+    void registerClientLocked(Client client) REQUIRES(mMutex);
+    void removeClientLocked(Client client) REQUIRES(mMutex);
+
+    const sp<ClientDeathRecipient> mDeathRecipient;
+
+    mutable std::mutex mMutex;
+    std::map<Client, RecyclingClient> mRecyclingClients GUARDED_BY(mMutex);
+    uint64_t mActivityCount GUARDED_BY(mMutex) = 0;
+    std::deque<Entry> mSentBuffers GUARDED_BY(mMutex);
+    std::deque<Entry> mFreeBuffers GUARDED_BY(mMutex);
+    uint64_t mReusedCount GUARDED_BY(mMutex) = 0;
+    uint64_t mAllocatedCount GUARDED_BY(mMutex) = 0;
+    uint64_t mFenceTimeoutCount GUARDED_BY(mMutex) = 0;
+};
+
+} // namespace android
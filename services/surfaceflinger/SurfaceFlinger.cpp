@@ -6859,6 +6859,8 @@ void SurfaceFlinger::dumpAll(const DumpArgs& args, const std::string& compositio
 
     result.append("ClientCache state:\n");
     ClientCache::getInstance().dump(result);
+    result.append("Screen capture buffer pool:\n");
+    mScreenCaptureBufferPool.dump(result);
     DebugEGLImageTracker::getInstance()->dump(result);
 
     if (const auto display = getDefaultDisplayDeviceLocked()) {
@@ -8006,6 +8008,14 @@ void SurfaceFlinger::captureDisplay(DisplayId displayId, const CaptureArgs& args
                         kAllowProtected, kGrayscale, captureListener);
 }
 
+void SurfaceFlinger::releaseScreenCaptureBuffer(pid_t pid, uid_t uid, uint64_t bufferId,
+                                                const sp<Fence>& releaseFence) {
+    if (!mScreenCaptureBufferPool.release({pid, uid}, bufferId, releaseFence)) {
+        ALOGV("%s: buffer %" PRIu64 " was not sent to pid %d uid %d", __func__, bufferId, pid,
+              uid);
+    }
+}
+
 ScreenCaptureResults SurfaceFlinger::captureLayersSync(const LayerCaptureArgs& args) {
     sp<SyncScreenCaptureListener> captureListener = sp<SyncScreenCaptureListener>::make();
     captureLayers(args, captureListener);
@@ -8191,10 +8201,19 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaFuture renderAreaFuture,
             GRALLOC_USAGE_HW_TEXTURE |
             (isProtected ? GRALLOC_USAGE_PROTECTED
                          : GRALLOC_USAGE_SW_READ_OFTEN | GRALLOC_USAGE_SW_WRITE_OFTEN);
+    // Callers that capture continuously hand their previous buffers back, so render into one of
+    // those when possible rather than allocating a new buffer for every capture.
+    const ScreenCaptureBufferPool::Client client = {IPCThreadState::self()->getCallingPid(),
+                                                    IPCThreadState::self()->getCallingUid()};
     sp<GraphicBuffer> buffer =
-            getFactory().createGraphicBuffer(bufferSize.getWidth(), bufferSize.getHeight(),
-                                             static_cast<android_pixel_format>(reqPixelFormat),
-                                             1 /* layerCount */, usage, "screenshot");
+            mScreenCaptureBufferPool.acquire(client, static_cast<uint32_t>(bufferSize.getWidth()),
+                                             static_cast<uint32_t>(bufferSize.getHeight()),
+                                             static_cast<PixelFormat>(reqPixelFormat), usage);
+    if (!buffer) {
+        buffer = getFactory().createGraphicBuffer(bufferSize.getWidth(), bufferSize.getHeight(),
+                                                  static_cast<android_pixel_format>(reqPixelFormat),
+                                                  1 /* layerCount */, usage, "screenshot");
+    }
 
     const status_t bufferStatus = buffer->initCheck();
     if (bufferStatus != OK) {
@@ -8212,7 +8231,12 @@ void SurfaceFlinger::captureScreenCommon(RenderAreaFuture renderAreaFuture,
     auto fence = captureScreenCommon(std::move(renderAreaFuture), getLayerSnapshots, texture,
                                      false /* regionSampling */, grayscale, isProtected,
                                      captureListener);
-    fence.get();
+    // Only track the buffer once the capture was rendered into it, so that failed captures do not
+    // keep buffers alive on behalf of the caller.
+    if (fence.get().ok()) {
+        mScreenCaptureBufferPool.onBufferSent(client, buffer,
+                                              IInterface::asBinder(captureListener));
+    }
 }
 
 ftl::SharedFuture<FenceResult> SurfaceFlinger::captureScreenCommon(
@@ -8247,9 +8271,9 @@ ftl::SharedFuture<FenceResult> SurfaceFlinger::captureScreenCommon(
                     return ftl::Future(std::move(renderFuture))
                             .then([captureListener, captureResults = std::move(captureResults)](
                                           FenceResult fenceResult) mutable -> FenceResult {
-                                captureResults.fenceResult = std::move(fenceResult);
+                                captureResults.fenceResult = fenceResult;
                                 captureListener->onScreenCaptureCompleted(captureResults);
-                                return base::unexpected(NO_ERROR);
+                                return fenceResult;
                             })
                             .share();
                 }
@@ -9906,6 +9930,21 @@ binder::Status SurfaceComposerAIDL::captureLayers(
     return binderStatusFromStatusT(NO_ERROR);
 }
 
+binder::Status SurfaceComposerAIDL::releaseScreenCaptureBuffer(
+        int64_t bufferId, const std::optional<os::ParcelFileDescriptor>& releaseFence) {
+    // Only buffers that were sent to the calling process can be released, so no permission is
+    // needed.
+    IPCThreadState* ipc = IPCThreadState::self();
+    const pid_t pid = ipc->getCallingPid();
+    const uid_t uid = ipc->getCallingUid();
+    sp<Fence> fence = Fence::NO_FENCE;
+    if (releaseFence) {
+        fence = sp<Fence>::make(dup(releaseFence->get()));
+    }
+    mFlinger->releaseScreenCaptureBuffer(pid, uid, static_cast<uint64_t>(bufferId), fence);
+    return binderStatusFromStatusT(NO_ERROR);
+}
+
 binder::Status SurfaceComposerAIDL::overrideHdrTypes(const sp<IBinder>& display,
                                                      const std::vector<int32_t>& hdrTypes) {
     // overrideHdrTypes is used by CTS tests, which acquire the necessary
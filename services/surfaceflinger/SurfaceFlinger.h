@@ -83,6 +83,7 @@
 #include "Scheduler/ISchedulerCallback.h"
 #include "Scheduler/RefreshRateSelector.h"
 #include "Scheduler/Scheduler.h"
+#include "ScreenCaptureBufferPool.h"
 #include "SurfaceFlingerFactory.h"
 #include "ThreadContext.h"
 #include "Tracing/LayerTracing.h"
@@ -564,6 +565,8 @@ private:
     void captureDisplay(DisplayId, const CaptureArgs&, const sp<IScreenCaptureListener>&);
     ScreenCaptureResults captureLayersSync(const LayerCaptureArgs&);
     void captureLayers(const LayerCaptureArgs&, const sp<IScreenCaptureListener>&);
+    void releaseScreenCaptureBuffer(pid_t pid, uid_t uid, uint64_t bufferId,
+                                    const sp<Fence>& releaseFence);
 
     status_t getDisplayStats(const sp<IBinder>& displayToken, DisplayStatInfo* stats);
     status_t getDisplayState(const sp<IBinder>& displayToken, ui::DisplayState*)
@@ -1319,6 +1322,8 @@ private:
 
     TransactionCallbackInvoker mTransactionCallbackInvoker;
 
+    ScreenCaptureBufferPool mScreenCaptureBufferPool;
+
     std::atomic<size_t> mNumLayers = 0;
 
     // to linkToDeath
@@ -1566,6 +1571,8 @@ public:
     binder::Status captureLayers(const LayerCaptureArgs&,
                                  const sp<IScreenCaptureListener>&) override;
     binder::Status captureLayersSync(const LayerCaptureArgs&, ScreenCaptureResults* results);
+    binder::Status releaseScreenCaptureBuffer(
+            int64_t bufferId, const std::optional<os::ParcelFileDescriptor>& releaseFence) override;
 
     // TODO(b/239076119): Remove deprecated AIDL.
     [[deprecated]] binder::Status clearAnimationFrameStats() override {
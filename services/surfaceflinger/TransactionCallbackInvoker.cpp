@@ -155,11 +155,13 @@ void TransactionCallbackInvoker::addPresentFence(sp<Fence> presentFence) {
 void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
     // For each listener
     auto completedTransactionsItr = mCompletedTransactions.begin();
-    BackgroundExecutor::Callbacks callbacks;
+    std::vector<ListenerStats> completedListenerStats;
+    completedListenerStats.reserve(mCompletedTransactions.size());
     while (completedTransactionsItr != mCompletedTransactions.end()) {
         auto& [listener, transactionStatsDeque] = *completedTransactionsItr;
         ListenerStats listenerStats;
         listenerStats.listener = listener;
+        listenerStats.transactionStats.reserve(transactionStatsDeque.size());
 
         // For each transaction
         auto transactionStatsItr = transactionStatsDeque.begin();
@@ -180,21 +182,9 @@ void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
             listenerStats.transactionStats.push_back(std::move(transactionStats));
             transactionStatsItr = transactionStatsDeque.erase(transactionStatsItr);
         }
-        // If the listener has completed transactions
-        if (!listenerStats.transactionStats.empty()) {
-            // If the listener is still alive
-            if (listener->isBinderAlive()) {
-                // Send callback.  The listener stored in listenerStats
-                // comes from the cross-process setTransactionState call to
-                // SF.  This MUST be an ITransactionCompletedListener.  We
-                // keep it as an IBinder due to consistency reasons: if we
-                // interface_cast at the IPC boundary when reading a Parcel,
-                // we get pointers that compare unequal in the SF process.
-                callbacks.emplace_back([stats = std::move(listenerStats)]() {
-                    interface_cast<ITransactionCompletedListener>(stats.listener)
-                            ->onTransactionCompleted(stats);
-                });
-            }
+        // If the listener has completed transactions and is still alive
+        if (!listenerStats.transactionStats.empty() && listener->isBinderAlive()) {
+            completedListenerStats.push_back(std::move(listenerStats));
         }
         completedTransactionsItr++;
     }
@@ -203,9 +193,53 @@ void TransactionCallbackInvoker::sendCallbacks(bool onCommitOnly) {
         mPresentFence.clear();
     }
 
+    BackgroundExecutor::Callbacks callbacks;
+    {
+        std::lock_guard lock(mPendingCallbacks->mutex);
+        for (auto& listenerStats : completedListenerStats) {
+            auto [it, inserted] =
+                    mPendingCallbacks->listenerStats.try_emplace(listenerStats.listener);
+            if (inserted) {
+                it->second = std::move(listenerStats);
+                callbacks.emplace_back([pendingCallbacks = mPendingCallbacks,
+                                        listener = it->first]() {
+                    sendPendingCallbacks(*pendingCallbacks, listener);
+                });
+                continue;
+            }
+
+            // The callback of a previous frame has not been sent yet, so deliver these
+            // transactions along with it.
+            auto& pendingStats = it->second.transactionStats;
+            pendingStats.insert(pendingStats.end(),
+                                std::make_move_iterator(listenerStats.transactionStats.begin()),
+                                std::make_move_iterator(listenerStats.transactionStats.end()));
+        }
+    }
+
     BackgroundExecutor::getInstance().sendCallbacks(std::move(callbacks));
 }
 
+void TransactionCallbackInvoker::sendPendingCallbacks(PendingCallbacks& pendingCallbacks,
+                                                      const sp<IBinder>& listener) {
+    ListenerStats stats;
+    {
+        std::lock_guard lock(pendingCallbacks.mutex);
+        auto it = pendingCallbacks.listenerStats.find(listener);
+        if (it == pendingCallbacks.listenerStats.end()) {
+            return;
+        }
+        stats = std::move(it->second);
+        pendingCallbacks.listenerStats.erase(it);
+    }
+
+    // Send callback.  The listener stored in listenerStats comes from the cross-process
+    // setTransactionState call to SF.  This MUST be an ITransactionCompletedListener.  We keep it
+    // as an IBinder due to consistency reasons: if we interface_cast at the IPC boundary when
+    // reading a Parcel, we get pointers that compare unequal in the SF process.
+    interface_cast<ITransactionCompletedListener>(stats.listener)->onTransactionCompleted(stats);
+}
+
 // -----------------------------------------------------------------------
 
 CallbackHandle::CallbackHandle(const sp<IBinder>& transactionListener,
@@ -18,6 +18,7 @@
 
 #include <condition_variable>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
@@ -89,6 +90,22 @@ private:
         mCompletedTransactions;
 
     sp<Fence> mPresentFence;
+
+    // Completed transactions that have been handed to the BackgroundExecutor but not sent yet.
+    // While a listener's callback is still queued, the transactions of later frames are appended
+    // to it rather than queueing another binder call, so a listener that has fallen behind gets
+    // a single onTransactionCompleted covering all of them. Shared with the queued callbacks so
+    // that they stay valid if the invoker goes away first.
+    struct PendingCallbacks {
+        std::mutex mutex;
+        std::unordered_map<sp<IBinder>, ListenerStats, IListenerHash> listenerStats
+                GUARDED_BY(mutex);
+    };
+    const std::shared_ptr<PendingCallbacks> mPendingCallbacks =
+            std::make_shared<PendingCallbacks>();
+
+    static void sendPendingCallbacks(PendingCallbacks& pendingCallbacks,
+                                     const sp<IBinder>& listener);
 };
 
 } // namespace android
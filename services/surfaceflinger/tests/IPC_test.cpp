@@ -38,18 +38,13 @@ namespace android {
 namespace test {
 
 using Transaction = SurfaceComposerClient::Transaction;
-using CallbackInfo = SurfaceComposerClient::CallbackInfo;
-using TCLHash = SurfaceComposerClient::TCLHash;
 using android::hardware::graphics::common::V1_1::BufferUsage;
 
 class TransactionHelper : public Transaction {
 public:
     size_t getNumListeners() { return mListenerCallbacks.size(); }
 
-    std::unordered_map<sp<ITransactionCompletedListener>, CallbackInfo, TCLHash>
-    getListenerCallbacks() {
-        return mListenerCallbacks;
-    }
+    ListenerCallbackMap getListenerCallbacks() { return mListenerCallbacks; }
 };
 
 class IPCTestUtils {
@@ -144,5 +144,77 @@ TEST(LayerStateTest, ParcellingScreenCaptureResultsWithFenceError) {
     ASSERT_EQ(results.fenceResult.error(), results2.fenceResult.error());
 }
 
+TEST(LayerStateTest, ParcellingLayerStateOnlyChangedFields) {
+    layer_state_t s;
+    s.surface = sp<BBinder>::make();
+    s.layerId = 7;
+    s.what = layer_state_t::ePositionChanged | layer_state_t::eAlphaChanged |
+            layer_state_t::eCornerRadiusChanged;
+    s.x = 12.f;
+    s.y = 34.f;
+    s.color.a = 0.5f;
+    s.cornerRadius = 8.f;
+    // Not covered by |what|, so it must not be sent.
+    s.z = 42;
+    s.shadowRadius = 3.f;
+
+    Parcel p;
+    ASSERT_EQ(OK, s.write(p));
+    p.setDataPosition(0);
+
+    layer_state_t s2;
+    ASSERT_EQ(OK, s2.read(p));
+    ASSERT_EQ(p.dataSize(), p.dataPosition());
+
+    ASSERT_EQ(s.surface, s2.surface);
+    ASSERT_EQ(s.layerId, s2.layerId);
+    ASSERT_EQ(s.what, s2.what);
+    ASSERT_EQ(s.x, s2.x);
+    ASSERT_EQ(s.y, s2.y);
+    ASSERT_EQ(s.color.a, s2.color.a);
+    ASSERT_EQ(s.cornerRadius, s2.cornerRadius);
+
+    const layer_state_t defaults;
+    ASSERT_EQ(defaults.z, s2.z);
+    ASSERT_EQ(defaults.shadowRadius, s2.shadowRadius);
+    ASSERT_EQ(defaults.crop, s2.crop);
+}
+
+TEST(LayerStateTest, ParcellingLayerStateGroupedFields) {
+    layer_state_t s;
+    s.what = layer_state_t::eFlagsChanged | layer_state_t::eBackgroundColorChanged |
+            layer_state_t::eBlurRegionsChanged | layer_state_t::eDesiredHdrHeadroomChanged;
+    s.flags = layer_state_t::eLayerHidden;
+    s.mask = layer_state_t::eLayerHidden;
+    s.bgColor = half4(0.1f, 0.2f, 0.3f, 0.4f);
+    s.bgColorDataspace = ui::Dataspace::V0_SRGB;
+    BlurRegion region;
+    region.blurRadius = 5;
+    region.left = 1;
+    region.right = 9;
+    s.blurRegions.push_back(region);
+    s.desiredHdrSdrRatio = 2.f;
+    s.currentHdrSdrRatio = 3.f;
+
+    Parcel p;
+    ASSERT_EQ(OK, s.write(p));
+    p.setDataPosition(0);
+
+    layer_state_t s2;
+    ASSERT_EQ(OK, s2.read(p));
+    ASSERT_EQ(p.dataSize(), p.dataPosition());
+
+    ASSERT_EQ(s.flags, s2.flags);
+    ASSERT_EQ(s.mask, s2.mask);
+    ASSERT_EQ(s.bgColor, s2.bgColor);
+    ASSERT_EQ(s.bgColorDataspace, s2.bgColorDataspace);
+    ASSERT_EQ(1u, s2.blurRegions.size());
+    ASSERT_EQ(region.blurRadius, s2.blurRegions[0].blurRadius);
+    ASSERT_EQ(region.right, s2.blurRegions[0].right);
+    ASSERT_EQ(s.desiredHdrSdrRatio, s2.desiredHdrSdrRatio);
+    // Only sent with eExtendedRangeBrightnessChanged.
+    ASSERT_EQ(layer_state_t().currentHdrSdrRatio, s2.currentHdrSdrRatio);
+}
+
 } // namespace test
 } // namespace android
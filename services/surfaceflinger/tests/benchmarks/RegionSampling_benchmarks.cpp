@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <ui/Transform.h>
+
+#include <random>
+#include <vector>
+
+#include "RegionSamplingThread.h"
+
+namespace android {
+namespace {
+
+// A downscaled sampling buffer, roughly what is captured for a 1080x2400 display.
+constexpr int32_t kWidth = 540;
+constexpr int32_t kStride = 544;
+constexpr int32_t kHeight = 1200;
+constexpr uint32_t kOrientation = ui::Transform::ROT_0;
+
+std::vector<uint32_t> makeBuffer() {
+    std::vector<uint32_t> buffer(kStride * kHeight);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<uint32_t> distribution;
+    for (auto& pixel : buffer) {
+        pixel = distribution(generator);
+    }
+    return buffer;
+}
+
+// Status bar, navigation bar and launcher listeners, several of which sample the same strips.
+std::vector<Rect> makeAreas(int count) {
+    const std::vector<Rect> listenerAreas = {
+            // status bar
+            Rect(0, 0, kWidth, 40),
+            // navigation bar
+            Rect(0, kHeight - 60, kWidth, kHeight),
+            // navigation handle
+            Rect(kWidth / 4, kHeight - 48, 3 * kWidth / 4, kHeight - 12),
+            // status bar icons
+            Rect(0, 0, kWidth / 2, 40),
+            // launcher hotseat
+            Rect(0, kHeight - 240, kWidth, kHeight),
+            // launcher search bar
+            Rect(0, 40, kWidth, 200),
+            // status bar clock
+            Rect(kWidth / 2, 0, kWidth, 40),
+            // launcher page indicator
+            Rect(0, kHeight - 120, kWidth, kHeight),
+    };
+    return {listenerAreas.begin(), listenerAreas.begin() + count};
+}
+
+void BM_sampleAreaPerListener(benchmark::State& state) {
+    const auto buffer = makeBuffer();
+    const auto areas = makeAreas(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto& area : areas) {
+            benchmark::DoNotOptimize(
+                    sampleArea(buffer.data(), kWidth, kHeight, kStride, kOrientation, area));
+        }
+    }
+}
+BENCHMARK(BM_sampleAreaPerListener)->DenseRange(1, 8);
+
+void BM_sampleAreas(benchmark::State& state) {
+    const auto buffer = makeBuffer();
+    const auto areas = makeAreas(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                sampleAreas(buffer.data(), kWidth, kHeight, kStride, kOrientation, areas));
+    }
+}
+BENCHMARK(BM_sampleAreas)->DenseRange(1, 8);
+
+} // namespace
+} // namespace android
+
+BENCHMARK_MAIN();
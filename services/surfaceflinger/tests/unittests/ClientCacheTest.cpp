@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#undef LOG_TAG
+#define LOG_TAG "ClientCacheTest"
+
+#include <binder/Binder.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <renderengine/mock/RenderEngine.h>
+#include <ui/GraphicBuffer.h>
+
+#include "ClientCache.h"
+
+namespace android {
+namespace {
+
+using testing::HasSubstr;
+
+class ErasedRecipient : public ClientCache::ErasedRecipient {
+public:
+    void bufferErased(const client_cache_t& clientCacheId) override {
+        erasedIds.push_back(clientCacheId.id);
+    }
+
+    std::vector<uint64_t> erasedIds;
+};
+
+class ClientCacheTest : public testing::Test {
+protected:
+    ClientCacheTest() { mCache.setRenderEngine(&mRenderEngine); }
+
+    ~ClientCacheTest() {
+        mCache.removeProcess(mProcessToken);
+        mCache.removeProcess(mOtherProcessToken);
+    }
+
+    static sp<GraphicBuffer> makeBuffer() {
+        return sp<GraphicBuffer>::make(16u, 16u, PIXEL_FORMAT_RGBA_8888,
+                                       GRALLOC_USAGE_SW_WRITE_OFTEN | GRALLOC_USAGE_SW_READ_OFTEN);
+    }
+
+    // The cache must be torn down before the RenderEngine its textures were mapped with.
+    testing::NiceMock<renderengine::mock::RenderEngine> mRenderEngine;
+    ClientCache mCache;
+    sp<IBinder> mProcessToken = sp<BBinder>::make();
+    sp<IBinder> mOtherProcessToken = sp<BBinder>::make();
+};
+
+TEST_F(ClientCacheTest, addGetAndErase) {
+    const client_cache_t cacheId = {mProcessToken, 1};
+    const auto buffer = makeBuffer();
+
+    const auto added = mCache.add(cacheId, buffer);
+    ASSERT_TRUE(added.ok());
+    EXPECT_EQ(buffer, added.value()->getBuffer());
+    EXPECT_EQ(added.value(), mCache.get(cacheId));
+
+    EXPECT_EQ(buffer, mCache.erase(cacheId));
+    EXPECT_EQ(nullptr, mCache.get(cacheId));
+    EXPECT_EQ(nullptr, mCache.erase(cacheId));
+}
+
+TEST_F(ClientCacheTest, processesAreIndependent) {
+    const client_cache_t cacheId = {mProcessToken, 1};
+    const client_cache_t otherCacheId = {mOtherProcessToken, 1};
+    ASSERT_TRUE(mCache.add(cacheId, makeBuffer()).ok());
+    ASSERT_TRUE(mCache.add(otherCacheId, makeBuffer()).ok());
+    EXPECT_NE(mCache.get(cacheId), mCache.get(otherCacheId));
+
+    mCache.removeProcess(mProcessToken);
+    EXPECT_EQ(nullptr, mCache.get(cacheId));
+    EXPECT_NE(nullptr, mCache.get(otherCacheId));
+}
+
+TEST_F(ClientCacheTest, removeProcessNotifiesErasedRecipients) {
+    const auto recipient = sp<ErasedRecipient>::make();
+    for (uint64_t id = 1; id <= 3; id++) {
+        const client_cache_t cacheId = {mProcessToken, id};
+        ASSERT_TRUE(mCache.add(cacheId, makeBuffer()).ok());
+        ASSERT_TRUE(mCache.registerErasedRecipient(cacheId, recipient));
+    }
+    mCache.unregisterErasedRecipient({mProcessToken, 2}, recipient);
+
+    mCache.removeProcess(mProcessToken);
+    EXPECT_THAT(recipient->erasedIds, testing::UnorderedElementsAre(1u, 3u));
+}
+
+TEST_F(ClientCacheTest, dumpReportsHitRateAndMemory) {
+    const client_cache_t cacheId = {mProcessToken, 1};
+    ASSERT_TRUE(mCache.add(cacheId, makeBuffer()).ok());
+    EXPECT_NE(nullptr, mCache.get(cacheId));
+    EXPECT_EQ(nullptr, mCache.get({mProcessToken, 2}));
+
+    std::string result;
+    mCache.dump(result);
+    EXPECT_THAT(result, HasSubstr("buffers: 1"));
+    EXPECT_THAT(result, HasSubstr("lookups: 2, hit rate: 50.00%"));
+}
+
+} // namespace
+} // namespace android
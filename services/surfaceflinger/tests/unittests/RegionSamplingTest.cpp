@@ -27,6 +27,7 @@
 #include <gtest/gtest.h>
 #include <array>
 #include <limits>
+#include <vector>
 
 #include "RegionSamplingThread.h"
 
@@ -106,6 +107,33 @@ TEST_F(RegionSamplingTest, bounds_checking) {
                 testing::Eq(0.0));
 }
 
+TEST_F(RegionSamplingTest, sample_areas_matches_sample_area) {
+    std::generate(buffer.begin(), buffer.end(), [n = 0]() mutable {
+        uint32_t const pixel = (n % std::numeric_limits<uint8_t>::max()) << ((n % 3) * CHAR_BIT);
+        n++;
+        return pixel;
+    });
+
+    std::vector<Rect> const areas = {
+            whole_area,
+            Rect{0, 0, kWidth, 4},
+            Rect{0, 0, kWidth >> 1, 4},
+            Rect{10, 2, 40, 20},
+            Rect{30, 10, 60, kHeight},
+            Rect{60, 10, 70, 12},
+            Rect{0, 0, 4, kHeight + 1},
+            Rect{3, 0, 2, 0},
+    };
+    auto const lumas = sampleAreas(buffer.data(), kWidth, kHeight, kStride, kOrientation, areas);
+    ASSERT_EQ(areas.size(), lumas.size());
+    for (size_t i = 0; i < areas.size(); ++i) {
+        EXPECT_THAT(lumas[i],
+                    testing::FloatEq(sampleArea(buffer.data(), kWidth, kHeight, kStride,
+                                                kOrientation, areas[i])))
+                << "area " << i;
+    }
+}
+
 } // namespace android
 
 // TODO(b/129481165): remove the #pragma below and fix conversion issues
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#undef LOG_TAG
+#define LOG_TAG "ScreenCaptureBufferPoolTest"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <android-base/unique_fd.h>
+#include <binder/Binder.h>
+#include <unistd.h>
+
+#include "ScreenCaptureBufferPool.h"
+
+namespace android {
+namespace {
+
+using Client = ScreenCaptureBufferPool::Client;
+
+constexpr Client kClient = {1234, 10001};
+// A process of another app.
+constexpr Client kOtherClient = {1235, 10002};
+// Another process sharing the uid of kClient.
+constexpr Client kSharedUidClient = {1236, 10001};
+constexpr uint32_t kWidth = 32;
+constexpr uint32_t kHeight = 16;
+constexpr uint64_t kUsage = GRALLOC_USAGE_HW_RENDER | GRALLOC_USAGE_SW_READ_OFTEN;
+
+sp<GraphicBuffer> makeBuffer() {
+    return sp<GraphicBuffer>::make(kWidth, kHeight, PIXEL_FORMAT_RGBA_8888, kUsage);
+}
+
+class ScreenCaptureBufferPoolTest : public testing::Test {
+protected:
+    sp<GraphicBuffer> acquire(Client client) {
+        return mPool.acquire(client, kWidth, kHeight, PIXEL_FORMAT_RGBA_8888, kUsage);
+    }
+
+    bool release(Client client, uint64_t bufferId) {
+        return mPool.release(client, bufferId, Fence::NO_FENCE);
+    }
+
+    ScreenCaptureBufferPool mPool;
+};
+
+TEST_F(ScreenCaptureBufferPoolTest, doesNotTrackCallersThatNeverRelease) {
+    const auto buffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    EXPECT_FALSE(release(kClient, buffer->getId()));
+    EXPECT_EQ(nullptr, acquire(kClient));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, reusesReleasedBuffer) {
+    // The first release opts the caller in to buffer recycling.
+    release(kClient, 0);
+
+    const auto buffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    EXPECT_EQ(nullptr, acquire(kClient));
+
+    EXPECT_TRUE(release(kClient, buffer->getId()));
+    EXPECT_EQ(buffer, acquire(kClient));
+    EXPECT_EQ(nullptr, acquire(kClient));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, onlyReusesBuffersOfTheSameClient) {
+    release(kClient, 0);
+    release(kOtherClient, 0);
+    release(kSharedUidClient, 0);
+
+    const auto buffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    EXPECT_FALSE(release(kOtherClient, buffer->getId()));
+    EXPECT_FALSE(release(kSharedUidClient, buffer->getId()));
+    EXPECT_TRUE(release(kClient, buffer->getId()));
+    EXPECT_EQ(nullptr, acquire(kOtherClient));
+    EXPECT_EQ(nullptr, acquire(kSharedUidClient));
+    EXPECT_EQ(buffer, acquire(kClient));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, onlyReusesMatchingBuffers) {
+    release(kClient, 0);
+
+    const auto buffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    EXPECT_TRUE(release(kClient, buffer->getId()));
+    EXPECT_EQ(nullptr, mPool.acquire(kClient, kWidth * 2, kHeight, PIXEL_FORMAT_RGBA_8888, kUsage));
+    EXPECT_EQ(nullptr, mPool.acquire(kClient, kWidth, kHeight, PIXEL_FORMAT_RGBX_8888, kUsage));
+    EXPECT_EQ(nullptr,
+              mPool.acquire(kClient, kWidth, kHeight, PIXEL_FORMAT_RGBA_8888,
+                            kUsage | GRALLOC_USAGE_PROTECTED));
+    EXPECT_EQ(buffer, acquire(kClient));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, waitsForReleaseFence) {
+    release(kClient, 0);
+
+    const auto buffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    base::unique_fd writeFd(fds[1]);
+    // Fence::wait polls the fd, so a pipe with nothing written to it never signals.
+    EXPECT_TRUE(mPool.release(kClient, buffer->getId(), sp<Fence>::make(fds[0])));
+
+    // The caller is still reading the buffer, so it must not be rendered into.
+    EXPECT_EQ(nullptr, acquire(kClient));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, dropsBuffersOfDeadClients) {
+    release(kClient, 0);
+    release(kOtherClient, 0);
+
+    const sp<IBinder> token = sp<BBinder>::make();
+    const sp<IBinder> otherToken = sp<BBinder>::make();
+    const auto buffer = makeBuffer();
+    const auto otherBuffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, token);
+    mPool.onBufferSent(kOtherClient, otherBuffer, otherToken);
+    EXPECT_TRUE(release(kClient, buffer->getId()));
+    EXPECT_TRUE(release(kOtherClient, otherBuffer->getId()));
+
+    mPool.onClientDied(token);
+    EXPECT_EQ(nullptr, acquire(kClient));
+    EXPECT_EQ(otherBuffer, acquire(kOtherClient));
+
+    // A dead client has to opt in to recycling again.
+    const auto newBuffer = makeBuffer();
+    mPool.onBufferSent(kClient, newBuffer, token);
+    EXPECT_FALSE(release(kClient, newBuffer->getId()));
+}
+
+TEST_F(ScreenCaptureBufferPoolTest, forgetsLeastRecentlyActiveClients) {
+    release(kClient, 0);
+    release(kOtherClient, 0);
+
+    const auto buffer = makeBuffer();
+    const auto otherBuffer = makeBuffer();
+    mPool.onBufferSent(kClient, buffer, nullptr);
+    mPool.onBufferSent(kOtherClient, otherBuffer, nullptr);
+
+    // Many short-lived processes opt in without ever being sent a buffer, while kClient keeps
+    // capturing.
+    for (pid_t pid = 2000; pid < 2100; pid++) {
+        release({pid, 10003}, 0);
+        release(kClient, 0);
+    }
+
+    EXPECT_TRUE(release(kClient, buffer->getId()));
+    EXPECT_FALSE(release(kOtherClient, otherBuffer->getId()));
+}
+
+} // namespace
+} // namespace android
@@ -28,6 +28,33 @@ namespace driver {
 
 namespace {
 
+// Minimal perfect hash over function names, see perfect_hash() in
+// scripts/generator_common.py.
+uint32_t ProcHash(const char* name) {
+    uint32_t hash = 0x811c9dc5u;
+    for (; *name; name++)
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 0x01000193u;
+    return hash;
+}
+
+uint32_t ProcHashMix(uint32_t hash, uint32_t seed) {
+    hash ^= seed * 0x9e3779b9u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Returns the only slot of an N entry table that can hold name. The caller
+// must still compare the name stored in that slot.
+template <size_t N, size_t B>
+size_t ProcHashSlot(const char* name, const uint32_t (&seeds)[B]) {
+    uint32_t hash = ProcHash(name);
+    return ProcHashMix(hash, seeds[ProcHashMix(hash, 0) % B]) % N;
+}
+
 // clang-format off
 
 VKAPI_ATTR VkResult checkedCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain) {
@@ -176,39 +203,60 @@ VKAPI_ATTR VkResult checkedReleaseSwapchainImagesEXT(VkDevice device, const VkRe
 const ProcHook g_proc_hooks[] = {
     // clang-format off
     {
-        "vkAcquireImageANDROID",
-        ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        "vkEnumeratePhysicalDevices",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(EnumeratePhysicalDevices),
         nullptr,
     },
     {
-        "vkAcquireNextImage2KHR",
+        "vkQueueSubmit",
         ProcHook::DEVICE,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(QueueSubmit),
+        nullptr,
+    },
+    {
+        "vkGetPhysicalDevicePresentRectanglesKHR",
+        ProcHook::INSTANCE,
         ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(AcquireNextImage2KHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedAcquireNextImage2KHR),
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDevicePresentRectanglesKHR),
+        nullptr,
     },
     {
-        "vkAcquireNextImageKHR",
+        "vkGetPhysicalDeviceExternalSemaphoreProperties",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalSemaphoreProperties),
+        nullptr,
+    },
+    {
+        "vkGetPhysicalDeviceSurfaceCapabilities2KHR",
+        ProcHook::INSTANCE,
+        ProcHook::KHR_get_surface_capabilities2,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceCapabilities2KHR),
+        nullptr,
+    },
+    {
+        "vkCreateSwapchainKHR",
         ProcHook::DEVICE,
         ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(AcquireNextImageKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedAcquireNextImageKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(CreateSwapchainKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedCreateSwapchainKHR),
     },
     {
-        "vkAllocateCommandBuffers",
+        "vkDestroySwapchainKHR",
         ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(AllocateCommandBuffers),
-        nullptr,
+        ProcHook::KHR_swapchain,
+        reinterpret_cast<PFN_vkVoidFunction>(DestroySwapchainKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedDestroySwapchainKHR),
     },
     {
-        "vkBindImageMemory2",
-        ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(BindImageMemory2),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedBindImageMemory2),
+        "vkDestroySurfaceKHR",
+        ProcHook::INSTANCE,
+        ProcHook::KHR_surface,
+        reinterpret_cast<PFN_vkVoidFunction>(DestroySurfaceKHR),
+        nullptr,
     },
     {
         "vkBindImageMemory2KHR",
@@ -218,17 +266,17 @@ const ProcHook g_proc_hooks[] = {
         reinterpret_cast<PFN_vkVoidFunction>(checkedBindImageMemory2KHR),
     },
     {
-        "vkCreateAndroidSurfaceKHR",
+        "vkGetPhysicalDeviceImageFormatProperties2",
         ProcHook::INSTANCE,
-        ProcHook::KHR_android_surface,
-        reinterpret_cast<PFN_vkVoidFunction>(CreateAndroidSurfaceKHR),
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceImageFormatProperties2),
         nullptr,
     },
     {
-        "vkCreateDebugReportCallbackEXT",
+        "vkGetPhysicalDeviceExternalBufferProperties",
         ProcHook::INSTANCE,
-        ProcHook::EXT_debug_report,
-        reinterpret_cast<PFN_vkVoidFunction>(CreateDebugReportCallbackEXT),
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalBufferProperties),
         nullptr,
     },
     {
@@ -239,18 +287,11 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkCreateInstance",
-        ProcHook::GLOBAL,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(CreateInstance),
-        nullptr,
-    },
-    {
-        "vkCreateSwapchainKHR",
+        "vkSetHdrMetadataEXT",
         ProcHook::DEVICE,
-        ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(CreateSwapchainKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedCreateSwapchainKHR),
+        ProcHook::EXT_hdr_metadata,
+        reinterpret_cast<PFN_vkVoidFunction>(SetHdrMetadataEXT),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedSetHdrMetadataEXT),
     },
     {
         "vkDebugReportMessageEXT",
@@ -260,10 +301,17 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkDestroyDebugReportCallbackEXT",
+        "vkBindImageMemory2",
+        ProcHook::DEVICE,
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(BindImageMemory2),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedBindImageMemory2),
+    },
+    {
+        "vkGetPhysicalDeviceQueueFamilyProperties2",
         ProcHook::INSTANCE,
-        ProcHook::EXT_debug_report,
-        reinterpret_cast<PFN_vkVoidFunction>(DestroyDebugReportCallbackEXT),
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceQueueFamilyProperties2),
         nullptr,
     },
     {
@@ -274,31 +322,59 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkDestroyInstance",
-        ProcHook::INSTANCE,
+        "vkAcquireNextImage2KHR",
+        ProcHook::DEVICE,
+        ProcHook::KHR_swapchain,
+        reinterpret_cast<PFN_vkVoidFunction>(AcquireNextImage2KHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedAcquireNextImage2KHR),
+    },
+    {
+        "vkAcquireImageANDROID",
+        ProcHook::DEVICE,
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
+        nullptr,
+    },
+    {
+        "vkGetDeviceQueue",
+        ProcHook::DEVICE,
         ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(DestroyInstance),
+        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceQueue),
         nullptr,
     },
     {
-        "vkDestroySurfaceKHR",
+        "vkGetRefreshCycleDurationGOOGLE",
+        ProcHook::DEVICE,
+        ProcHook::GOOGLE_display_timing,
+        reinterpret_cast<PFN_vkVoidFunction>(GetRefreshCycleDurationGOOGLE),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetRefreshCycleDurationGOOGLE),
+    },
+    {
+        "vkGetSwapchainGrallocUsage2ANDROID",
+        ProcHook::DEVICE,
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
+        nullptr,
+    },
+    {
+        "vkGetPhysicalDeviceFeatures2",
         ProcHook::INSTANCE,
-        ProcHook::KHR_surface,
-        reinterpret_cast<PFN_vkVoidFunction>(DestroySurfaceKHR),
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceFeatures2),
         nullptr,
     },
     {
-        "vkDestroySwapchainKHR",
+        "vkGetSwapchainGrallocUsage3ANDROID",
         ProcHook::DEVICE,
-        ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(DestroySwapchainKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedDestroySwapchainKHR),
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
+        nullptr,
     },
     {
-        "vkEnumerateDeviceExtensionProperties",
+        "vkGetPhysicalDeviceSurfaceFormatsKHR",
         ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(EnumerateDeviceExtensionProperties),
+        ProcHook::KHR_surface,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceFormatsKHR),
         nullptr,
     },
     {
@@ -309,123 +385,123 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkEnumeratePhysicalDeviceGroups",
+        "vkDestroyInstance",
         ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(EnumeratePhysicalDeviceGroups),
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(DestroyInstance),
         nullptr,
     },
     {
-        "vkEnumeratePhysicalDevices",
+        "vkGetPhysicalDeviceFormatProperties2",
         ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(EnumeratePhysicalDevices),
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceFormatProperties2),
         nullptr,
     },
     {
-        "vkGetDeviceGroupPresentCapabilitiesKHR",
+        "vkQueuePresentKHR",
         ProcHook::DEVICE,
         ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceGroupPresentCapabilitiesKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceGroupPresentCapabilitiesKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(QueuePresentKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedQueuePresentKHR),
     },
     {
-        "vkGetDeviceGroupSurfacePresentModesKHR",
+        "vkGetSwapchainImagesKHR",
         ProcHook::DEVICE,
         ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceGroupSurfacePresentModesKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceGroupSurfacePresentModesKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(GetSwapchainImagesKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetSwapchainImagesKHR),
     },
     {
-        "vkGetDeviceProcAddr",
+        "vkGetSwapchainGrallocUsageANDROID",
         ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceProcAddr),
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
         nullptr,
     },
     {
-        "vkGetDeviceQueue",
-        ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceQueue),
+        "vkEnumeratePhysicalDeviceGroups",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(EnumeratePhysicalDeviceGroups),
         nullptr,
     },
     {
-        "vkGetDeviceQueue2",
+        "vkAcquireNextImageKHR",
         ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceQueue2),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceQueue2),
+        ProcHook::KHR_swapchain,
+        reinterpret_cast<PFN_vkVoidFunction>(AcquireNextImageKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedAcquireNextImageKHR),
     },
     {
-        "vkGetInstanceProcAddr",
-        ProcHook::INSTANCE,
+        "vkAllocateCommandBuffers",
+        ProcHook::DEVICE,
         ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(GetInstanceProcAddr),
+        reinterpret_cast<PFN_vkVoidFunction>(AllocateCommandBuffers),
         nullptr,
     },
     {
-        "vkGetPastPresentationTimingGOOGLE",
+        "vkGetSwapchainGrallocUsage4ANDROID",
         ProcHook::DEVICE,
-        ProcHook::GOOGLE_display_timing,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPastPresentationTimingGOOGLE),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetPastPresentationTimingGOOGLE),
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
+        nullptr,
     },
     {
-        "vkGetPhysicalDeviceExternalBufferProperties",
-        ProcHook::INSTANCE,
+        "vkGetDeviceQueue2",
+        ProcHook::DEVICE,
         ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalBufferProperties),
-        nullptr,
+        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceQueue2),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceQueue2),
     },
     {
-        "vkGetPhysicalDeviceExternalFenceProperties",
-        ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalFenceProperties),
+        "vkQueueSignalReleaseImageANDROID",
+        ProcHook::DEVICE,
+        ProcHook::ANDROID_native_buffer,
+        nullptr,
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceExternalSemaphoreProperties",
+        "vkGetPhysicalDeviceSurfaceSupportKHR",
         ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalSemaphoreProperties),
+        ProcHook::KHR_surface,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceSupportKHR),
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceFeatures2",
+        "vkGetPhysicalDeviceExternalFenceProperties",
         ProcHook::INSTANCE,
         ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceFeatures2),
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceExternalFenceProperties),
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceFormatProperties2",
-        ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceFormatProperties2),
+        "vkCreateInstance",
+        ProcHook::GLOBAL,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(CreateInstance),
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceImageFormatProperties2",
-        ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceImageFormatProperties2),
-        nullptr,
+        "vkGetPastPresentationTimingGOOGLE",
+        ProcHook::DEVICE,
+        ProcHook::GOOGLE_display_timing,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPastPresentationTimingGOOGLE),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetPastPresentationTimingGOOGLE),
     },
     {
-        "vkGetPhysicalDeviceMemoryProperties2",
+        "vkGetPhysicalDeviceSurfaceFormats2KHR",
         ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceMemoryProperties2),
+        ProcHook::KHR_get_surface_capabilities2,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceFormats2KHR),
         nullptr,
     },
     {
-        "vkGetPhysicalDevicePresentRectanglesKHR",
-        ProcHook::INSTANCE,
-        ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDevicePresentRectanglesKHR),
-        nullptr,
+        "vkReleaseSwapchainImagesEXT",
+        ProcHook::DEVICE,
+        ProcHook::EXT_swapchain_maintenance1,
+        reinterpret_cast<PFN_vkVoidFunction>(ReleaseSwapchainImagesEXT),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedReleaseSwapchainImagesEXT),
     },
     {
         "vkGetPhysicalDeviceProperties2",
@@ -434,13 +510,6 @@ const ProcHook g_proc_hooks[] = {
         reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceProperties2),
         nullptr,
     },
-    {
-        "vkGetPhysicalDeviceQueueFamilyProperties2",
-        ProcHook::INSTANCE,
-        ProcHook::EXTENSION_CORE_1_1,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceQueueFamilyProperties2),
-        nullptr,
-    },
     {
         "vkGetPhysicalDeviceSparseImageFormatProperties2",
         ProcHook::INSTANCE,
@@ -449,11 +518,11 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceSurfaceCapabilities2KHR",
-        ProcHook::INSTANCE,
-        ProcHook::KHR_get_surface_capabilities2,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceCapabilities2KHR),
-        nullptr,
+        "vkGetDeviceGroupPresentCapabilitiesKHR",
+        ProcHook::DEVICE,
+        ProcHook::KHR_swapchain,
+        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceGroupPresentCapabilitiesKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceGroupPresentCapabilitiesKHR),
     },
     {
         "vkGetPhysicalDeviceSurfaceCapabilitiesKHR",
@@ -463,18 +532,11 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceSurfaceFormats2KHR",
-        ProcHook::INSTANCE,
-        ProcHook::KHR_get_surface_capabilities2,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceFormats2KHR),
-        nullptr,
-    },
-    {
-        "vkGetPhysicalDeviceSurfaceFormatsKHR",
-        ProcHook::INSTANCE,
-        ProcHook::KHR_surface,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceFormatsKHR),
-        nullptr,
+        "vkGetSwapchainStatusKHR",
+        ProcHook::DEVICE,
+        ProcHook::KHR_shared_presentable_image,
+        reinterpret_cast<PFN_vkVoidFunction>(GetSwapchainStatusKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetSwapchainStatusKHR),
     },
     {
         "vkGetPhysicalDeviceSurfacePresentModesKHR",
@@ -484,108 +546,78 @@ const ProcHook g_proc_hooks[] = {
         nullptr,
     },
     {
-        "vkGetPhysicalDeviceSurfaceSupportKHR",
+        "vkCreateAndroidSurfaceKHR",
         ProcHook::INSTANCE,
-        ProcHook::KHR_surface,
-        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceSurfaceSupportKHR),
+        ProcHook::KHR_android_surface,
+        reinterpret_cast<PFN_vkVoidFunction>(CreateAndroidSurfaceKHR),
         nullptr,
     },
     {
-        "vkGetRefreshCycleDurationGOOGLE",
+        "vkGetDeviceGroupSurfacePresentModesKHR",
         ProcHook::DEVICE,
-        ProcHook::GOOGLE_display_timing,
-        reinterpret_cast<PFN_vkVoidFunction>(GetRefreshCycleDurationGOOGLE),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetRefreshCycleDurationGOOGLE),
+        ProcHook::KHR_swapchain,
+        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceGroupSurfacePresentModesKHR),
+        reinterpret_cast<PFN_vkVoidFunction>(checkedGetDeviceGroupSurfacePresentModesKHR),
     },
     {
-        "vkGetSwapchainGrallocUsage2ANDROID",
+        "vkGetDeviceProcAddr",
         ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(GetDeviceProcAddr),
         nullptr,
     },
     {
-        "vkGetSwapchainGrallocUsage3ANDROID",
-        ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        "vkGetInstanceProcAddr",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(GetInstanceProcAddr),
         nullptr,
     },
     {
-        "vkGetSwapchainGrallocUsage4ANDROID",
-        ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        "vkEnumerateDeviceExtensionProperties",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_0,
+        reinterpret_cast<PFN_vkVoidFunction>(EnumerateDeviceExtensionProperties),
         nullptr,
     },
     {
-        "vkGetSwapchainGrallocUsageANDROID",
-        ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        "vkCreateDebugReportCallbackEXT",
+        ProcHook::INSTANCE,
+        ProcHook::EXT_debug_report,
+        reinterpret_cast<PFN_vkVoidFunction>(CreateDebugReportCallbackEXT),
         nullptr,
     },
     {
-        "vkGetSwapchainImagesKHR",
-        ProcHook::DEVICE,
-        ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(GetSwapchainImagesKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetSwapchainImagesKHR),
-    },
-    {
-        "vkGetSwapchainStatusKHR",
-        ProcHook::DEVICE,
-        ProcHook::KHR_shared_presentable_image,
-        reinterpret_cast<PFN_vkVoidFunction>(GetSwapchainStatusKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedGetSwapchainStatusKHR),
-    },
-    {
-        "vkQueuePresentKHR",
-        ProcHook::DEVICE,
-        ProcHook::KHR_swapchain,
-        reinterpret_cast<PFN_vkVoidFunction>(QueuePresentKHR),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedQueuePresentKHR),
-    },
-    {
-        "vkQueueSignalReleaseImageANDROID",
-        ProcHook::DEVICE,
-        ProcHook::ANDROID_native_buffer,
-        nullptr,
+        "vkDestroyDebugReportCallbackEXT",
+        ProcHook::INSTANCE,
+        ProcHook::EXT_debug_report,
+        reinterpret_cast<PFN_vkVoidFunction>(DestroyDebugReportCallbackEXT),
         nullptr,
     },
     {
-        "vkQueueSubmit",
-        ProcHook::DEVICE,
-        ProcHook::EXTENSION_CORE_1_0,
-        reinterpret_cast<PFN_vkVoidFunction>(QueueSubmit),
+        "vkGetPhysicalDeviceMemoryProperties2",
+        ProcHook::INSTANCE,
+        ProcHook::EXTENSION_CORE_1_1,
+        reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceMemoryProperties2),
         nullptr,
     },
-    {
-        "vkReleaseSwapchainImagesEXT",
-        ProcHook::DEVICE,
-        ProcHook::EXT_swapchain_maintenance1,
-        reinterpret_cast<PFN_vkVoidFunction>(ReleaseSwapchainImagesEXT),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedReleaseSwapchainImagesEXT),
-    },
-    {
-        "vkSetHdrMetadataEXT",
-        ProcHook::DEVICE,
-        ProcHook::EXT_hdr_metadata,
-        reinterpret_cast<PFN_vkVoidFunction>(SetHdrMetadataEXT),
-        reinterpret_cast<PFN_vkVoidFunction>(checkedSetHdrMetadataEXT),
-    },
+    // clang-format on
+};
+
+const uint32_t g_proc_hook_seeds[] = {
+    // clang-format off
+    4, 3, 109, 2, 49, 14, 6, 164, 28, 78,
+    39, 295, 50, 82, 24,
     // clang-format on
 };
 
 }  // namespace
 
 const ProcHook* GetProcHook(const char* name) {
-    auto begin = std::cbegin(g_proc_hooks);
-    auto end = std::cend(g_proc_hooks);
-    auto hook = std::lower_bound(
-        begin, end, name,
-        [](const ProcHook& e, const char* n) { return strcmp(e.name, n) < 0; });
-    return (hook < end && strcmp(hook->name, name) == 0) ? hook : nullptr;
+    constexpr size_t count = sizeof(g_proc_hooks) / sizeof(g_proc_hooks[0]);
+    const ProcHook& hook =
+        g_proc_hooks[ProcHashSlot<count>(name, g_proc_hook_seeds)];
+    return (strcmp(hook.name, name) == 0) ? &hook : nullptr;
 }
 
 ProcHook::Extension GetProcHookExtension(const char* name) {
@@ -23,13 +23,16 @@
 #include <dlfcn.h>
 #include <string.h>
 #include <sys/prctl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include <android/dlext.h>
+#include <android-base/file.h>
 #include <android-base/strings.h>
 #include <cutils/properties.h>
 #include <graphicsenv/GraphicsEnv.h>
@@ -38,6 +41,7 @@
 #include <nativeloader/native_loader.h>
 #include <utils/Trace.h>
 #include <ziparchive/zip_archive.h>
+#include <zlib.h>
 
 // TODO(b/143296676): This file currently builds up global data structures as it
 // loads, and never cleans them up. This means we're doing heap allocations
@@ -341,7 +345,174 @@ void* LayerLibrary::GetGPA(const Layer& layer, const std::string_view gpa_name)
 std::vector<LayerLibrary> g_layer_libraries;
 std::vector<Layer> g_instance_layers;
 
-void AddLayerLibrary(const std::string& path, const std::string& filename) {
+// The layer manifest caches the result of layer discovery, so that later
+// processes of the app neither scan the layer search paths nor open every
+// layer library to enumerate its layers. Libraries are then only opened for
+// the layers that are actually enabled.
+//
+// The manifest records a FileStamp of each search path, and of each layer
+// library found in a directory. Adding or removing a library changes the
+// stamp of its directory, and replacing a library changes its own stamp. A
+// library in an APK is covered by the stamp of the APK. The manifest is only
+// used if every stamp still matches, otherwise the layers are discovered
+// again and the manifest is rewritten.
+constexpr uint32_t kLayerManifestMagic =
+    ('V' << 24) | ('k' << 16) | ('L' << 8) | 'M';
+constexpr uint32_t kLayerManifestVersion = 1;
+constexpr size_t kLayerManifestHeaderSize = 3 * sizeof(uint32_t);
+constexpr size_t kNoLibrary = SIZE_MAX;
+
+struct FileStamp {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+
+    bool operator==(const FileStamp& other) const {
+        return dev == other.dev && ino == other.ino && size == other.size &&
+               mtime_sec == other.mtime_sec && mtime_nsec == other.mtime_nsec;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+// returns an all-zero stamp if the file does not exist
+FileStamp GetFileStamp(const std::string& path) {
+    FileStamp stamp = {};
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+        stamp.dev = static_cast<uint64_t>(st.st_dev);
+        stamp.ino = static_cast<uint64_t>(st.st_ino);
+        stamp.size = static_cast<int64_t>(st.st_size);
+        stamp.mtime_sec = static_cast<int64_t>(st.st_mtim.tv_sec);
+        stamp.mtime_nsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
+    }
+    return stamp;
+}
+
+// the stamp of a directory in an APK is the stamp of the APK
+FileStamp GetPathStamp(const std::string& path) {
+    size_t zip_pos = path.find("!/");
+    return GetFileStamp(zip_pos == std::string::npos ? path
+                                                     : path.substr(0, zip_pos));
+}
+
+struct ManifestLibrary {
+    std::string filename;
+    FileStamp stamp;
+    // index into g_layer_libraries, or kNoLibrary if it has no layers
+    size_t library_idx;
+};
+
+struct ManifestPath {
+    std::string path;
+    FileStamp stamp;
+    std::vector<ManifestLibrary> libraries;
+};
+
+class ManifestWriter {
+   public:
+    void Write(const void* data, size_t size) {
+        data_.append(static_cast<const char*>(data), size);
+    }
+    template <typename T>
+    void Write(const T& value) {
+        Write(&value, sizeof(value));
+    }
+    void WriteString(const std::string& str) {
+        Write(static_cast<uint32_t>(str.size()));
+        Write(str.data(), str.size());
+    }
+    void WriteExtensions(const std::vector<VkExtensionProperties>& extensions) {
+        Write(static_cast<uint32_t>(extensions.size()));
+        Write(extensions.data(),
+              extensions.size() * sizeof(VkExtensionProperties));
+    }
+
+    const std::string& GetData() const { return data_; }
+
+   private:
+    std::string data_;
+};
+
+class ManifestReader {
+   public:
+    ManifestReader(const char* data, size_t size)
+        : pos_(data), end_(data + size) {}
+
+    bool Read(void* data, size_t size) {
+        if (size > Remaining())
+            return false;
+        memcpy(data, pos_, size);
+        pos_ += size;
+        return true;
+    }
+    template <typename T>
+    bool Read(T* value) {
+        return Read(value, sizeof(*value));
+    }
+    bool ReadString(std::string* str) {
+        uint32_t size;
+        if (!Read(&size) || size > Remaining())
+            return false;
+        str->assign(pos_, size);
+        pos_ += size;
+        return true;
+    }
+    bool ReadExtensions(std::vector<VkExtensionProperties>* extensions) {
+        uint32_t count;
+        if (!Read(&count) ||
+            count > Remaining() / sizeof(VkExtensionProperties))
+            return false;
+        extensions->resize(count);
+        return Read(extensions->data(),
+                    count * sizeof(VkExtensionProperties));
+    }
+
+    bool AtEnd() const { return pos_ == end_; }
+
+   private:
+    size_t Remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    const char* pos_;
+    const char* end_;
+};
+
+// The fixed-size strings of the properties are copied from the manifest as
+// is, but are later used as C strings.
+template <size_t N>
+bool IsNullTerminated(const char (&str)[N]) {
+    return memchr(str, '\0', N) != nullptr;
+}
+
+bool HasValidStrings(const Layer& layer) {
+    auto valid_extension = [](const VkExtensionProperties& ext) {
+        return IsNullTerminated(ext.extensionName);
+    };
+    return IsNullTerminated(layer.properties.layerName) &&
+           IsNullTerminated(layer.properties.description) &&
+           std::all_of(layer.instance_extensions.cbegin(),
+                       layer.instance_extensions.cend(), valid_extension) &&
+           std::all_of(layer.device_extensions.cbegin(),
+                       layer.device_extensions.cend(), valid_extension);
+}
+
+bool IsLayerLibraryFilename(const std::string& filename) {
+    return android::base::StartsWith(filename, "libVkLayer") &&
+           android::base::EndsWith(filename, ".so") &&
+           filename.find('/') == std::string::npos;
+}
+
+void AddLayerLibrary(const std::string& path,
+                     const std::string& filename,
+                     ManifestPath& manifest) {
+    // Libraries without layers, including those that fail to load, are
+    // recorded too, so that the manifest does not probe them again.
+    ManifestLibrary entry = {filename, {}, kNoLibrary};
+    if (path.find("!/") == std::string::npos)
+        entry.stamp = GetFileStamp(path + "/" + filename);
+    manifest.libraries.push_back(entry);
+
     LayerLibrary library(path + "/" + filename, filename);
     if (!library.Open())
         return;
@@ -353,6 +524,7 @@ void AddLayerLibrary(const std::string& path, const std::string& filename) {
 
     library.Close();
 
+    manifest.libraries.back().library_idx = g_layer_libraries.size();
     g_layer_libraries.emplace_back(std::move(library));
 }
 
@@ -426,14 +598,17 @@ void ForEachFileInPath(const std::string& path, Functor functor) {
     }
 }
 
-void DiscoverLayersInPathList(const std::string& pathstr) {
+void DiscoverLayersInPaths(const std::vector<std::string>& paths,
+                           std::vector<ManifestPath>& manifest) {
     ATRACE_CALL();
 
-    std::vector<std::string> paths = android::base::Split(pathstr, ":");
     for (const auto& path : paths) {
+        // Stamp the path before searching it, so that any change made while
+        // it is searched makes the manifest stale.
+        manifest.push_back({path, GetPathStamp(path), {}});
+        ManifestPath& manifest_path = manifest.back();
         ForEachFileInPath(path, [&](const std::string& filename) {
-            if (android::base::StartsWith(filename, "libVkLayer") &&
-                android::base::EndsWith(filename, ".so")) {
+            if (IsLayerLibraryFilename(filename)) {
 
                 // Check to ensure we haven't seen this layer already
                 // Let the first instance of the shared object be enumerated
@@ -452,12 +627,200 @@ void DiscoverLayersInPathList(const std::string& pathstr) {
                 }
 
                 if (!duplicate)
-                    AddLayerLibrary(path, filename);
+                    AddLayerLibrary(path, filename, manifest_path);
             }
         });
     }
 }
 
+bool LoadLayerManifest(const std::string& filename,
+                       const std::vector<std::string>& paths) {
+    ATRACE_CALL();
+
+    std::string data;
+    if (!android::base::ReadFileToString(filename, &data)) {
+        // It's normal for the manifest to not exist on the first launch.
+        ALOGV("no layer manifest at '%s'", filename.c_str());
+        return false;
+    }
+
+    uint32_t header[3];
+    if (data.size() < kLayerManifestHeaderSize) {
+        ALOGW("layer manifest '%s' is truncated", filename.c_str());
+        return false;
+    }
+    memcpy(header, data.data(), kLayerManifestHeaderSize);
+    const size_t payload_size = data.size() - kLayerManifestHeaderSize;
+    const Bytef* payload =
+        reinterpret_cast<const Bytef*>(data.data() + kLayerManifestHeaderSize);
+    if (header[0] != kLayerManifestMagic ||
+        header[1] != kLayerManifestVersion) {
+        ALOGW("layer manifest '%s' has an unknown format", filename.c_str());
+        return false;
+    }
+    if (header[2] != crc32(crc32(0L, Z_NULL, 0), payload,
+                           static_cast<uInt>(payload_size))) {
+        ALOGW("layer manifest '%s' is corrupt", filename.c_str());
+        return false;
+    }
+
+    ManifestReader reader(data.data() + kLayerManifestHeaderSize,
+                          payload_size);
+    uint32_t layer_size, extension_size, num_paths;
+    if (!reader.Read(&layer_size) || !reader.Read(&extension_size) ||
+        !reader.Read(&num_paths) || layer_size != sizeof(VkLayerProperties) ||
+        extension_size != sizeof(VkExtensionProperties)) {
+        ALOGW("layer manifest '%s' has an unknown format", filename.c_str());
+        return false;
+    }
+    if (num_paths != paths.size()) {
+        ALOGD("layer manifest '%s' is stale", filename.c_str());
+        return false;
+    }
+
+    std::vector<LayerLibrary> libraries;
+    std::vector<Layer> layers;
+    const size_t first_library_idx = g_layer_libraries.size();
+    for (const auto& path : paths) {
+        std::string manifest_path;
+        FileStamp path_stamp;
+        uint32_t num_libraries;
+        if (!reader.ReadString(&manifest_path) || !reader.Read(&path_stamp) ||
+            !reader.Read(&num_libraries)) {
+            ALOGW("layer manifest '%s' is truncated", filename.c_str());
+            return false;
+        }
+        if (manifest_path != path || path_stamp != GetPathStamp(path)) {
+            ALOGD("layer manifest '%s' is stale for '%s'", filename.c_str(),
+                  path.c_str());
+            return false;
+        }
+
+        const bool in_zip = path.find("!/") != std::string::npos;
+        for (uint32_t i = 0; i < num_libraries; i++) {
+            std::string library_filename;
+            FileStamp library_stamp;
+            uint32_t num_layers;
+            if (!reader.ReadString(&library_filename) ||
+                !reader.Read(&library_stamp) || !reader.Read(&num_layers) ||
+                !IsLayerLibraryFilename(library_filename)) {
+                ALOGW("layer manifest '%s' is truncated", filename.c_str());
+                return false;
+            }
+            if (!in_zip &&
+                library_stamp !=
+                    GetFileStamp(path + "/" + library_filename)) {
+                ALOGD("layer manifest '%s' is stale for '%s/%s'",
+                      filename.c_str(), path.c_str(),
+                      library_filename.c_str());
+                return false;
+            }
+            if (num_layers == 0)
+                continue;
+
+            for (uint32_t j = 0; j < num_layers; j++) {
+                Layer layer;
+                uint32_t is_global;
+                if (!reader.Read(&layer.properties) ||
+                    !reader.Read(&is_global) ||
+                    !reader.ReadExtensions(&layer.instance_extensions) ||
+                    !reader.ReadExtensions(&layer.device_extensions)) {
+                    ALOGW("layer manifest '%s' is truncated",
+                          filename.c_str());
+                    return false;
+                }
+                if (!HasValidStrings(layer)) {
+                    ALOGW("layer manifest '%s' is corrupt", filename.c_str());
+                    return false;
+                }
+                layer.library_idx = first_library_idx + libraries.size();
+                layer.is_global = is_global != 0;
+                layers.push_back(std::move(layer));
+            }
+            libraries.emplace_back(path + "/" + library_filename,
+                                   library_filename);
+        }
+    }
+    if (!reader.AtEnd()) {
+        ALOGW("layer manifest '%s' has trailing data", filename.c_str());
+        return false;
+    }
+
+    for (auto& library : libraries)
+        g_layer_libraries.emplace_back(std::move(library));
+    for (auto& layer : layers) {
+        ALOGD("added %s layer '%s' from layer manifest '%s'",
+              (layer.is_global) ? "global" : "instance",
+              layer.properties.layerName, filename.c_str());
+        g_instance_layers.push_back(std::move(layer));
+    }
+    return true;
+}
+
+void SaveLayerManifest(const std::string& filename,
+                       const std::vector<ManifestPath>& manifest) {
+    ATRACE_CALL();
+
+    ManifestWriter writer;
+    writer.Write(static_cast<uint32_t>(sizeof(VkLayerProperties)));
+    writer.Write(static_cast<uint32_t>(sizeof(VkExtensionProperties)));
+    writer.Write(static_cast<uint32_t>(manifest.size()));
+    for (const auto& path : manifest) {
+        writer.WriteString(path.path);
+        writer.Write(path.stamp);
+        writer.Write(static_cast<uint32_t>(path.libraries.size()));
+        for (const auto& library : path.libraries) {
+            uint32_t num_layers = 0;
+            for (const auto& layer : g_instance_layers) {
+                if (layer.library_idx == library.library_idx)
+                    num_layers++;
+            }
+
+            writer.WriteString(library.filename);
+            writer.Write(library.stamp);
+            writer.Write(num_layers);
+            if (num_layers == 0)
+                continue;
+            for (const auto& layer : g_instance_layers) {
+                if (layer.library_idx != library.library_idx)
+                    continue;
+                writer.Write(layer.properties);
+                writer.Write(static_cast<uint32_t>(layer.is_global));
+                writer.WriteExtensions(layer.instance_extensions);
+                writer.WriteExtensions(layer.device_extensions);
+            }
+        }
+    }
+
+    const std::string& payload = writer.GetData();
+    const uint32_t header[3] = {
+        kLayerManifestMagic,
+        kLayerManifestVersion,
+        static_cast<uint32_t>(
+            crc32(crc32(0L, Z_NULL, 0),
+                  reinterpret_cast<const Bytef*>(payload.data()),
+                  static_cast<uInt>(payload.size()))),
+    };
+    std::string data(reinterpret_cast<const char*>(header),
+                     kLayerManifestHeaderSize);
+    data.append(payload);
+
+    // Write to a temporary file and rename it, so that other processes of
+    // the app never read a partially written manifest.
+    std::string temp_filename = filename + "." + std::to_string(getpid());
+    if (!android::base::WriteStringToFile(data, temp_filename)) {
+        ALOGW("failed to write layer manifest '%s': %s",
+              temp_filename.c_str(), strerror(errno));
+        unlink(temp_filename.c_str());
+        return;
+    }
+    if (rename(temp_filename.c_str(), filename.c_str()) != 0) {
+        ALOGW("failed to rename layer manifest '%s': %s",
+              temp_filename.c_str(), strerror(errno));
+        unlink(temp_filename.c_str());
+    }
+}
+
 const VkExtensionProperties* FindExtension(
     const std::vector<VkExtensionProperties>& extensions,
     const char* name) {
@@ -479,11 +842,30 @@ void* GetLayerGetProcAddr(const Layer& layer,
 void DiscoverLayers() {
     ATRACE_CALL();
 
+    std::vector<std::string> paths;
     if (android::GraphicsEnv::getInstance().isDebuggable()) {
-        DiscoverLayersInPathList(kSystemLayerLibraryDir);
+        paths.push_back(kSystemLayerLibraryDir);
+    }
+    const std::string& layer_paths =
+        android::GraphicsEnv::getInstance().getLayerPaths();
+    if (!layer_paths.empty()) {
+        std::vector<std::string> app_paths =
+            android::base::Split(layer_paths, ":");
+        paths.insert(paths.end(), app_paths.begin(), app_paths.end());
     }
-    if (!android::GraphicsEnv::getInstance().getLayerPaths().empty())
-        DiscoverLayersInPathList(android::GraphicsEnv::getInstance().getLayerPaths());
+    if (paths.empty())
+        return;
+
+    const std::string& manifest_filename =
+        android::GraphicsEnv::getInstance().getLayerManifestPath();
+    if (!manifest_filename.empty() &&
+        LoadLayerManifest(manifest_filename, paths))
+        return;
+
+    std::vector<ManifestPath> manifest;
+    DiscoverLayersInPaths(paths, manifest);
+    if (!manifest_filename.empty())
+        SaveLayerManifest(manifest_filename, manifest);
 }
 
 uint32_t GetLayerCount() {
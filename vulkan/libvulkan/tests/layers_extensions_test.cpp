@@ -0,0 +1,289 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The layer manifest is internal to layers_extensions.cpp, so the tests are
+// built into the same translation unit.
+#include "../layers_extensions.cpp"
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include <functional>
+
+namespace vulkan {
+namespace api {
+namespace {
+
+constexpr char kLibraryFilename[] = "libVkLayer_test.so";
+
+class LayerManifestTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        layer_dir_ = std::string(temp_dir_.path) + "/layers";
+        other_dir_ = std::string(temp_dir_.path) + "/other";
+        ASSERT_EQ(0, mkdir(layer_dir_.c_str(), S_IRWXU));
+        ASSERT_EQ(0, mkdir(other_dir_.c_str(), S_IRWXU));
+        ASSERT_TRUE(android::base::WriteStringToFile(
+            "v1", layer_dir_ + "/" + kLibraryFilename));
+        manifest_filename_ = std::string(temp_dir_.path) + "/layers.manifest";
+        ResetLayers();
+    }
+
+    void TearDown() override { ResetLayers(); }
+
+    static void ResetLayers() {
+        g_instance_layers.clear();
+        g_layer_libraries.clear();
+    }
+
+    // Records one library with one global layer in layer_dir_, as
+    // DiscoverLayersInPaths would for a real layer library.
+    std::vector<ManifestPath> AddTestLayer() {
+        const std::string library_path = layer_dir_ + "/" + kLibraryFilename;
+        const size_t library_idx = g_layer_libraries.size();
+
+        Layer layer = {};
+        snprintf(layer.properties.layerName,
+                 sizeof(layer.properties.layerName), "VK_LAYER_test");
+        snprintf(layer.properties.description,
+                 sizeof(layer.properties.description), "test layer");
+        layer.properties.specVersion = VK_API_VERSION_1_1;
+        layer.properties.implementationVersion = 7;
+        layer.library_idx = library_idx;
+        layer.is_global = true;
+
+        VkExtensionProperties extension = {};
+        snprintf(extension.extensionName, sizeof(extension.extensionName),
+                 "VK_EXT_test_instance");
+        extension.specVersion = 2;
+        layer.instance_extensions.push_back(extension);
+        snprintf(extension.extensionName, sizeof(extension.extensionName),
+                 "VK_EXT_test_device");
+        extension.specVersion = 3;
+        layer.device_extensions.push_back(extension);
+
+        g_instance_layers.push_back(std::move(layer));
+        g_layer_libraries.emplace_back(library_path, kLibraryFilename);
+
+        ManifestPath path = {layer_dir_, GetPathStamp(layer_dir_), {}};
+        path.libraries.push_back(
+            {kLibraryFilename, GetFileStamp(library_path), library_idx});
+        return {path};
+    }
+
+    // Saves the manifest of AddTestLayer, then forgets the layers again.
+    void SaveTestManifest() {
+        SaveLayerManifest(manifest_filename_, AddTestLayer());
+        ResetLayers();
+    }
+
+    // Writes a manifest with a valid header for the given payload, so that
+    // the payload itself gets parsed.
+    void WriteManifestPayload(const std::string& payload) {
+        const uint32_t header[3] = {
+            kLayerManifestMagic,
+            kLayerManifestVersion,
+            static_cast<uint32_t>(
+                crc32(crc32(0L, Z_NULL, 0),
+                      reinterpret_cast<const Bytef*>(payload.data()),
+                      static_cast<uInt>(payload.size()))),
+        };
+        std::string data(reinterpret_cast<const char*>(header),
+                         kLayerManifestHeaderSize);
+        data.append(payload);
+        ASSERT_TRUE(
+            android::base::WriteStringToFile(data, manifest_filename_));
+    }
+
+    std::string ReadManifest() {
+        std::string data;
+        EXPECT_TRUE(
+            android::base::ReadFileToString(manifest_filename_, &data));
+        return data;
+    }
+
+    bool Load() { return LoadLayerManifest(manifest_filename_, {layer_dir_}); }
+
+    TemporaryDir temp_dir_;
+    std::string layer_dir_;
+    std::string other_dir_;
+    std::string manifest_filename_;
+};
+
+TEST_F(LayerManifestTest, RoundTrip) {
+    AddTestLayer();
+    const Layer expected = g_instance_layers[0];
+    SaveTestManifest();
+
+    ASSERT_TRUE(Load());
+    ASSERT_EQ(1u, g_layer_libraries.size());
+    EXPECT_EQ(kLibraryFilename, g_layer_libraries[0].GetFilename());
+    ASSERT_EQ(1u, g_instance_layers.size());
+
+    const Layer& layer = g_instance_layers[0];
+    EXPECT_EQ(0, memcmp(&expected.properties, &layer.properties,
+                        sizeof(VkLayerProperties)));
+    EXPECT_EQ(0u, layer.library_idx);
+    EXPECT_TRUE(layer.is_global);
+    ASSERT_EQ(1u, layer.instance_extensions.size());
+    EXPECT_STREQ("VK_EXT_test_instance",
+                 layer.instance_extensions[0].extensionName);
+    EXPECT_EQ(2u, layer.instance_extensions[0].specVersion);
+    ASSERT_EQ(1u, layer.device_extensions.size());
+    EXPECT_STREQ("VK_EXT_test_device",
+                 layer.device_extensions[0].extensionName);
+    EXPECT_EQ(3u, layer.device_extensions[0].specVersion);
+}
+
+TEST_F(LayerManifestTest, RoundTripAppendsToDiscoveredLayers) {
+    SaveTestManifest();
+    AddTestLayer();
+
+    ASSERT_TRUE(Load());
+    ASSERT_EQ(2u, g_layer_libraries.size());
+    ASSERT_EQ(2u, g_instance_layers.size());
+    EXPECT_EQ(1u, g_instance_layers[1].library_idx);
+}
+
+TEST_F(LayerManifestTest, MissingManifestIsNotLoaded) {
+    EXPECT_FALSE(Load());
+    EXPECT_TRUE(g_instance_layers.empty());
+}
+
+TEST_F(LayerManifestTest, StaleWhenPathsChange) {
+    SaveTestManifest();
+
+    EXPECT_FALSE(LoadLayerManifest(manifest_filename_, {other_dir_}));
+    EXPECT_FALSE(
+        LoadLayerManifest(manifest_filename_, {layer_dir_, other_dir_}));
+    EXPECT_FALSE(
+        LoadLayerManifest(manifest_filename_, {other_dir_, layer_dir_}));
+    EXPECT_FALSE(LoadLayerManifest(manifest_filename_, {}));
+    EXPECT_TRUE(g_instance_layers.empty());
+    EXPECT_TRUE(g_layer_libraries.empty());
+
+    EXPECT_TRUE(Load());
+}
+
+TEST_F(LayerManifestTest, StaleWhenLibraryChanges) {
+    SaveTestManifest();
+    ASSERT_TRUE(android::base::WriteStringToFile(
+        "v2 with a different size", layer_dir_ + "/" + kLibraryFilename));
+
+    EXPECT_FALSE(Load());
+    EXPECT_TRUE(g_instance_layers.empty());
+    EXPECT_TRUE(g_layer_libraries.empty());
+}
+
+TEST_F(LayerManifestTest, StaleWhenLibraryIsRemoved) {
+    SaveTestManifest();
+    ASSERT_EQ(0, unlink((layer_dir_ + "/" + kLibraryFilename).c_str()));
+
+    EXPECT_FALSE(Load());
+    EXPECT_TRUE(g_instance_layers.empty());
+}
+
+TEST_F(LayerManifestTest, RejectsTruncatedManifest) {
+    SaveTestManifest();
+    const std::string data = ReadManifest();
+
+    for (size_t size = 0; size < data.size(); size++) {
+        SCOPED_TRACE(size);
+        ASSERT_TRUE(android::base::WriteStringToFile(data.substr(0, size),
+                                                     manifest_filename_));
+        EXPECT_FALSE(Load());
+        EXPECT_TRUE(g_instance_layers.empty());
+        EXPECT_TRUE(g_layer_libraries.empty());
+    }
+}
+
+TEST_F(LayerManifestTest, RejectsTruncatedPayload) {
+    SaveTestManifest();
+    const std::string payload =
+        ReadManifest().substr(kLayerManifestHeaderSize);
+
+    for (size_t size = 0; size < payload.size(); size++) {
+        SCOPED_TRACE(size);
+        WriteManifestPayload(payload.substr(0, size));
+        EXPECT_FALSE(Load());
+        EXPECT_TRUE(g_instance_layers.empty());
+        EXPECT_TRUE(g_layer_libraries.empty());
+    }
+}
+
+TEST_F(LayerManifestTest, RejectsTrailingData) {
+    SaveTestManifest();
+    WriteManifestPayload(ReadManifest().substr(kLayerManifestHeaderSize) +
+                         "x");
+
+    EXPECT_FALSE(Load());
+    EXPECT_TRUE(g_instance_layers.empty());
+}
+
+TEST_F(LayerManifestTest, RejectsCorruptManifest) {
+    SaveTestManifest();
+    const std::string data = ReadManifest();
+
+    for (size_t i = 0; i < data.size(); i++) {
+        SCOPED_TRACE(i);
+        std::string corrupt = data;
+        corrupt[i] ^= 0x5a;
+        ASSERT_TRUE(
+            android::base::WriteStringToFile(corrupt, manifest_filename_));
+        EXPECT_FALSE(Load());
+        EXPECT_TRUE(g_instance_layers.empty());
+        EXPECT_TRUE(g_layer_libraries.empty());
+    }
+}
+
+TEST_F(LayerManifestTest, RejectsStringsWithoutNul) {
+    auto fill = [](char* str, size_t size) { memset(str, 'x', size); };
+    const std::vector<std::function<void(Layer&)>> corruptions = {
+        [&](Layer& layer) {
+            fill(layer.properties.layerName,
+                 sizeof(layer.properties.layerName));
+        },
+        [&](Layer& layer) {
+            fill(layer.properties.description,
+                 sizeof(layer.properties.description));
+        },
+        [&](Layer& layer) {
+            fill(layer.instance_extensions[0].extensionName,
+                 sizeof(layer.instance_extensions[0].extensionName));
+        },
+        [&](Layer& layer) {
+            fill(layer.device_extensions[0].extensionName,
+                 sizeof(layer.device_extensions[0].extensionName));
+        },
+    };
+
+    for (size_t i = 0; i < corruptions.size(); i++) {
+        SCOPED_TRACE(i);
+        std::vector<ManifestPath> manifest = AddTestLayer();
+        corruptions[i](g_instance_layers[0]);
+        SaveLayerManifest(manifest_filename_, manifest);
+        ResetLayers();
+
+        EXPECT_FALSE(Load());
+        EXPECT_TRUE(g_instance_layers.empty());
+        EXPECT_TRUE(g_layer_libraries.empty());
+    }
+}
+
+}  // namespace
+}  // namespace api
+}  // namespace vulkan
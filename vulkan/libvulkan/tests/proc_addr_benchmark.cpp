@@ -0,0 +1,421 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures how long it takes to resolve entry points through libvulkan's
+// vkGetInstanceProcAddr and vkGetDeviceProcAddr, the way an engine or a loader
+// like volk does at startup. Unlike vulkan_nulldrv_benchmark, this runs the
+// loader's own lookups, on top of whichever driver the device has:
+// - vkGetInstanceProcAddr looks the name up in the hooks of api_gen.cpp, and
+//   resolves names without a hook through GetProcHook() of driver_gen.cpp,
+//   then the driver.
+// - vkGetDeviceProcAddr looks the name up in the known_non_device_names of
+//   api_gen.cpp, then in GetProcHook() of driver_gen.cpp, then the driver.
+
+#include <benchmark/benchmark.h>
+#include <vulkan/vulkan.h>
+
+#include <iterator>
+
+namespace {
+
+// Every device-level command libvulkan has a hook for, followed by a few it
+// does not know, which an engine asks for anyway.
+const char* const kDeviceEntryPoints[] = {
+    // clang-format off
+    "vkAcquireNextImage2KHR",
+    "vkAcquireNextImageKHR",
+    "vkAllocateCommandBuffers",
+    "vkAllocateDescriptorSets",
+    "vkAllocateMemory",
+    "vkBeginCommandBuffer",
+    "vkBindBufferMemory",
+    "vkBindBufferMemory2",
+    "vkBindImageMemory",
+    "vkBindImageMemory2",
+    "vkCmdBeginQuery",
+    "vkCmdBeginRenderPass",
+    "vkCmdBeginRenderPass2",
+    "vkCmdBeginRendering",
+    "vkCmdBindDescriptorSets",
+    "vkCmdBindIndexBuffer",
+    "vkCmdBindPipeline",
+    "vkCmdBindVertexBuffers",
+    "vkCmdBindVertexBuffers2",
+    "vkCmdBlitImage",
+    "vkCmdBlitImage2",
+    "vkCmdClearAttachments",
+    "vkCmdClearColorImage",
+    "vkCmdClearDepthStencilImage",
+    "vkCmdCopyBuffer",
+    "vkCmdCopyBuffer2",
+    "vkCmdCopyBufferToImage",
+    "vkCmdCopyBufferToImage2",
+    "vkCmdCopyImage",
+    "vkCmdCopyImage2",
+    "vkCmdCopyImageToBuffer",
+    "vkCmdCopyImageToBuffer2",
+    "vkCmdCopyQueryPoolResults",
+    "vkCmdDispatch",
+    "vkCmdDispatchBase",
+    "vkCmdDispatchIndirect",
+    "vkCmdDraw",
+    "vkCmdDrawIndexed",
+    "vkCmdDrawIndexedIndirect",
+    "vkCmdDrawIndexedIndirectCount",
+    "vkCmdDrawIndirect",
+    "vkCmdDrawIndirectCount",
+    "vkCmdEndQuery",
+    "vkCmdEndRenderPass",
+    "vkCmdEndRenderPass2",
+    "vkCmdEndRendering",
+    "vkCmdExecuteCommands",
+    "vkCmdFillBuffer",
+    "vkCmdNextSubpass",
+    "vkCmdNextSubpass2",
+    "vkCmdPipelineBarrier",
+    "vkCmdPipelineBarrier2",
+    "vkCmdPushConstants",
+    "vkCmdResetEvent",
+    "vkCmdResetEvent2",
+    "vkCmdResetQueryPool",
+    "vkCmdResolveImage",
+    "vkCmdResolveImage2",
+    "vkCmdSetBlendConstants",
+    "vkCmdSetCullMode",
+    "vkCmdSetDepthBias",
+    "vkCmdSetDepthBiasEnable",
+    "vkCmdSetDepthBounds",
+    "vkCmdSetDepthBoundsTestEnable",
+    "vkCmdSetDepthCompareOp",
+    "vkCmdSetDepthTestEnable",
+    "vkCmdSetDepthWriteEnable",
+    "vkCmdSetDeviceMask",
+    "vkCmdSetEvent",
+    "vkCmdSetEvent2",
+    "vkCmdSetFrontFace",
+    "vkCmdSetLineWidth",
+    "vkCmdSetPrimitiveRestartEnable",
+    "vkCmdSetPrimitiveTopology",
+    "vkCmdSetRasterizerDiscardEnable",
+    "vkCmdSetScissor",
+    "vkCmdSetScissorWithCount",
+    "vkCmdSetStencilCompareMask",
+    "vkCmdSetStencilOp",
+    "vkCmdSetStencilReference",
+    "vkCmdSetStencilTestEnable",
+    "vkCmdSetStencilWriteMask",
+    "vkCmdSetViewport",
+    "vkCmdSetViewportWithCount",
+    "vkCmdUpdateBuffer",
+    "vkCmdWaitEvents",
+    "vkCmdWaitEvents2",
+    "vkCmdWriteTimestamp",
+    "vkCmdWriteTimestamp2",
+    "vkCreateBuffer",
+    "vkCreateBufferView",
+    "vkCreateCommandPool",
+    "vkCreateComputePipelines",
+    "vkCreateDescriptorPool",
+    "vkCreateDescriptorSetLayout",
+    "vkCreateDescriptorUpdateTemplate",
+    "vkCreateEvent",
+    "vkCreateFence",
+    "vkCreateFramebuffer",
+    "vkCreateGraphicsPipelines",
+    "vkCreateImage",
+    "vkCreateImageView",
+    "vkCreatePipelineCache",
+    "vkCreatePipelineLayout",
+    "vkCreatePrivateDataSlot",
+    "vkCreateQueryPool",
+    "vkCreateRenderPass",
+    "vkCreateRenderPass2",
+    "vkCreateSampler",
+    "vkCreateSamplerYcbcrConversion",
+    "vkCreateSemaphore",
+    "vkCreateShaderModule",
+    "vkCreateSwapchainKHR",
+    "vkDestroyBuffer",
+    "vkDestroyBufferView",
+    "vkDestroyCommandPool",
+    "vkDestroyDescriptorPool",
+    "vkDestroyDescriptorSetLayout",
+    "vkDestroyDescriptorUpdateTemplate",
+    "vkDestroyDevice",
+    "vkDestroyEvent",
+    "vkDestroyFence",
+    "vkDestroyFramebuffer",
+    "vkDestroyImage",
+    "vkDestroyImageView",
+    "vkDestroyPipeline",
+    "vkDestroyPipelineCache",
+    "vkDestroyPipelineLayout",
+    "vkDestroyPrivateDataSlot",
+    "vkDestroyQueryPool",
+    "vkDestroyRenderPass",
+    "vkDestroySampler",
+    "vkDestroySamplerYcbcrConversion",
+    "vkDestroySemaphore",
+    "vkDestroyShaderModule",
+    "vkDestroySwapchainKHR",
+    "vkDeviceWaitIdle",
+    "vkEndCommandBuffer",
+    "vkFlushMappedMemoryRanges",
+    "vkFreeCommandBuffers",
+    "vkFreeDescriptorSets",
+    "vkFreeMemory",
+    "vkGetAndroidHardwareBufferPropertiesANDROID",
+    "vkGetBufferDeviceAddress",
+    "vkGetBufferMemoryRequirements",
+    "vkGetBufferMemoryRequirements2",
+    "vkGetBufferOpaqueCaptureAddress",
+    "vkGetDescriptorSetLayoutSupport",
+    "vkGetDeviceBufferMemoryRequirements",
+    "vkGetDeviceGroupPeerMemoryFeatures",
+    "vkGetDeviceGroupPresentCapabilitiesKHR",
+    "vkGetDeviceGroupSurfacePresentModesKHR",
+    "vkGetDeviceImageMemoryRequirements",
+    "vkGetDeviceImageSparseMemoryRequirements",
+    "vkGetDeviceMemoryCommitment",
+    "vkGetDeviceMemoryOpaqueCaptureAddress",
+    "vkGetDeviceProcAddr",
+    "vkGetDeviceQueue",
+    "vkGetDeviceQueue2",
+    "vkGetEventStatus",
+    "vkGetFenceStatus",
+    "vkGetImageMemoryRequirements",
+    "vkGetImageMemoryRequirements2",
+    "vkGetImageSparseMemoryRequirements",
+    "vkGetImageSparseMemoryRequirements2",
+    "vkGetImageSubresourceLayout",
+    "vkGetMemoryAndroidHardwareBufferANDROID",
+    "vkGetPipelineCacheData",
+    "vkGetPrivateData",
+    "vkGetQueryPoolResults",
+    "vkGetRenderAreaGranularity",
+    "vkGetSemaphoreCounterValue",
+    "vkGetSwapchainImagesKHR",
+    "vkInvalidateMappedMemoryRanges",
+    "vkMapMemory",
+    "vkMergePipelineCaches",
+    "vkQueueBindSparse",
+    "vkQueuePresentKHR",
+    "vkQueueSubmit",
+    "vkQueueSubmit2",
+    "vkQueueWaitIdle",
+    "vkResetCommandBuffer",
+    "vkResetCommandPool",
+    "vkResetDescriptorPool",
+    "vkResetEvent",
+    "vkResetFences",
+    "vkResetQueryPool",
+    "vkSetEvent",
+    "vkSetPrivateData",
+    "vkSignalSemaphore",
+    "vkTrimCommandPool",
+    "vkUnmapMemory",
+    "vkUpdateDescriptorSetWithTemplate",
+    "vkUpdateDescriptorSets",
+    "vkWaitForFences",
+    "vkWaitSemaphores",
+    "vkCmdDrawMeshTasksEXT",
+    "vkCreateRayTracingPipelinesKHR",
+    "vkNotAnEntryPoint",
+    // clang-format on
+};
+
+// The instance-level commands that libvulkan resolves for an instance. The
+// global commands are left out, since resolving them with an instance is an
+// error that gets logged.
+const char* const kInstanceEntryPoints[] = {
+    // clang-format off
+    "vkAcquireDrmDisplayEXT",
+    "vkCreateAndroidSurfaceKHR",
+    "vkCreateDebugReportCallbackEXT",
+    "vkCreateDebugUtilsMessengerEXT",
+    "vkCreateDevice",
+    "vkDebugReportMessageEXT",
+    "vkDestroyDebugReportCallbackEXT",
+    "vkDestroyDebugUtilsMessengerEXT",
+    "vkDestroyInstance",
+    "vkDestroySurfaceKHR",
+    "vkEnumerateDeviceExtensionProperties",
+    "vkEnumerateDeviceLayerProperties",
+    "vkEnumeratePhysicalDeviceGroups",
+    "vkEnumeratePhysicalDeviceGroupsKHR",
+    "vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR",
+    "vkEnumeratePhysicalDevices",
+    "vkGetDisplayModeProperties2KHR",
+    "vkGetDisplayPlaneCapabilities2KHR",
+    "vkGetDrmDisplayEXT",
+    "vkGetInstanceProcAddr",
+    "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT",
+    "vkGetPhysicalDeviceDisplayPlaneProperties2KHR",
+    "vkGetPhysicalDeviceDisplayProperties2KHR",
+    "vkGetPhysicalDeviceExternalBufferProperties",
+    "vkGetPhysicalDeviceExternalBufferPropertiesKHR",
+    "vkGetPhysicalDeviceExternalFenceProperties",
+    "vkGetPhysicalDeviceExternalFencePropertiesKHR",
+    "vkGetPhysicalDeviceExternalImageFormatPropertiesNV",
+    "vkGetPhysicalDeviceExternalSemaphoreProperties",
+    "vkGetPhysicalDeviceExternalSemaphorePropertiesKHR",
+    "vkGetPhysicalDeviceFeatures",
+    "vkGetPhysicalDeviceFeatures2",
+    "vkGetPhysicalDeviceFeatures2KHR",
+    "vkGetPhysicalDeviceFormatProperties",
+    "vkGetPhysicalDeviceFormatProperties2",
+    "vkGetPhysicalDeviceFormatProperties2KHR",
+    "vkGetPhysicalDeviceFragmentShadingRatesKHR",
+    "vkGetPhysicalDeviceImageFormatProperties",
+    "vkGetPhysicalDeviceImageFormatProperties2",
+    "vkGetPhysicalDeviceImageFormatProperties2KHR",
+    "vkGetPhysicalDeviceMemoryProperties",
+    "vkGetPhysicalDeviceMemoryProperties2",
+    "vkGetPhysicalDeviceMemoryProperties2KHR",
+    "vkGetPhysicalDeviceMultisamplePropertiesEXT",
+    "vkGetPhysicalDeviceOpticalFlowImageFormatsNV",
+    "vkGetPhysicalDevicePresentRectanglesKHR",
+    "vkGetPhysicalDeviceProperties",
+    "vkGetPhysicalDeviceProperties2",
+    "vkGetPhysicalDeviceProperties2KHR",
+    "vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR",
+    "vkGetPhysicalDeviceQueueFamilyProperties",
+    "vkGetPhysicalDeviceQueueFamilyProperties2",
+    "vkGetPhysicalDeviceQueueFamilyProperties2KHR",
+    "vkGetPhysicalDeviceSparseImageFormatProperties",
+    "vkGetPhysicalDeviceSparseImageFormatProperties2",
+    "vkGetPhysicalDeviceSparseImageFormatProperties2KHR",
+    "vkGetPhysicalDeviceSurfaceCapabilities2KHR",
+    "vkGetPhysicalDeviceSurfaceCapabilitiesKHR",
+    "vkGetPhysicalDeviceSurfaceFormats2KHR",
+    "vkGetPhysicalDeviceSurfaceFormatsKHR",
+    "vkGetPhysicalDeviceSurfacePresentModesKHR",
+    "vkGetPhysicalDeviceSurfaceSupportKHR",
+    "vkGetPhysicalDeviceToolProperties",
+    "vkGetPhysicalDeviceToolPropertiesEXT",
+    "vkGetPhysicalDeviceVideoCapabilitiesKHR",
+    "vkGetPhysicalDeviceVideoFormatPropertiesKHR",
+    "vkSubmitDebugUtilsMessageEXT",
+    // clang-format on
+};
+
+struct Handles {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+};
+
+void DestroyHandles(const Handles& handles) {
+    if (handles.device != VK_NULL_HANDLE)
+        vkDestroyDevice(handles.device, nullptr);
+    if (handles.instance != VK_NULL_HANDLE)
+        vkDestroyInstance(handles.instance, nullptr);
+}
+
+// Creates an instance and a device through libvulkan. On failure the
+// benchmark is skipped with an error, and false is returned.
+bool CreateHandles(benchmark::State& state, Handles& handles) {
+    handles = {};
+    const VkApplicationInfo app_info = {
+        .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .apiVersion = VK_API_VERSION_1_1,
+    };
+    const VkInstanceCreateInfo instance_info = {
+        .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pApplicationInfo = &app_info,
+    };
+    VkResult result =
+        vkCreateInstance(&instance_info, nullptr, &handles.instance);
+    if (result != VK_SUCCESS) {
+        handles.instance = VK_NULL_HANDLE;
+        state.SkipWithError("vkCreateInstance failed");
+        return false;
+    }
+
+    uint32_t count = 1;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    result =
+        vkEnumeratePhysicalDevices(handles.instance, &count, &physical_device);
+    if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || count == 0) {
+        DestroyHandles(handles);
+        state.SkipWithError("vkEnumeratePhysicalDevices found no device");
+        return false;
+    }
+
+    const float priority = 1.0f;
+    const VkDeviceQueueCreateInfo queue_info = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .queueFamilyIndex = 0,
+        .queueCount = 1,
+        .pQueuePriorities = &priority,
+    };
+    const VkDeviceCreateInfo device_info = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .queueCreateInfoCount = 1,
+        .pQueueCreateInfos = &queue_info,
+    };
+    result = vkCreateDevice(physical_device, &device_info, nullptr,
+                            &handles.device);
+    if (result != VK_SUCCESS) {
+        handles.device = VK_NULL_HANDLE;
+        DestroyHandles(handles);
+        state.SkipWithError("vkCreateDevice failed");
+        return false;
+    }
+    return true;
+}
+
+// Covers the hooks of api_gen.cpp, and GetProcHook() of driver_gen.cpp for
+// the instance-level names that have no hook.
+void BM_LoaderGetInstanceProcAddr(benchmark::State& state) {
+    Handles handles;
+    if (!CreateHandles(state, handles))
+        return;
+    for (auto _ : state) {
+        for (const char* name : kInstanceEntryPoints) {
+            benchmark::DoNotOptimize(
+                vkGetInstanceProcAddr(handles.instance, name));
+        }
+        for (const char* name : kDeviceEntryPoints) {
+            benchmark::DoNotOptimize(
+                vkGetInstanceProcAddr(handles.instance, name));
+        }
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        (std::size(kInstanceEntryPoints) + std::size(kDeviceEntryPoints)));
+    DestroyHandles(handles);
+}
+BENCHMARK(BM_LoaderGetInstanceProcAddr);
+
+// Covers the known_non_device_names of api_gen.cpp, which every name misses,
+// then GetProcHook() of driver_gen.cpp and the driver's vkGetDeviceProcAddr.
+void BM_LoaderGetDeviceProcAddr(benchmark::State& state) {
+    Handles handles;
+    if (!CreateHandles(state, handles))
+        return;
+    for (auto _ : state) {
+        for (const char* name : kDeviceEntryPoints) {
+            benchmark::DoNotOptimize(vkGetDeviceProcAddr(handles.device, name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(kDeviceEntryPoints));
+    DestroyHandles(handles);
+}
+BENCHMARK(BM_LoaderGetDeviceProcAddr);
+
+}  // namespace
+
+BENCHMARK_MAIN();
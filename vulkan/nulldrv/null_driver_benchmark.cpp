@@ -0,0 +1,439 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures how long it takes to resolve every entry point of the null driver,
+// the way an engine or a loader like volk does at startup. The lookups go to
+// the null driver's HAL device directly, so they do not cover libvulkan; see
+// libvulkan_benchmark for that.
+
+#include <benchmark/benchmark.h>
+#include <hardware/hwvulkan.h>
+#include <vulkan/vulkan.h>
+
+#include <iterator>
+
+extern hwvulkan_module_t HAL_MODULE_INFO_SYM;
+
+namespace {
+
+// Every entry point the null driver implements, followed by a few it does
+// not, which an engine asks for anyway.
+const char* const kEntryPoints[] = {
+    // clang-format off
+    "vkAcquireImageANDROID",
+    "vkAllocateCommandBuffers",
+    "vkAllocateDescriptorSets",
+    "vkAllocateMemory",
+    "vkBeginCommandBuffer",
+    "vkBindBufferMemory",
+    "vkBindBufferMemory2",
+    "vkBindImageMemory",
+    "vkBindImageMemory2",
+    "vkCmdBeginQuery",
+    "vkCmdBeginRenderPass",
+    "vkCmdBeginRenderPass2",
+    "vkCmdBeginRendering",
+    "vkCmdBindDescriptorSets",
+    "vkCmdBindIndexBuffer",
+    "vkCmdBindPipeline",
+    "vkCmdBindVertexBuffers",
+    "vkCmdBindVertexBuffers2",
+    "vkCmdBlitImage",
+    "vkCmdBlitImage2",
+    "vkCmdClearAttachments",
+    "vkCmdClearColorImage",
+    "vkCmdClearDepthStencilImage",
+    "vkCmdCopyBuffer",
+    "vkCmdCopyBuffer2",
+    "vkCmdCopyBufferToImage",
+    "vkCmdCopyBufferToImage2",
+    "vkCmdCopyImage",
+    "vkCmdCopyImage2",
+    "vkCmdCopyImageToBuffer",
+    "vkCmdCopyImageToBuffer2",
+    "vkCmdCopyQueryPoolResults",
+    "vkCmdDispatch",
+    "vkCmdDispatchBase",
+    "vkCmdDispatchIndirect",
+    "vkCmdDraw",
+    "vkCmdDrawIndexed",
+    "vkCmdDrawIndexedIndirect",
+    "vkCmdDrawIndexedIndirectCount",
+    "vkCmdDrawIndirect",
+    "vkCmdDrawIndirectCount",
+    "vkCmdEndQuery",
+    "vkCmdEndRenderPass",
+    "vkCmdEndRenderPass2",
+    "vkCmdEndRendering",
+    "vkCmdExecuteCommands",
+    "vkCmdFillBuffer",
+    "vkCmdNextSubpass",
+    "vkCmdNextSubpass2",
+    "vkCmdPipelineBarrier",
+    "vkCmdPipelineBarrier2",
+    "vkCmdPushConstants",
+    "vkCmdResetEvent",
+    "vkCmdResetEvent2",
+    "vkCmdResetQueryPool",
+    "vkCmdResolveImage",
+    "vkCmdResolveImage2",
+    "vkCmdSetBlendConstants",
+    "vkCmdSetCullMode",
+    "vkCmdSetDepthBias",
+    "vkCmdSetDepthBiasEnable",
+    "vkCmdSetDepthBounds",
+    "vkCmdSetDepthBoundsTestEnable",
+    "vkCmdSetDepthCompareOp",
+    "vkCmdSetDepthTestEnable",
+    "vkCmdSetDepthWriteEnable",
+    "vkCmdSetDeviceMask",
+    "vkCmdSetEvent",
+    "vkCmdSetEvent2",
+    "vkCmdSetFrontFace",
+    "vkCmdSetLineWidth",
+    "vkCmdSetPrimitiveRestartEnable",
+    "vkCmdSetPrimitiveTopology",
+    "vkCmdSetRasterizerDiscardEnable",
+    "vkCmdSetScissor",
+    "vkCmdSetScissorWithCount",
+    "vkCmdSetStencilCompareMask",
+    "vkCmdSetStencilOp",
+    "vkCmdSetStencilReference",
+    "vkCmdSetStencilTestEnable",
+    "vkCmdSetStencilWriteMask",
+    "vkCmdSetViewport",
+    "vkCmdSetViewportWithCount",
+    "vkCmdUpdateBuffer",
+    "vkCmdWaitEvents",
+    "vkCmdWaitEvents2",
+    "vkCmdWriteTimestamp",
+    "vkCmdWriteTimestamp2",
+    "vkCreateBuffer",
+    "vkCreateBufferView",
+    "vkCreateCommandPool",
+    "vkCreateComputePipelines",
+    "vkCreateDebugReportCallbackEXT",
+    "vkCreateDescriptorPool",
+    "vkCreateDescriptorSetLayout",
+    "vkCreateDescriptorUpdateTemplate",
+    "vkCreateDevice",
+    "vkCreateEvent",
+    "vkCreateFence",
+    "vkCreateFramebuffer",
+    "vkCreateGraphicsPipelines",
+    "vkCreateImage",
+    "vkCreateImageView",
+    "vkCreateInstance",
+    "vkCreatePipelineCache",
+    "vkCreatePipelineLayout",
+    "vkCreatePrivateDataSlot",
+    "vkCreateQueryPool",
+    "vkCreateRenderPass",
+    "vkCreateRenderPass2",
+    "vkCreateSampler",
+    "vkCreateSamplerYcbcrConversion",
+    "vkCreateSemaphore",
+    "vkCreateShaderModule",
+    "vkDebugReportMessageEXT",
+    "vkDestroyBuffer",
+    "vkDestroyBufferView",
+    "vkDestroyCommandPool",
+    "vkDestroyDebugReportCallbackEXT",
+    "vkDestroyDescriptorPool",
+    "vkDestroyDescriptorSetLayout",
+    "vkDestroyDescriptorUpdateTemplate",
+    "vkDestroyDevice",
+    "vkDestroyEvent",
+    "vkDestroyFence",
+    "vkDestroyFramebuffer",
+    "vkDestroyImage",
+    "vkDestroyImageView",
+    "vkDestroyInstance",
+    "vkDestroyPipeline",
+    "vkDestroyPipelineCache",
+    "vkDestroyPipelineLayout",
+    "vkDestroyPrivateDataSlot",
+    "vkDestroyQueryPool",
+    "vkDestroyRenderPass",
+    "vkDestroySampler",
+    "vkDestroySamplerYcbcrConversion",
+    "vkDestroySemaphore",
+    "vkDestroyShaderModule",
+    "vkDeviceWaitIdle",
+    "vkEndCommandBuffer",
+    "vkEnumerateDeviceExtensionProperties",
+    "vkEnumerateDeviceLayerProperties",
+    "vkEnumerateInstanceExtensionProperties",
+    "vkEnumerateInstanceLayerProperties",
+    "vkEnumerateInstanceVersion",
+    "vkEnumeratePhysicalDeviceGroups",
+    "vkEnumeratePhysicalDevices",
+    "vkFlushMappedMemoryRanges",
+    "vkFreeCommandBuffers",
+    "vkFreeDescriptorSets",
+    "vkFreeMemory",
+    "vkGetBufferDeviceAddress",
+    "vkGetBufferMemoryRequirements",
+    "vkGetBufferMemoryRequirements2",
+    "vkGetBufferOpaqueCaptureAddress",
+    "vkGetDescriptorSetLayoutSupport",
+    "vkGetDeviceBufferMemoryRequirements",
+    "vkGetDeviceGroupPeerMemoryFeatures",
+    "vkGetDeviceImageMemoryRequirements",
+    "vkGetDeviceImageSparseMemoryRequirements",
+    "vkGetDeviceMemoryCommitment",
+    "vkGetDeviceMemoryOpaqueCaptureAddress",
+    "vkGetDeviceProcAddr",
+    "vkGetDeviceQueue",
+    "vkGetDeviceQueue2",
+    "vkGetEventStatus",
+    "vkGetFenceStatus",
+    "vkGetImageMemoryRequirements",
+    "vkGetImageMemoryRequirements2",
+    "vkGetImageSparseMemoryRequirements",
+    "vkGetImageSparseMemoryRequirements2",
+    "vkGetImageSubresourceLayout",
+    "vkGetInstanceProcAddr",
+    "vkGetPhysicalDeviceExternalBufferProperties",
+    "vkGetPhysicalDeviceExternalFenceProperties",
+    "vkGetPhysicalDeviceExternalSemaphoreProperties",
+    "vkGetPhysicalDeviceFeatures",
+    "vkGetPhysicalDeviceFeatures2",
+    "vkGetPhysicalDeviceFeatures2KHR",
+    "vkGetPhysicalDeviceFormatProperties",
+    "vkGetPhysicalDeviceFormatProperties2",
+    "vkGetPhysicalDeviceFormatProperties2KHR",
+    "vkGetPhysicalDeviceImageFormatProperties",
+    "vkGetPhysicalDeviceImageFormatProperties2",
+    "vkGetPhysicalDeviceImageFormatProperties2KHR",
+    "vkGetPhysicalDeviceMemoryProperties",
+    "vkGetPhysicalDeviceMemoryProperties2",
+    "vkGetPhysicalDeviceMemoryProperties2KHR",
+    "vkGetPhysicalDeviceProperties",
+    "vkGetPhysicalDeviceProperties2",
+    "vkGetPhysicalDeviceProperties2KHR",
+    "vkGetPhysicalDeviceQueueFamilyProperties",
+    "vkGetPhysicalDeviceQueueFamilyProperties2",
+    "vkGetPhysicalDeviceQueueFamilyProperties2KHR",
+    "vkGetPhysicalDeviceSparseImageFormatProperties",
+    "vkGetPhysicalDeviceSparseImageFormatProperties2",
+    "vkGetPhysicalDeviceSparseImageFormatProperties2KHR",
+    "vkGetPhysicalDeviceToolProperties",
+    "vkGetPipelineCacheData",
+    "vkGetPrivateData",
+    "vkGetQueryPoolResults",
+    "vkGetRenderAreaGranularity",
+    "vkGetSemaphoreCounterValue",
+    "vkGetSwapchainGrallocUsage2ANDROID",
+    "vkGetSwapchainGrallocUsage3ANDROID",
+    "vkGetSwapchainGrallocUsage4ANDROID",
+    "vkGetSwapchainGrallocUsageANDROID",
+    "vkInvalidateMappedMemoryRanges",
+    "vkMapMemory",
+    "vkMergePipelineCaches",
+    "vkQueueBindSparse",
+    "vkQueueSignalReleaseImageANDROID",
+    "vkQueueSubmit",
+    "vkQueueSubmit2",
+    "vkQueueWaitIdle",
+    "vkResetCommandBuffer",
+    "vkResetCommandPool",
+    "vkResetDescriptorPool",
+    "vkResetEvent",
+    "vkResetFences",
+    "vkResetQueryPool",
+    "vkSetEvent",
+    "vkSetPrivateData",
+    "vkSignalSemaphore",
+    "vkTrimCommandPool",
+    "vkUnmapMemory",
+    "vkUpdateDescriptorSetWithTemplate",
+    "vkUpdateDescriptorSets",
+    "vkWaitForFences",
+    "vkWaitSemaphores",
+    "vkCreateAndroidSurfaceKHR",
+    "vkCreateSwapchainKHR",
+    "vkGetPhysicalDeviceSurfaceSupportKHR",
+    "vkCmdDrawMeshTasksEXT",
+    "vkCreateRayTracingPipelinesKHR",
+    "vkCreateXlibSurfaceKHR",
+    "vkNotAnEntryPoint",
+    // clang-format on
+};
+
+struct NullDriver {
+    NullDriver() {
+        hw_device_t* device = nullptr;
+        if (HAL_MODULE_INFO_SYM.common.methods->open(
+                &HAL_MODULE_INFO_SYM.common, HWVULKAN_DEVICE_0, &device) == 0)
+            hal = reinterpret_cast<hwvulkan_device_t*>(device);
+    }
+
+    // nullptr if the HAL device failed to open
+    hwvulkan_device_t* hal = nullptr;
+};
+
+const NullDriver& GetNullDriver() {
+    static const NullDriver driver;
+    return driver;
+}
+
+template <typename T>
+T GetProc(PFN_vkGetInstanceProcAddr get_proc,
+          VkInstance instance,
+          const char* name) {
+    return reinterpret_cast<T>(get_proc(instance, name));
+}
+
+struct Handles {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    PFN_vkGetInstanceProcAddr get_instance_proc = nullptr;
+    PFN_vkGetDeviceProcAddr get_device_proc = nullptr;
+};
+
+void DestroyHandles(const Handles& handles) {
+    if (handles.device != VK_NULL_HANDLE) {
+        GetProc<PFN_vkDestroyDevice>(handles.get_instance_proc,
+                                     handles.instance,
+                                     "vkDestroyDevice")(handles.device,
+                                                        nullptr);
+    }
+    if (handles.instance != VK_NULL_HANDLE) {
+        GetProc<PFN_vkDestroyInstance>(handles.get_instance_proc,
+                                       handles.instance, "vkDestroyInstance")(
+            handles.instance, nullptr);
+    }
+}
+
+// Creates an instance and a device of the null driver, resolving through the
+// HAL device directly. On failure the benchmark is skipped with an error, and
+// false is returned.
+bool CreateHandles(benchmark::State& state, Handles& handles) {
+    handles = {};
+    const hwvulkan_device_t* hal = GetNullDriver().hal;
+    if (!hal) {
+        state.SkipWithError("failed to open the null driver HAL device");
+        return false;
+    }
+    handles.get_instance_proc = hal->GetInstanceProcAddr;
+
+    const VkInstanceCreateInfo instance_info = {
+        .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+    };
+    VkResult result = GetProc<PFN_vkCreateInstance>(
+        handles.get_instance_proc, VK_NULL_HANDLE,
+        "vkCreateInstance")(&instance_info, nullptr, &handles.instance);
+    if (result != VK_SUCCESS) {
+        handles.instance = VK_NULL_HANDLE;
+        state.SkipWithError("vkCreateInstance failed");
+        return false;
+    }
+
+    uint32_t count = 1;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    result = GetProc<PFN_vkEnumeratePhysicalDevices>(
+        handles.get_instance_proc, handles.instance,
+        "vkEnumeratePhysicalDevices")(handles.instance, &count,
+                                      &physical_device);
+    if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || count == 0) {
+        DestroyHandles(handles);
+        state.SkipWithError("vkEnumeratePhysicalDevices found no device");
+        return false;
+    }
+
+    const float priority = 1.0f;
+    const VkDeviceQueueCreateInfo queue_info = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .queueCount = 1,
+        .pQueuePriorities = &priority,
+    };
+    const VkDeviceCreateInfo device_info = {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .queueCreateInfoCount = 1,
+        .pQueueCreateInfos = &queue_info,
+    };
+    result = GetProc<PFN_vkCreateDevice>(handles.get_instance_proc,
+                                         handles.instance, "vkCreateDevice")(
+        physical_device, &device_info, nullptr, &handles.device);
+    if (result != VK_SUCCESS) {
+        handles.device = VK_NULL_HANDLE;
+        DestroyHandles(handles);
+        state.SkipWithError("vkCreateDevice failed");
+        return false;
+    }
+
+    handles.get_device_proc = GetProc<PFN_vkGetDeviceProcAddr>(
+        handles.get_instance_proc, handles.instance, "vkGetDeviceProcAddr");
+    return true;
+}
+
+// Covers the null driver's own tables in null_driver_gen.cpp: the global and
+// instance proc tables behind its GetInstanceProcAddr.
+void BM_GetInstanceProcAddr(benchmark::State& state) {
+    Handles handles;
+    if (!CreateHandles(state, handles))
+        return;
+    for (auto _ : state) {
+        for (const char* name : kEntryPoints) {
+            benchmark::DoNotOptimize(
+                handles.get_instance_proc(handles.instance, name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(kEntryPoints));
+    DestroyHandles(handles);
+}
+BENCHMARK(BM_GetInstanceProcAddr);
+
+// Covers the null driver's GetDeviceProcAddr, which resolves through the same
+// instance proc table.
+void BM_GetDeviceProcAddr(benchmark::State& state) {
+    Handles handles;
+    if (!CreateHandles(state, handles))
+        return;
+    for (auto _ : state) {
+        for (const char* name : kEntryPoints) {
+            benchmark::DoNotOptimize(
+                handles.get_device_proc(handles.device, name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(kEntryPoints));
+    DestroyHandles(handles);
+}
+BENCHMARK(BM_GetDeviceProcAddr);
+
+// Creates an instance and a device, and resolves every entry point for both.
+void BM_Startup(benchmark::State& state) {
+    for (auto _ : state) {
+        Handles handles;
+        if (!CreateHandles(state, handles))
+            break;
+        for (const char* name : kEntryPoints) {
+            benchmark::DoNotOptimize(
+                handles.get_instance_proc(handles.instance, name));
+        }
+        for (const char* name : kEntryPoints) {
+            benchmark::DoNotOptimize(
+                handles.get_device_proc(handles.device, name));
+        }
+        DestroyHandles(handles);
+    }
+}
+BENCHMARK(BM_Startup);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -170,32 +170,41 @@ def _intercept_instance_proc_addr(f):
         PFN_vkVoidFunction proc;
     } hooks[] = {\n""")
 
-  sorted_command_list = sorted(gencom.command_list)
-  for cmd in sorted_command_list:
+  hook_list = []
+  for cmd in gencom.command_list:
     if gencom.is_function_exported(cmd):
-      if gencom.is_globally_dispatched(cmd):
-        f.write(gencom.indent(2) + '{ \"' + cmd + '\", nullptr },\n')
-      elif (_is_intercepted(cmd) or
-            cmd == 'vkGetInstanceProcAddr' or
-            gencom.is_device_dispatched(cmd)):
-        f.write(gencom.indent(2) + '{ \"' + cmd +
-                '\", reinterpret_cast<PFN_vkVoidFunction>(' +
-                gencom.base_name(cmd) + ') },\n')
+      if (gencom.is_globally_dispatched(cmd) or _is_intercepted(cmd) or
+          cmd == 'vkGetInstanceProcAddr' or
+          gencom.is_device_dispatched(cmd)):
+        hook_list.append(cmd)
+
+  hook_seeds, hook_list = gencom.perfect_hash(hook_list)
+  for cmd in hook_list:
+    if gencom.is_globally_dispatched(cmd):
+      f.write(gencom.indent(2) + '{ \"' + cmd + '\", nullptr },\n')
+    else:
+      f.write(gencom.indent(2) + '{ \"' + cmd +
+              '\", reinterpret_cast<PFN_vkVoidFunction>(' +
+              gencom.base_name(cmd) + ') },\n')
+
+  f.write("""\
+    };
+    static const uint32_t hook_seeds[] = {\n""")
+
+  gencom.write_proc_hash_seeds(hook_seeds, 2, f)
 
   f.write("""\
     };
     // clang-format on
     constexpr size_t count = sizeof(hooks) / sizeof(hooks[0]);
-    auto hook = std::lower_bound(
-        hooks, hooks + count, pName,
-        [](const Hook& h, const char* n) { return strcmp(h.name, n) < 0; });
-    if (hook < hooks + count && strcmp(hook->name, pName) == 0) {
-        if (!hook->proc) {
+    const Hook& hook = hooks[ProcHashSlot<count>(pName, hook_seeds)];
+    if (strcmp(hook.name, pName) == 0) {
+        if (!hook.proc) {
             vulkan::driver::Logger(instance).Err(
                 instance, "invalid vkGetInstanceProcAddr(%p, \\\"%s\\\") call",
                 instance, pName);
         }
-        return hook->proc;
+        return hook.proc;
     }
     // clang-format off\n\n""")
 
@@ -214,11 +223,21 @@ def _intercept_device_proc_addr(f):
 
     static const char* const known_non_device_names[] = {\n""")
 
-  sorted_command_list = sorted(gencom.command_list)
-  for cmd in sorted_command_list:
+  non_device_list = []
+  for cmd in gencom.command_list:
     if gencom.is_function_supported(cmd):
       if not gencom.is_device_dispatched(cmd):
-        f.write(gencom.indent(2) + '\"' + cmd + '\",\n')
+        non_device_list.append(cmd)
+
+  non_device_seeds, non_device_list = gencom.perfect_hash(non_device_list)
+  for cmd in non_device_list:
+    f.write(gencom.indent(2) + '\"' + cmd + '\",\n')
+
+  f.write("""\
+    };
+    static const uint32_t known_non_device_seeds[] = {\n""")
+
+  gencom.write_proc_hash_seeds(non_device_seeds, 2, f)
 
   f.write("""\
     };
@@ -226,9 +245,8 @@ def _intercept_device_proc_addr(f):
     constexpr size_t count =
         sizeof(known_non_device_names) / sizeof(known_non_device_names[0]);
     if (!pName ||
-        std::binary_search(
-            known_non_device_names, known_non_device_names + count, pName,
-            [](const char* a, const char* b) { return (strcmp(a, b) < 0); })) {
+        strcmp(pName, known_non_device_names[ProcHashSlot<count>(
+                          pName, known_non_device_seeds)]) == 0) {
         vulkan::driver::Logger(device).Err(
             device, "invalid vkGetDeviceProcAddr(%p, \\\"%s\\\") call", device,
             (pName) ? pName : "(null)");
@@ -277,8 +295,6 @@ def gen_cpp():
 #include <log/log.h>
 #include <string.h>
 
-#include <algorithm>
-
 // to catch mismatches between vulkan.h and this file
 #undef VK_NO_PROTOTYPES
 #include "api.h"
@@ -362,6 +378,11 @@ bool InitDispatchTable(
 
 namespace {
 
+""")
+
+    f.write(gencom.proc_hash_functions())
+
+    f.write("""
 // forward declarations needed by GetInstanceProcAddr and GetDeviceProcAddr
 """)
 
@@ -503,6 +503,11 @@ namespace driver {
 
 namespace {
 
+""")
+
+    f.write(gencom.proc_hash_functions())
+
+    f.write("""
 // clang-format off\n\n""")
 
     for cmd in gencom.command_list:
@@ -514,15 +519,24 @@ namespace {
 const ProcHook g_proc_hooks[] = {
     // clang-format off\n""")
 
-    sorted_command_list = sorted(gencom.command_list)
-    for cmd in sorted_command_list:
-      if _is_intercepted(cmd):
-        if gencom.is_globally_dispatched(cmd):
-          _define_global_proc_hook(cmd, f)
-        elif gencom.is_instance_dispatched(cmd):
-          _define_instance_proc_hook(cmd, f)
-        elif gencom.is_device_dispatched(cmd):
-          _define_device_proc_hook(cmd, f)
+    hook_list = [cmd for cmd in gencom.command_list if _is_intercepted(cmd)]
+    hook_seeds, hook_list = gencom.perfect_hash(hook_list)
+    for cmd in hook_list:
+      if gencom.is_globally_dispatched(cmd):
+        _define_global_proc_hook(cmd, f)
+      elif gencom.is_instance_dispatched(cmd):
+        _define_instance_proc_hook(cmd, f)
+      elif gencom.is_device_dispatched(cmd):
+        _define_device_proc_hook(cmd, f)
+
+    f.write("""\
+    // clang-format on
+};
+
+const uint32_t g_proc_hook_seeds[] = {
+    // clang-format off\n""")
+
+    gencom.write_proc_hash_seeds(hook_seeds, 1, f)
 
     f.write("""\
     // clang-format on
@@ -531,12 +545,10 @@ const ProcHook g_proc_hooks[] = {
 }  // namespace
 
 const ProcHook* GetProcHook(const char* name) {
-    auto begin = std::cbegin(g_proc_hooks);
-    auto end = std::cend(g_proc_hooks);
-    auto hook = std::lower_bound(
-        begin, end, name,
-        [](const ProcHook& e, const char* n) { return strcmp(e.name, n) < 0; });
-    return (hook < end && strcmp(hook->name, name) == 0) ? hook : nullptr;
+    constexpr size_t count = sizeof(g_proc_hooks) / sizeof(g_proc_hooks[0]);
+    const ProcHook& hook =
+        g_proc_hooks[ProcHashSlot<count>(name, g_proc_hook_seeds)];
+    return (strcmp(hook.name, name) == 0) ? &hook : nullptr;
 }
 
 ProcHook::Extension GetProcHookExtension(const char* name) {
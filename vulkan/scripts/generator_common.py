@@ -335,6 +335,132 @@ def init_proc(name, f):
   f.write(base_name(name) + ');\n')
 
 
+def proc_hash(name):
+  """Returns the 32-bit FNV-1a hash of a function name.
+
+  This must match ProcHash in proc_hash_functions().
+
+  Args:
+    name: Vulkan function name.
+  """
+  h = 0x811c9dc5
+  for c in name.encode():
+    h = ((h ^ c) * 0x01000193) & 0xffffffff
+  return h
+
+
+def proc_hash_mix(h, seed):
+  """Returns a name hash rehashed with a seed.
+
+  This must match ProcHashMix in proc_hash_functions().
+
+  Args:
+    h: Hash returned by proc_hash.
+    seed: Seed to mix into the hash.
+  """
+  h = (h ^ (seed * 0x9e3779b9)) & 0xffffffff
+  h ^= h >> 16
+  h = (h * 0x85ebca6b) & 0xffffffff
+  h ^= h >> 13
+  h = (h * 0xc2b2ae35) & 0xffffffff
+  h ^= h >> 16
+  return h
+
+
+def perfect_hash(names):
+  """Builds a minimal perfect hash for a list of function names.
+
+  Names are split into buckets by their unseeded hash, and each bucket gets
+  the first seed that places all of its names into free slots. A lookup then
+  costs two hashes and a single string compare, see ProcHashSlot.
+
+  Args:
+    names: List of unique Vulkan function names.
+
+  Returns:
+    A (seeds, slots) tuple. seeds holds the seed of each bucket, and slots
+    holds the names in the order they must be emitted.
+  """
+  assert names, 'perfect_hash needs at least one name'
+  num_slots = len(names)
+  num_buckets = (num_slots + 3) // 4
+  buckets = [[] for _ in range(num_buckets)]
+  for name in names:
+    h = proc_hash(name)
+    buckets[proc_hash_mix(h, 0) % num_buckets].append(h)
+
+  seeds = [0] * num_buckets
+  slots = [None] * num_slots
+  hash_to_name = {proc_hash(name): name for name in names}
+  assert len(hash_to_name) == num_slots, 'function name hashes collide'
+
+  # Place the largest buckets first, while most slots are still free.
+  order = sorted(range(num_buckets), key=lambda i: len(buckets[i]),
+                 reverse=True)
+  for index in order:
+    bucket = buckets[index]
+    if not bucket:
+      break
+    seed = 1
+    while True:
+      positions = [proc_hash_mix(h, seed) % num_slots for h in bucket]
+      if (len(set(positions)) == len(positions) and
+          all(slots[p] is None for p in positions)):
+        break
+      seed += 1
+    seeds[index] = seed
+    for h, p in zip(bucket, positions):
+      slots[p] = hash_to_name[h]
+
+  return seeds, slots
+
+
+def proc_hash_functions():
+  """Returns the C++ functions used to look up perfect_hash tables.
+  """
+  return """\
+// Minimal perfect hash over function names, see perfect_hash() in
+// scripts/generator_common.py.
+uint32_t ProcHash(const char* name) {
+    uint32_t hash = 0x811c9dc5u;
+    for (; *name; name++)
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 0x01000193u;
+    return hash;
+}
+
+uint32_t ProcHashMix(uint32_t hash, uint32_t seed) {
+    hash ^= seed * 0x9e3779b9u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Returns the only slot of an N entry table that can hold name. The caller
+// must still compare the name stored in that slot.
+template <size_t N, size_t B>
+size_t ProcHashSlot(const char* name, const uint32_t (&seeds)[B]) {
+    uint32_t hash = ProcHash(name);
+    return ProcHashMix(hash, seeds[ProcHashMix(hash, 0) % B]) % N;
+}
+"""
+
+
+def write_proc_hash_seeds(seeds, num_indents, f):
+  """Emits the seeds of a perfect_hash table, ten to a line.
+
+  Args:
+    seeds: Seeds returned by perfect_hash.
+    num_indents: Number of indents for each line.
+    f: Output file handle.
+  """
+  for i in range(0, len(seeds), 10):
+    f.write(indent(num_indents) +
+            ' '.join(str(seed) + ',' for seed in seeds[i:i + 10]) + '\n')
+
+
 def parse_vulkan_registry():
   """Parses Vulkan registry into the below global variables.
 
@@ -79,6 +79,30 @@ PFN_vkVoidFunction GetInstanceProcAddr(const char* name);
   gencom.run_clang_format(genfile)
 
 
+def _write_procs(table, cmd_list, f):
+  """Emits a NameProc table and the seeds of its perfect hash.
+
+  Args:
+    table: Name of the NameProc table.
+    cmd_list: Vulkan function names in the table.
+    f: Output file handle.
+  """
+  seeds, cmd_list = gencom.perfect_hash(cmd_list)
+
+  f.write('\nconst NameProc ' + table + '[] = {\n')
+  f.write(gencom.indent(1) + '// clang-format off\n')
+  for cmd in cmd_list:
+    f.write(gencom.indent(1) + '{\"' + cmd +
+            '\", reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_' +
+            cmd + '>(' + gencom.base_name(cmd) + '))},\n')
+  f.write(gencom.indent(1) + '// clang-format on\n};\n')
+
+  f.write('\nconst uint32_t ' + table + 'Seeds[] = {\n')
+  f.write(gencom.indent(1) + '// clang-format off\n')
+  gencom.write_proc_hash_seeds(seeds, 1, f)
+  f.write(gencom.indent(1) + '// clang-format on\n};\n')
+
+
 def gen_cpp():
   """Generates the null_driver_gen.cpp file.
   """
@@ -89,7 +113,7 @@ def gen_cpp():
     f.write(gencom.copyright_and_warning(2015))
 
     f.write("""\
-#include <algorithm>
+#include <string.h>
 
 #include "null_driver_gen.h"
 
@@ -102,60 +126,41 @@ struct NameProc {
     PFN_vkVoidFunction proc;
 };
 
+""")
+
+    f.write(gencom.proc_hash_functions())
+
+    f.write("""
+template <size_t N, size_t B>
 PFN_vkVoidFunction Lookup(const char* name,
-                          const NameProc* begin,
-                          const NameProc* end) {
-    const auto& entry = std::lower_bound(
-        begin, end, name,
-        [](const NameProc& e, const char* n) { return strcmp(e.name, n) < 0; });
-    if (entry == end || strcmp(entry->name, name) != 0)
+                          const NameProc (&procs)[N],
+                          const uint32_t (&seeds)[B]) {
+    const NameProc& entry = procs[ProcHashSlot<N>(name, seeds)];
+    if (strcmp(entry.name, name) != 0)
         return nullptr;
-    return entry->proc;
-}
-
-template <size_t N>
-PFN_vkVoidFunction Lookup(const char* name, const NameProc (&procs)[N]) {
-    return Lookup(name, procs, procs + N);
+    return entry.proc;
 }
+""")
 
-const NameProc kGlobalProcs[] = {
-    // clang-format off\n""")
-
-    sorted_command_list = sorted(gencom.command_list)
-    for cmd in sorted_command_list:
-      if (_is_driver_function(cmd) and
-          gencom.get_dispatch_table_type(cmd) == 'Global'):
-        f.write(gencom.indent(1) + '{\"' + cmd +
-                '\", reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_' +
-                cmd + '>(' + gencom.base_name(cmd) + '))},\n')
-
-    f.write("""\
-    // clang-format on
-};
-
-const NameProc kInstanceProcs[] = {
-    // clang-format off\n""")
-
-    for cmd in sorted_command_list:
-      if _is_driver_function(cmd):
-        f.write(gencom.indent(1) + '{\"' + cmd +
-                '\", reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_' +
-                cmd + '>(' + gencom.base_name(cmd) + '))},\n')
-
-    f.write("""\
-    // clang-format on
-};
+    global_list = [cmd for cmd in gencom.command_list
+                   if _is_driver_function(cmd) and
+                   gencom.get_dispatch_table_type(cmd) == 'Global']
+    instance_list = [cmd for cmd in gencom.command_list
+                     if _is_driver_function(cmd)]
+    _write_procs('kGlobalProcs', global_list, f)
+    _write_procs('kInstanceProcs', instance_list, f)
 
+    f.write("""
 }  // namespace
 
 namespace null_driver {
 
 PFN_vkVoidFunction GetGlobalProcAddr(const char* name) {
-    return Lookup(name, kGlobalProcs);
+    return Lookup(name, kGlobalProcs, kGlobalProcsSeeds);
 }
 
 PFN_vkVoidFunction GetInstanceProcAddr(const char* name) {
-    return Lookup(name, kInstanceProcs);
+    return Lookup(name, kInstanceProcs, kInstanceProcsSeeds);
 }
 
 }  // namespace null_driver\n""")